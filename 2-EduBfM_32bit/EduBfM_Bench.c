@@ -0,0 +1,826 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_Bench.c
+ *
+ * Description :
+ *  Micro benchmarks of EduBfM.
+ *  Each benchmark prints one line per configuration in the form
+ *  "name key=value key=value ...", so that the result can be parsed easily.
+ *
+ *  Usage: EduBfM_Bench commit [nThreads [nCommits [recordSize [delay]]]]
+ *         EduBfM_Bench checksum [nAccesses]
+ *         EduBfM_Bench mmap [nAccesses]
+ *         EduBfM_Bench compress [nAccesses]
+ *    commit   : commit throughput of the log manager with group commit.
+ *               Each of 'nThreads' threads commits 'nCommits' transactions,
+ *               each of which writes a commit log record of 'recordSize'
+ *               bytes. 'delay' is the group commit delay in usec.
+ *               Without the arguments, a range of thread counts is run.
+ *    checksum : cost of the page checksums. The time to checksum a page is
+ *               measured first; then 'nAccesses' random page accesses
+ *               (20% updates) are run with the checksums off and on, for
+ *               working sets from half to eight times the buffer pool,
+ *               so that the cost per page read/written can be seen.
+ *               The pool size itself is fixed by the storage system.
+ *    mmap     : 'nAccesses' random page reads served by the buffer pool
+ *               and by the mapping of the volume (EduBfM_MapVolume()),
+ *               for working sets from half to BENCH_MMAP_MAX_FACTOR times
+ *               the buffer pool.
+ *    compress : cost and ratio of the compression of a page holding
+ *               similar rows; then 'nAccesses' random page reads with the
+ *               page compression off and on, for working sets from half
+ *               to eight times the buffer pool. The compressed trains are
+ *               given as much memory as the buffer pool, and the reads
+ *               avoided by decompressing a page are counted.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "EduBfM_common.h"
+#include "EduBfM.h"
+#include "EduBfM_Internal.h"
+#include "EduBfM_TestModule.h"
+
+
+
+/*@
+ * Constant Definitions
+ */
+#define BENCH_DEFAULT_COMMITS       500     /* commits per thread */
+#define BENCH_DEFAULT_RECORDSIZE    100     /* size of a commit log record */
+#define BENCH_MAX_THREADS           64
+#define BENCH_DEFAULT_ACCESSES      200000  /* page accesses per configuration */
+#define BENCH_UPDATE_PERCENT        20      /* % of the page accesses which update the page */
+#define BENCH_MAX_WORKINGSET_FACTOR 8       /* largest working set / # of buffers */
+#define BENCH_MAX_WORKINGSETS       5       /* # of working sets of the checksum benchmark */
+#define BENCH_MMAP_MAX_FACTOR       32      /* largest working set / # of buffers for mmap */
+#define BENCH_VOLUME_NAME           "bench.vol"
+#define BENCH_VOLUME_ID             1000
+#define BENCH_VOLUME_PAGES          2000
+#define BENCH_ROW_LENGTH            100     /* length of a row of the compressed pages */
+
+
+/*@
+ * Type Definitions
+ */
+/* argument of a committing thread */
+typedef struct {
+    Four        threadNo;       /* thread number */
+    Four        nCommits;       /* # of transactions to commit */
+    Four        recordSize;     /* size of the commit log record */
+    Four        e;              /* error of the thread */
+} CommitThreadArg;
+
+
+/* the volume used by the benchmarks of the buffer pool */
+typedef struct {
+    Four        handle;         /* system handle */
+    Four        volId;          /* volume identifier */
+    XactID      xactId;         /* transaction of the benchmark */
+    Four        nPages;         /* # of pages allocated */
+    PageID      *pages;         /* allocated pages */
+} BenchVolume;
+
+
+/*@ Function Prototypes */
+Four RDsM_CreateSegment(Four, Four *);
+
+/*@ Internal Function Prototypes */
+static double bench_Now(void);
+static UFour bench_Random(UFour *);
+static void *bench_CommitThread(void *);
+static Four bench_Commit(Four, Four, Four, Four);
+static Four bench_OpenVolume(BenchVolume *);
+static Four bench_AllocPages(BenchVolume *, Four);
+static void bench_CloseVolume(BenchVolume *);
+static Four bench_AccessPages(BenchVolume *, Four, Four, Four, Four *, double *);
+static Four bench_Checksum(Four);
+static Four bench_Mmap(Four);
+static void bench_FillRows(Page *, Four);
+static Four bench_Compress(Four);
+
+
+
+/*@================================
+ * bench_Now()
+ *================================*/
+/*
+ * Function: static double bench_Now(void)
+ *
+ * Description:
+ *  Return the current time in seconds.
+ */
+static double bench_Now(void)
+{
+    struct timeval      tv;
+
+
+    gettimeofday(&tv, NULL);
+
+    return(tv.tv_sec + tv.tv_usec / 1000000.0);
+
+}  /* bench_Now() */
+
+
+
+/*@================================
+ * bench_Random()
+ *================================*/
+/*
+ * Function: static UFour bench_Random(UFour *)
+ *
+ * Description:
+ *  Return the next number of a linear congruential generator.
+ */
+static UFour bench_Random(
+    UFour               *seed)                  /* INOUT state of the generator */
+{
+    *seed = *seed * 1103515245 + 12345;
+
+    return((*seed >> 8) & 0xFFFFFF);
+
+}  /* bench_Random() */
+
+
+
+/*@================================
+ * bench_CommitThread()
+ *================================*/
+/*
+ * Function: static void *bench_CommitThread(void *)
+ *
+ * Description:
+ *  Commit transactions one after another.
+ */
+static void *bench_CommitThread(
+    void                *argument)              /* IN CommitThreadArg */
+{
+    CommitThreadArg     *arg = (CommitThreadArg*)argument;
+    char                *record;                /* body of the commit log record */
+    Four                i;
+
+
+    record = (char*)malloc(arg->recordSize + sizeof(Four));
+    if (record == NULL) {
+        arg->e = eMEMORYALLOCERR_EDUBFM;
+        return(NULL);
+    }
+    memset(record, 0, arg->recordSize + sizeof(Four));
+
+    arg->e = eNOERROR;
+    for (i = 0; i < arg->nCommits; i++) {
+        /* the transaction number heads the record */
+        *(Four*)record = arg->threadNo * arg->nCommits + i;
+
+        arg->e = EduBfM_LogCommit(record, arg->recordSize, NULL);
+        if (arg->e < eNOERROR) break;
+    }
+
+    free(record);
+
+    return(NULL);
+
+}  /* bench_CommitThread() */
+
+
+
+/*@================================
+ * bench_Commit()
+ *================================*/
+/*
+ * Function: static Four bench_Commit(Four, Four, Four, Four)
+ *
+ * Description:
+ *  Run the commit benchmark for a configuration and print the result.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Commit(
+    Four                nThreads,               /* IN # of committing threads */
+    Four                nCommits,               /* IN # of commits per thread */
+    Four                recordSize,             /* IN size of a commit log record */
+    Four                delay)                  /* IN group commit delay in usec */
+{
+    Four                e;                      /* for errors */
+    Four                i;
+    pthread_t           thread[BENCH_MAX_THREADS];
+    CommitThreadArg     arg[BENCH_MAX_THREADS];
+    Four                forces;                 /* # of log forces before the run */
+    double              start, elapsed;
+    Four                total = nThreads * nCommits;
+
+
+    e = EduBfM_SetGroupCommitDelay(delay);
+    if (e < eNOERROR) ERR(e);
+
+    forces = edubfm_GetNumLogForces();
+    start = bench_Now();
+
+    for (i = 0; i < nThreads; i++) {
+        arg[i].threadNo = i;
+        arg[i].nCommits = nCommits;
+        arg[i].recordSize = recordSize;
+        pthread_create(&thread[i], NULL, bench_CommitThread, &arg[i]);
+    }
+    for (i = 0; i < nThreads; i++)
+        pthread_join(thread[i], NULL);
+
+    elapsed = bench_Now() - start;
+    forces = edubfm_GetNumLogForces() - forces;
+
+    for (i = 0; i < nThreads; i++)
+        if (arg[i].e < eNOERROR) ERR(arg[i].e);
+
+    printf("commit threads=%ld commits=%ld record_bytes=%ld delay_us=%ld seconds=%.3f commits_per_sec=%.0f log_forces=%ld commits_per_force=%.2f\n",
+           (long)nThreads, (long)total, (long)recordSize, (long)delay, elapsed,
+           total / elapsed, (long)forces, (forces > 0) ? (double)total / forces : 0.0);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Commit() */
+
+
+
+/*@================================
+ * bench_OpenVolume()
+ *================================*/
+/*
+ * Function: static Four bench_OpenVolume(BenchVolume *)
+ *
+ * Description:
+ *  Initialize the storage system, format and mount the benchmark volume
+ *  and begin a transaction.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_OpenVolume(
+    BenchVolume         *vol)                   /* OUT the volume */
+{
+    Four                e;                      /* for errors */
+    char                *devNames[1];           /* device name */
+    Four                numPagesInDevices[1];   /* # of pages in the device */
+
+
+    e = LRDS_Init();
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_AllocHandle(&vol->handle);
+    if (e < eNOERROR) ERR(e);
+
+    devNames[0] = BENCH_VOLUME_NAME;
+    numPagesInDevices[0] = BENCH_VOLUME_PAGES;
+    vol->volId = BENCH_VOLUME_ID;
+
+    e = LRDS_FormatDataVolume(1, devNames, "bench", vol->volId, 16, numPagesInDevices, 16);
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_Mount(1, devNames, &vol->volId);
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_BeginTransaction(&vol->xactId, X_RR_RR);
+    if (e < eNOERROR) ERR(e);
+
+    vol->nPages = 0;
+    vol->pages = NULL;
+
+    return(eNOERROR);
+
+}  /* bench_OpenVolume() */
+
+
+
+/*@================================
+ * bench_AllocPages()
+ *================================*/
+/*
+ * Function: static Four bench_AllocPages(BenchVolume *, Four)
+ *
+ * Description:
+ *  Allocate 'nPages' pages in a new segment of the benchmark volume.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_AllocPages(
+    BenchVolume         *vol,                   /* INOUT the volume */
+    Four                nPages)                 /* IN # of pages to allocate */
+{
+    Four                e;                      /* for errors */
+    Four                i;
+    Four                firstExtNo;             /* first extent number */
+    PageID              nearPid;                /* near page ID */
+
+
+    vol->pages = (PageID*)malloc(sizeof(PageID) * nPages);
+    if (vol->pages == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+
+    e = RDsM_CreateSegment(vol->volId, &firstExtNo);
+    if (e < eNOERROR) ERR(e);
+    e = RDsM_ExtNoToPageId(vol->volId, firstExtNo, &nearPid);
+    if (e < eNOERROR) ERR(e);
+
+    for (i = 0; i < nPages; i++) {
+        e = RDsM_AllocTrains(vol->volId, firstExtNo, &nearPid, 100, 1, PAGESIZE2, &vol->pages[i]);
+        if (e < eNOERROR) ERR(e);
+    }
+    vol->nPages = nPages;
+
+    return(eNOERROR);
+
+}  /* bench_AllocPages() */
+
+
+
+/*@================================
+ * bench_CloseVolume()
+ *================================*/
+/*
+ * Function: static void bench_CloseVolume(BenchVolume *)
+ *
+ * Description:
+ *  Commit the transaction, dismount the volume and finalize the system.
+ */
+static void bench_CloseVolume(
+    BenchVolume         *vol)                   /* IN the volume */
+{
+    EduBfM_FlushAll();
+    EduBfM_DiscardAll();
+
+    LRDS_CommitTransaction(&vol->xactId);
+    LRDS_Dismount(vol->volId);
+    LRDS_FreeHandle(vol->handle);
+    LRDS_Final();
+
+    if (vol->pages != NULL) free(vol->pages);
+    unlink(BENCH_VOLUME_NAME);
+
+}  /* bench_CloseVolume() */
+
+
+
+/*@================================
+ * bench_AccessPages()
+ *================================*/
+/*
+ * Function: static Four bench_AccessPages(BenchVolume *, Four, Four, Four, Four *, double *)
+ *
+ * Description:
+ *  Access pages chosen at random among the first 'workingSet' pages of
+ *  the volume, updating 'updatePercent'% of them, and flush the buffer
+ *  pool at the end.
+ *
+ * Returns:
+ *  error code
+ *
+ * Side effects:
+ *  1) parameter nMisses
+ *     # of accesses which read the page from the disk
+ *  2) parameter elapsed
+ *     elapsed time in seconds
+ */
+static Four bench_AccessPages(
+    BenchVolume         *vol,                   /* IN the volume */
+    Four                workingSet,             /* IN # of pages accessed */
+    Four                nAccesses,              /* IN # of page accesses */
+    Four                updatePercent,          /* IN % of the accesses which update the page */
+    Four                *nMisses,               /* OUT # of buffer misses */
+    double              *elapsed)               /* OUT elapsed time */
+{
+    Four                e;                      /* for errors */
+    Four                i;
+    PageID              *pid;                   /* page accessed */
+    Page                *apage;                 /* buffer holding the page */
+    UFour               seed = 1;               /* the same sequence for each run */
+    UFour               r;
+    double              start;
+    volatile char       sink = 0;
+
+
+    *nMisses = 0;
+    start = bench_Now();
+
+    for (i = 0; i < nAccesses; i++) {
+        r = bench_Random(&seed);
+        pid = &vol->pages[r % workingSet];
+
+        if (edubfm_LookUp((BfMHashKey*)pid, PAGE_BUF) == NOTFOUND_IN_HTABLE) (*nMisses)++;
+
+        if ((r >> 12) % 100 < updatePercent) {
+            e = EduBfM_GetTrainForUpdate(pid, (char**)&apage, PAGE_BUF);
+            if (e < eNOERROR) ERR(e);
+
+            apage->data[r % sizeof(apage->data)]++;
+            e = EduBfM_SetDirty(pid, PAGE_BUF);
+            if (e < eNOERROR) ERR(e);
+        }
+        else {
+            e = EduBfM_GetTrain(pid, (char**)&apage, PAGE_BUF);
+            if (e < eNOERROR) ERR(e);
+
+            sink += apage->data[r % sizeof(apage->data)];
+        }
+
+        e = EduBfM_FreeTrain(pid, PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+    }
+
+    e = EduBfM_FlushAll();
+    if (e < eNOERROR) ERR(e);
+
+    *elapsed = bench_Now() - start;
+
+    return(eNOERROR);
+
+}  /* bench_AccessPages() */
+
+
+
+/*@================================
+ * bench_Checksum()
+ *================================*/
+/*
+ * Function: static Four bench_Checksum(Four)
+ *
+ * Description:
+ *  Run the checksum benchmark and print the result.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Checksum(
+    Four                nAccesses)              /* IN # of page accesses per configuration */
+{
+    Four                e;                      /* for errors */
+    Four                i, n, k;
+    BenchVolume         vol;                    /* the benchmark volume */
+    Page                page;                   /* page checksummed */
+    Four                nBufs;                  /* # of buffers of PAGE_BUF */
+    Four                workingSet;             /* # of pages accessed */
+    Four                missesOff, missesOn;    /* # of buffer misses */
+    double              start, elapsed, timeOff, timeOn;
+    double              timesOff[BENCH_MAX_WORKINGSETS];   /* times with the checksums off */
+    volatile UFour      sink = 0;
+
+
+    /* cost of a checksum */
+    memset(&page, 0x5A, sizeof(Page));
+    n = 1000000;
+    start = bench_Now();
+    for (i = 0; i < n; i++) {
+        page.data[i % sizeof(page.data)]++;
+        sink += edubfm_ComputeChecksum((char*)&page, PAGESIZE);
+    }
+    elapsed = bench_Now() - start;
+
+    printf("checksum_compute impl=%s page_bytes=%ld pages=%ld ns_per_page=%.1f\n",
+           edubfm_IsChecksumHardware() ? "sse4.2" : "software", (long)PAGESIZE, (long)n,
+           elapsed * 1e9 / n);
+    fflush(stdout);
+
+    /* cost in the buffer pool */
+    e = bench_OpenVolume(&vol);
+    if (e < eNOERROR) ERR(e);
+
+    nBufs = BI_NBUFS(PAGE_BUF);
+    e = bench_AllocPages(&vol, BENCH_MAX_WORKINGSET_FACTOR * nBufs);
+    if (e < eNOERROR) ERR(e);
+
+    /* the checksums off first: a page modified then keeps its old checksum */
+    e = EduBfM_SetPageChecksum(FALSE);
+    if (e < eNOERROR) ERR(e);
+    for (k = 0, workingSet = nBufs / 2; workingSet <= BENCH_MAX_WORKINGSET_FACTOR * nBufs; workingSet *= 2) {
+        if (workingSet < 1) continue;
+        e = bench_AccessPages(&vol, workingSet, nAccesses, BENCH_UPDATE_PERCENT, &missesOff, &timesOff[k++]);
+        if (e < eNOERROR) ERR(e);
+    }
+
+    /* stamp the checksums of all the pages used */
+    e = EduBfM_SetPageChecksum(TRUE);
+    if (e < eNOERROR) ERR(e);
+    e = bench_AccessPages(&vol, BENCH_MAX_WORKINGSET_FACTOR * nBufs, BENCH_MAX_WORKINGSET_FACTOR * nBufs * 10, 100, &missesOn, &elapsed);
+    if (e < eNOERROR) ERR(e);
+
+    for (k = 0, workingSet = nBufs / 2; workingSet <= BENCH_MAX_WORKINGSET_FACTOR * nBufs; workingSet *= 2) {
+        if (workingSet < 1) continue;
+
+        e = bench_AccessPages(&vol, workingSet, nAccesses, BENCH_UPDATE_PERCENT, &missesOn, &timeOn);
+        if (e < eNOERROR) ERR(e);
+        timeOff = timesOff[k++];
+
+        printf("checksum_pool pool_buffers=%ld working_set=%ld accesses=%ld misses=%ld ns_per_access_off=%.1f ns_per_access_on=%.1f overhead_pct=%.1f overhead_ns_per_miss=%.1f\n",
+               (long)BI_NBUFS(PAGE_BUF), (long)workingSet, (long)nAccesses, (long)missesOn,
+               timeOff * 1e9 / nAccesses, timeOn * 1e9 / nAccesses,
+               (timeOff > 0) ? (timeOn - timeOff) * 100 / timeOff : 0.0,
+               (missesOn > 0) ? (timeOn - timeOff) * 1e9 / missesOn : 0.0);
+        fflush(stdout);
+    }
+
+    bench_CloseVolume(&vol);
+
+    return(eNOERROR);
+
+}  /* bench_Checksum() */
+
+
+
+/*@================================
+ * bench_Mmap()
+ *================================*/
+/*
+ * Function: static Four bench_Mmap(Four)
+ *
+ * Description:
+ *  Run the mmap benchmark and print the result.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Mmap(
+    Four                nAccesses)              /* IN # of page reads per configuration */
+{
+    Four                e;                      /* for errors */
+    Four                i;
+    BenchVolume         vol;                    /* the benchmark volume */
+    Page                *apage;                 /* buffer holding a page */
+    Four                nBufs;                  /* # of buffers of PAGE_BUF */
+    Four                workingSet;             /* # of pages accessed */
+    Four                missesPool, missesMmap; /* # of buffer misses */
+    double              timePool, timeMmap;
+
+
+    e = bench_OpenVolume(&vol);
+    if (e < eNOERROR) ERR(e);
+
+    nBufs = BI_NBUFS(PAGE_BUF);
+    e = bench_AllocPages(&vol, BENCH_MMAP_MAX_FACTOR * nBufs);
+    if (e < eNOERROR) ERR(e);
+
+    /* write the pages, which are served from the mapping only if they hold their page id */
+    for (i = 0; i < vol.nPages; i++) {
+        e = EduBfM_GetTrainForUpdate(&vol.pages[i], (char**)&apage, PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+        apage->header.pid = vol.pages[i];
+        e = EduBfM_SetDirty(&vol.pages[i], PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+        e = EduBfM_FreeTrain(&vol.pages[i], PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+    }
+    e = EduBfM_FlushAll();
+    if (e < eNOERROR) ERR(e);
+
+    for (workingSet = nBufs / 2; workingSet <= BENCH_MMAP_MAX_FACTOR * nBufs; workingSet *= 2) {
+        if (workingSet < 1) continue;
+
+        e = EduBfM_DiscardAll();
+        if (e < eNOERROR) ERR(e);
+        e = bench_AccessPages(&vol, workingSet, nAccesses, 0, &missesPool, &timePool);
+        if (e < eNOERROR) ERR(e);
+
+        e = EduBfM_DiscardAll();
+        if (e < eNOERROR) ERR(e);
+        e = EduBfM_MapVolume(vol.volId, BENCH_VOLUME_NAME);
+        if (e < eNOERROR) ERR(e);
+        e = bench_AccessPages(&vol, workingSet, nAccesses, 0, &missesMmap, &timeMmap);
+        if (e < eNOERROR) ERR(e);
+        e = EduBfM_UnmapVolume(vol.volId);
+        if (e < eNOERROR) ERR(e);
+
+        printf("mmap pool_buffers=%ld working_set=%ld accesses=%ld pool_misses=%ld ns_per_access_pool=%.1f ns_per_access_mmap=%.1f speedup=%.2f\n",
+               (long)nBufs, (long)workingSet, (long)nAccesses, (long)missesPool,
+               timePool * 1e9 / nAccesses, timeMmap * 1e9 / nAccesses,
+               (timeMmap > 0) ? timePool / timeMmap : 0.0);
+        fflush(stdout);
+    }
+
+    bench_CloseVolume(&vol);
+
+    return(eNOERROR);
+
+}  /* bench_Mmap() */
+
+
+
+/*@================================
+ * bench_FillRows()
+ *================================*/
+/*
+ * Function: static void bench_FillRows(Page *, Four)
+ *
+ * Description:
+ *  Fill the data area of the page with rows of the same form, as a data
+ *  page of a file of similar objects would hold.
+ */
+static void bench_FillRows(
+    Page                *apage,                 /* OUT the page */
+    Four                seq)                    /* IN sequence number of the first row */
+{
+    Four                off;
+    char                row[BENCH_ROW_LENGTH+1];
+
+
+    memset(apage->data, 0, sizeof(apage->data));
+    for (off = 0; off + BENCH_ROW_LENGTH <= sizeof(apage->data); off += BENCH_ROW_LENGTH, seq++) {
+        memset(row, ' ', sizeof(row));
+        snprintf(row, sizeof(row), "%08ld|customer_%06ld|Seoul|status=ACTIVE|balance=%07ld|branch=%02ld|note=regular customer",
+                (long)seq, (long)(seq % 1000000), (long)(seq * 37 % 10000000), (long)(seq % 7));
+        memcpy(apage->data + off, row, BENCH_ROW_LENGTH);
+    }
+
+}  /* bench_FillRows() */
+
+
+
+/*@================================
+ * bench_Compress()
+ *================================*/
+/*
+ * Function: static Four bench_Compress(Four)
+ *
+ * Description:
+ *  Run the compression benchmark and print the result.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Compress(
+    Four                nAccesses)              /* IN # of page reads per configuration */
+{
+    Four                e;                      /* for errors */
+    Four                i, n;
+    BenchVolume         vol;                    /* the benchmark volume */
+    Page                page, copy;             /* page compressed */
+    char                buf[PAGESIZE];          /* compressed page */
+    Page                *apage;                 /* buffer holding a page */
+    Four                len;                    /* length of the compressed page */
+    Four                nBufs;                  /* # of buffers of PAGE_BUF */
+    Four                workingSet;             /* # of pages accessed */
+    Four                missesOff, missesOn;    /* # of buffer misses */
+    BfMCompressionStats stats;
+    double              start, timeComp, timeDecomp, timeOff, timeOn;
+
+
+    /* cost and ratio of the compression */
+    memset(&page, 0, sizeof(Page));
+    bench_FillRows(&page, 0);
+    n = 100000;
+    start = bench_Now();
+    for (i = 0, len = 0; i < n; i++) {
+        page.data[i % sizeof(page.data)] ^= 1;
+        len = edubfm_CompressTrain((char*)&page, PAGESIZE, buf, sizeof(buf));
+    }
+    timeComp = bench_Now() - start;
+
+    start = bench_Now();
+    for (i = 0; i < n; i++)
+        if (!edubfm_DecompressTrain(buf, len, (char*)&copy, PAGESIZE)) ERR(eBADPARAMETER_EDUBFM);
+    timeDecomp = bench_Now() - start;
+
+    printf("compress_compute page_bytes=%ld compressed_bytes=%ld ratio=%.2f compress_ns_per_page=%.1f decompress_ns_per_page=%.1f\n",
+           (long)PAGESIZE, (long)len, (double)PAGESIZE / len, timeComp * 1e9 / n, timeDecomp * 1e9 / n);
+    fflush(stdout);
+
+    /* reads avoided in the buffer pool */
+    e = bench_OpenVolume(&vol);
+    if (e < eNOERROR) ERR(e);
+
+    nBufs = BI_NBUFS(PAGE_BUF);
+    e = bench_AllocPages(&vol, BENCH_MAX_WORKINGSET_FACTOR * nBufs);
+    if (e < eNOERROR) ERR(e);
+
+    for (i = 0; i < vol.nPages; i++) {
+        e = EduBfM_GetTrainForUpdate(&vol.pages[i], (char**)&apage, PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+        bench_FillRows(apage, i * (sizeof(apage->data) / BENCH_ROW_LENGTH));
+        e = EduBfM_SetDirty(&vol.pages[i], PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+        e = EduBfM_FreeTrain(&vol.pages[i], PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+    }
+    e = EduBfM_FlushAll();
+    if (e < eNOERROR) ERR(e);
+
+    for (workingSet = nBufs / 2; workingSet <= BENCH_MAX_WORKINGSET_FACTOR * nBufs; workingSet *= 2) {
+        if (workingSet < 1) continue;
+
+        e = EduBfM_SetPageCompression(0);
+        if (e < eNOERROR) ERR(e);
+        e = EduBfM_DiscardAll();
+        if (e < eNOERROR) ERR(e);
+        e = bench_AccessPages(&vol, workingSet, nAccesses, 0, &missesOff, &timeOff);
+        if (e < eNOERROR) ERR(e);
+
+        e = EduBfM_SetPageCompression(nBufs * PAGESIZE);
+        if (e < eNOERROR) ERR(e);
+        e = EduBfM_DiscardAll();
+        if (e < eNOERROR) ERR(e);
+        e = bench_AccessPages(&vol, workingSet, nAccesses, 0, &missesOn, &timeOn);
+        if (e < eNOERROR) ERR(e);
+        e = EduBfM_GetCompressionStats(&stats);
+        if (e < eNOERROR) ERR(e);
+
+        printf("compress_pool pool_buffers=%ld working_set=%ld accesses=%ld misses=%ld disk_reads_off=%ld disk_reads_on=%ld compressed_pages=%ld compressed_bytes=%ld ns_per_access_off=%.1f ns_per_access_on=%.1f\n",
+               (long)nBufs, (long)workingSet, (long)nAccesses, (long)missesOn,
+               (long)missesOff, (long)(missesOn - stats.nHits), (long)stats.nTrains, (long)stats.nBytes,
+               timeOff * 1e9 / nAccesses, timeOn * 1e9 / nAccesses);
+        fflush(stdout);
+    }
+
+    e = EduBfM_SetPageCompression(0);
+    if (e < eNOERROR) ERR(e);
+
+    bench_CloseVolume(&vol);
+
+    return(eNOERROR);
+
+}  /* bench_Compress() */
+
+
+
+/*@================================
+ * main()
+ *================================*/
+int main(int argc, char *argv[])
+{
+    Four                e;                      /* for errors */
+    Four                nThreads, nCommits, recordSize, delay;
+    Four                i;
+    static Four         threadCounts[] = { 1, 2, 4, 8, 16, 32 };
+
+
+    if (argc >= 2 && strcmp(argv[1], "commit") == 0) {
+
+        /* start from an empty log */
+        unlink(BFM_LOG_FILE_NAME);
+
+        nCommits = (argc > 3) ? atol(argv[3]) : BENCH_DEFAULT_COMMITS;
+        recordSize = (argc > 4) ? atol(argv[4]) : BENCH_DEFAULT_RECORDSIZE;
+        delay = (argc > 5) ? atol(argv[5]) : 0;
+
+        if (argc > 2) {
+            nThreads = atol(argv[2]);
+            if (nThreads < 1 || nThreads > BENCH_MAX_THREADS || nCommits < 1 || recordSize < 0) {
+                fprintf(stderr, "bad arguments\n");
+                exit(1);
+            }
+            e = bench_Commit(nThreads, nCommits, recordSize, delay);
+        }
+        else {
+            for (i = 0, e = eNOERROR; e >= eNOERROR && i < sizeof(threadCounts)/sizeof(Four); i++)
+                e = bench_Commit(threadCounts[i], nCommits, recordSize, delay);
+        }
+
+        unlink(BFM_LOG_FILE_NAME);
+    }
+    else if (argc >= 2 && strcmp(argv[1], "checksum") == 0) {
+
+        e = bench_Checksum((argc > 2) ? atol(argv[2]) : BENCH_DEFAULT_ACCESSES);
+    }
+    else if (argc >= 2 && strcmp(argv[1], "mmap") == 0) {
+
+        e = bench_Mmap((argc > 2) ? atol(argv[2]) : BENCH_DEFAULT_ACCESSES);
+    }
+    else if (argc >= 2 && strcmp(argv[1], "compress") == 0) {
+
+        e = bench_Compress((argc > 2) ? atol(argv[2]) : BENCH_DEFAULT_ACCESSES);
+    }
+    else {
+        fprintf(stderr, "Usage: %s commit [nThreads [nCommits [recordSize [delay]]]]\n", argv[0]);
+        fprintf(stderr, "       %s checksum [nAccesses]\n", argv[0]);
+        fprintf(stderr, "       %s mmap [nAccesses]\n", argv[0]);
+        fprintf(stderr, "       %s compress [nAccesses]\n", argv[0]);
+        exit(1);
+    }
+
+    return((e < eNOERROR) ? 1 : 0);
+
+}  /* main() */
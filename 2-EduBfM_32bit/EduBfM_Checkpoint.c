@@ -0,0 +1,209 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_Checkpoint.c
+ *
+ * Description:
+ *  Take a fuzzy checkpoint of the buffer pool.
+ *
+ * Exports:
+ *  Four EduBfM_Checkpoint(void)
+ */
+
+
+#include <stdlib.h> /* for malloc, free & qsort */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@
+ * Type Definitions
+ */
+/* dirty buffer to be flushed by the checkpoint */
+typedef struct {
+    Four        type;           /* buffer type */
+    BfMHashKey  key;            /* train held by the buffer when collected */
+    Lsn_T       recLsn;         /* recovery LSN of the buffer */
+} CheckpointCandidate;
+
+
+/*@ Internal Function Prototypes */
+static int edubfm_CompareRecLsn(const void *, const void *);
+
+
+
+/*@================================
+ * EduBfM_Checkpoint()
+ *================================*/
+/*
+ * Function: Four EduBfM_Checkpoint(void)
+ *
+ * Description:
+ *  Take a fuzzy checkpoint.
+ *  a. Write the begin checkpoint log record.
+ *  b. Collect the dirty page table, i.e. the dirty buffers with their
+ *     recovery LSN, and sort it in the order of the recovery LSN.
+ *  c. Flush the dirty trains in that order, CHECKPOINT_BATCH_SIZE trains
+ *     at a time; the flush queues of both buffer types are drained at the
+ *     end of each batch, so no train waits for its own queue to fill.
+ *     The trains are flushed by copy-on-flush, so fixed buffers are
+ *     flushed without waiting for their users, and buffers replaced or
+ *     flushed in the meantime are skipped.
+ *  d. Write the end checkpoint log record holding the buffers which are
+ *     still dirty and the LSN where the redo pass should start, and force
+ *     the log.
+ *  Because the oldest recovery LSN is flushed first, the redo point moves
+ *  forward steadily even if the checkpoint is interrupted.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM
+ *    some errors caused by function calls
+ */
+Four EduBfM_Checkpoint(void)
+{
+    Four                e;                      /* for errors */
+    Four                type;                   /* buffer type */
+    Four                qType;                  /* buffer type of the flush queue drained */
+    Four                i;                      /* index */
+    Four                nCands;                 /* # of dirty buffers collected */
+    Four                nFlushed;               /* # of trains flushed */
+    Four                index;                  /* index of the buffer */
+    Lsn_T               beginLsn;               /* LSN of the begin checkpoint log record */
+    CheckpointCandidate *cands;                 /* dirty buffers sorted by recovery LSN */
+    EndCheckpointLogRec *endRec;                /* body of the end checkpoint log record */
+
+
+    CHECK_BUFTABLEEXT(PAGE_BUF);
+    CHECK_BUFTABLEEXT(LOT_LEAF_BUF);
+
+    e = edubfm_WriteLogRecord(LOG_BEGIN_CHECKPOINT, NULL, 0, &beginLsn);
+    if (e < eNOERROR) ERR(e);
+
+    cands = (CheckpointCandidate*)malloc(sizeof(CheckpointCandidate) * (BI_NBUFS(PAGE_BUF) + BI_NBUFS(LOT_LEAF_BUF)));
+    if (cands == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+
+    /*@ collect the dirty page table */
+    nCands = 0;
+    for (type = 0; type < NUM_BUF_TYPES; type++) {
+        for (i = 0; i < BI_NBUFS(type); i++) {
+            if ((BI_BITS(type, i) & DIRTY) == DIRTY && !BI_STALE(type, i)) {
+                cands[nCands].type = type;
+                cands[nCands].key = BI_KEY(type, i);
+                cands[nCands].recLsn = BI_RECLSN(type, i);
+                nCands++;
+            }
+        }
+    }
+
+    qsort(cands, nCands, sizeof(CheckpointCandidate), edubfm_CompareRecLsn);
+
+    /*@ flush the dirty trains in the order of the recovery LSN */
+    nFlushed = 0;
+    for (i = 0; i < nCands; i++) {
+        type = cands[i].type;
+
+        /* the buffer may have been flushed or replaced since it was collected */
+        index = edubfm_LookUp(&cands[i].key, type);
+        if (index == NOTFOUND_IN_HTABLE || (BI_BITS(type, index) & DIRTY) != DIRTY) continue;
+
+        e = edubfm_FlushTrain((TrainID*)&cands[i].key, type);
+        if (e < eNOERROR) { free(cands); ERR(e); }
+
+        /* the trains of both buffer types flushed so far make up the batch */
+        if (++nFlushed % CHECKPOINT_BATCH_SIZE == 0) {
+            for (qType = 0; qType < NUM_BUF_TYPES; qType++) {
+                e = edubfm_DrainFlushQueue(qType);
+                if (e < eNOERROR) { free(cands); ERR(e); }
+            }
+        }
+    }
+    free(cands);
+
+    for (type = 0; type < NUM_BUF_TYPES; type++) {
+        e = edubfm_DrainFlushQueue(type);
+        if (e < eNOERROR) ERR(e);
+    }
+
+    /*@ write the buffers dirtied again during the checkpoint */
+    endRec = (EndCheckpointLogRec*)malloc(sizeof(EndCheckpointLogRec) +
+             sizeof(DirtyPageTableEntry) * (BI_NBUFS(PAGE_BUF) + BI_NBUFS(LOT_LEAF_BUF)));
+    if (endRec == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+
+    endRec->redoLsn = beginLsn;
+    endRec->nEntries = 0;
+    for (type = 0; type < NUM_BUF_TYPES; type++) {
+        for (i = 0; i < BI_NBUFS(type); i++) {
+            if ((BI_BITS(type, i) & DIRTY) == DIRTY && !BI_STALE(type, i)) {
+                endRec->entry[endRec->nEntries].pid = *(PageID*)&BI_KEY(type, i);
+                endRec->entry[endRec->nEntries].recLsn = BI_RECLSN(type, i);
+                if (LSN_CMP_LT(BI_RECLSN(type, i), endRec->redoLsn))
+                    endRec->redoLsn = BI_RECLSN(type, i);
+                endRec->nEntries++;
+            }
+        }
+    }
+
+    e = edubfm_WriteLogRecord(LOG_END_CHECKPOINT, (char*)endRec,
+                              sizeof(EndCheckpointLogRec) + sizeof(DirtyPageTableEntry) * (endRec->nEntries - 1), NULL);
+    free(endRec);
+    if (e < eNOERROR) ERR(e);
+
+    e = edubfm_FlushLog();
+    if (e < eNOERROR) ERR(e);
+
+    return(eNOERROR);
+
+}  /* EduBfM_Checkpoint() */
+
+
+
+/*@================================
+ * edubfm_CompareRecLsn()
+ *================================*/
+/*
+ * Function: static int edubfm_CompareRecLsn(const void *, const void *)
+ *
+ * Description:
+ *  Compare the recovery LSNs of two checkpoint candidates (for qsort()).
+ *
+ * Returns:
+ *  negative, zero, or positive value as the first precedes, equals, or
+ *  follows the second
+ */
+static int edubfm_CompareRecLsn(
+    const void          *a,                     /* IN a candidate */
+    const void          *b)                     /* IN another candidate */
+{
+    const Lsn_T         *x = &((const CheckpointCandidate*)a)->recLsn;
+    const Lsn_T         *y = &((const CheckpointCandidate*)b)->recLsn;
+
+
+    if (LSN_CMP_LT(*x, *y)) return(-1);
+    if (LSN_CMP_LT(*y, *x)) return(1);
+    return(0);
+
+}  /* edubfm_CompareRecLsn() */
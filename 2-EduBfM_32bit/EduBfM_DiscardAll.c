@@ -49,6 +49,11 @@
  *  For ODYSSEUS/EduCOSMOS EduBfM, refer to the EduBfM project manual.)
  *
  *  Discard all buffers.
+ *  The buffers are not visited: the epoch of the buffer pool is advanced,
+ *  so that every buffer becomes stale and is reclaimed when the hash
+ *  lookup or the replacement meets it. Dirty buffers are not written.
+ *  The snapshots in the flush queue were taken from buffers already
+ *  flushed, so they are written rather than discarded.
  *
  * Returns:
  *  error code
@@ -61,15 +66,19 @@ Four EduBfM_DiscardAll(void)
 
 
     for (type=0; type<2; type++) {
-        for (i=0; i<BI_NBUFS(type); i++) {
-            SET_NILBFMHASHKEY(BI_KEY(type, i));
-            ((BufferTable*)bufInfo[type].bufTable)[i].fixed = 0;
-            ((BufferTable*)bufInfo[type].bufTable)[i].bits = ALL_0;
-            ((BufferTable*)bufInfo[type].bufTable)[i].nextHashEntry = NIL;
-        }
+        e = edubfm_DrainFlushQueue(type);
+        if (e < eNOERROR) ERR(e);
+
+        /* the buffers read so far must be stamped with an old epoch */
+        CHECK_BUFTABLEEXT(type);
     }
 
-    edubfm_DeleteAll();
+    /* every buffer becomes stale; see edubfm_ReclaimBuffer() */
+    bfmEpoch++;
+
+    for (i=0; i<nVolumeStats; i++)
+        for (type=0; type<2; type++)
+            volumeStats[i].nBufs[type] = 0;
 
     return(eNOERROR);
 
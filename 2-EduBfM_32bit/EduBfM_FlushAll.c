@@ -50,6 +50,7 @@
  *
  *  Flush dirty buffers holding trains.
  *  A dirty buffer is one with the dirty bit set.
+ *  The snapshots left in the flush queue are written before return.
  *
  * Returns:
  *  error code
@@ -63,9 +64,14 @@ Four EduBfM_FlushAll(void)
 
     for (type=0; type<2; type++) {
         for (i=0; i<BI_NBUFS(type); i++) {
-            if (BI_BITS(type, i) & DIRTY == DIRTY)
-                edubfm_FlushTrain((TrainID*)&BI_KEY(type, i), type);
+            if ((BI_BITS(type, i) & DIRTY) == DIRTY && !BI_STALE(type, i)) {
+                e = edubfm_FlushTrain((TrainID*)&BI_KEY(type, i), type);
+                if (e < eNOERROR) ERR(e);
+            }
         }
+
+        e = edubfm_DrainFlushQueue(type);
+        if (e < eNOERROR) ERR(e);
     }
 
     return( eNOERROR );
@@ -50,6 +50,8 @@
  *
  *  Free(or unfix) a buffer.
  *  This function simply frees a buffer by decrementing the fix count by 1.
+ *  (EduBfM) A train fixed in the mapping of a mapped volume is unfixed
+ *  there (see edubfm_UnfixMappedTrain()).
  *
  * Returns :
  *  error code
@@ -66,8 +68,10 @@ Four EduBfM_FreeTrain(
     /*@ check if the parameter is valid. */
     if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);	
 
+    if (edubfm_UnfixMappedTrain(trainId, type)) return(eNOERROR);
+
     e = eNOERROR;
-    index = bfm_LookUp((BfMHashKey*)trainId, type);
+    index = edubfm_LookUp((BfMHashKey*)trainId, type);
     if (index < 0) {
         e = index;
     } else {
@@ -30,14 +30,22 @@
  *
  * Exports:
  *  Four EduBfM_GetTrain(TrainID *, char **, Four)
+ *  Four EduBfM_GetTrainWithPrio(TrainID *, char **, Four, Four)
+ *  Four EduBfM_GetTrainForUpdate(TrainID *, char **, Four)
  */
 
 
 #include "EduBfM_common.h"
+#include "EduBfM.h"
 #include "EduBfM_Internal.h"
 
 
 
+/*@ Internal Function Prototypes */
+static Four edubfm_GetTrain(TrainID *, char **, Four, Four, Boolean);
+
+
+
 /*@================================
  * EduBfM_GetTrain()
  *================================*/
@@ -56,6 +64,9 @@
  *  pool, allocate a buffer (a buffer selected as victim may be forced out
  *  by the buffer replacement algorithm), read a disk train into the 
  *  selected buffer train, and return it.
+ *  (EduBfM) A train of a volume mapped into memory which is not in the
+ *  pool is returned from the mapping, and should not be updated; use
+ *  EduBfM_GetTrainForUpdate() to update it.
  *
  * Returns:
  *  error code
@@ -71,6 +82,118 @@ Four EduBfM_GetTrain(
     TrainID             *trainId,               /* IN train to be used */
     char                **retBuf,               /* OUT pointer to the returned buffer */
     Four                type )                  /* IN buffer type */
+{
+    return( EduBfM_GetTrainWithPrio(trainId, retBuf, type, BFM_PRIO_NORMAL) );
+
+}  /* EduBfM_GetTrain() */
+
+
+
+/*@================================
+ * EduBfM_GetTrainWithPrio()
+ *================================*/
+/*
+ * Function: EduBfM_GetTrainWithPrio(TrainID*, char**, Four, Four)
+ *
+ * Description : 
+ *  Same as EduBfM_GetTrain(), but the caller gives a hint on how valuable
+ *  the train is to keep in the buffer pool.
+ *   BFM_PRIO_LOW    : the reference bit is not set, so the buffer is the
+ *                     first candidate of the next victim search.
+ *                     (e.g. data pages read only once by a scan)
+ *   BFM_PRIO_NORMAL : the ordinary second chance algorithm.
+ *   BFM_PRIO_HIGH   : the HOT bit is set in addition to the reference bit,
+ *                     so that the buffer survives one more pass of the
+ *                     clock hand in edubfm_AllocTrain().
+ *                     (e.g. the root and internal pages of a B+ tree)
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFER_BFM - Invalid Buffer
+ *    eBADBUFFERTYPE_BFM - Invalid Buffer type
+ *    eBADBUFFERPRIO_EDUBFM - Invalid priority hint
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter retBuf
+ *     pointer to buffer holding the disk train indicated by `trainId'
+ */
+Four EduBfM_GetTrainWithPrio(
+    TrainID             *trainId,               /* IN train to be used */
+    char                **retBuf,               /* OUT pointer to the returned buffer */
+    Four                type,                   /* IN buffer type */
+    Four                prio)                   /* IN page priority hint */
+{
+    return( edubfm_GetTrain(trainId, retBuf, type, prio, TRUE) );
+
+}  /* EduBfM_GetTrainWithPrio() */
+
+
+
+/*@================================
+ * EduBfM_GetTrainForUpdate()
+ *================================*/
+/*
+ * Function: EduBfM_GetTrainForUpdate(TrainID*, char**, Four)
+ *
+ * Description :
+ *  Same as EduBfM_GetTrain(), but the train is always fixed in the buffer
+ *  pool, even if its volume is mapped into memory, so that it can be
+ *  updated and marked dirty. Readers which fixed the train in the mapping
+ *  before see the update after the train is written to the disk.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFER_BFM - Invalid Buffer
+ *    eBADBUFFERTYPE_BFM - Invalid Buffer type
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter retBuf
+ *     pointer to buffer holding the disk train indicated by `trainId'
+ */
+Four EduBfM_GetTrainForUpdate(
+    TrainID             *trainId,               /* IN train to be used */
+    char                **retBuf,               /* OUT pointer to the returned buffer */
+    Four                type )                  /* IN buffer type */
+{
+    return( edubfm_GetTrain(trainId, retBuf, type, BFM_PRIO_NORMAL, FALSE) );
+
+}  /* EduBfM_GetTrainForUpdate() */
+
+
+
+/*@================================
+ * edubfm_GetTrain()
+ *================================*/
+/*
+ * Function: static Four edubfm_GetTrain(TrainID*, char**, Four, Four, Boolean)
+ *
+ * Description :
+ *  Fix a train with the given priority hint (see EduBfM_GetTrainWithPrio()).
+ *  If 'useMapping' is TRUE and the train is neither in the buffer pool nor
+ *  in the flush queue, the train is fixed in the mapping of its volume if
+ *  the volume is mapped.
+ *  A fix served by the buffer pool is counted as a hit or a miss of the
+ *  volume of the train (see EduBfM_GetVolumeStats()).
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFER_BFM - Invalid Buffer
+ *    eBADBUFFERTYPE_BFM - Invalid Buffer type
+ *    eBADBUFFERPRIO_EDUBFM - Invalid priority hint
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter retBuf
+ *     pointer to buffer holding the disk train indicated by `trainId'
+ */
+static Four edubfm_GetTrain(
+    TrainID             *trainId,               /* IN train to be used */
+    char                **retBuf,               /* OUT pointer to the returned buffer */
+    Four                type,                   /* IN buffer type */
+    Four                prio,                   /* IN page priority hint */
+    Boolean             useMapping)             /* IN may the train be returned from a mapped volume? */
 {
     Four                e;                      /* for error */
     Four                index;                  /* index of the buffer pool */
@@ -83,20 +206,52 @@ Four EduBfM_GetTrain(
     /* Is the buffer type valid? */
     if (IS_BAD_BUFFERTYPE(type)) ERR( eBADBUFFERTYPE_BFM );	
 
+    /* Is the priority hint valid? */
+    if (IS_BAD_BUFFERPRIO(prio)) ERR( eBADBUFFERPRIO_EDUBFM );
+
+    CHECK_BUFTABLEEXT(type);
+
     index = edubfm_LookUp((BfMHashKey*)trainId, type);
 
+    if (index == NOTFOUND_IN_HTABLE && useMapping) {
+        *retBuf = edubfm_FixMappedTrain(trainId, type);
+        if (*retBuf != NULL) return( eNOERROR );
+    }
+
     if (index == NOTFOUND_IN_HTABLE) {
-        index = edubfm_AllocTrain(type);
+        index = edubfm_AllocTrain((BfMHashKey*)trainId, type);
         if (index < 0) ERR( index );
 
         e = edubfm_ReadTrain(trainId, BI_BUFFER(type, index), type);
         if (e != eNOERROR) ERR( e );
         
         BI_KEY(type, index) = *(BfMHashKey*)trainId;
+        BI_PAGELSN(type, index).offset = 0;
+        BI_PAGELSN(type, index).wrapCount = 0;
+        BI_LOGGED(type, index) = FALSE;
 
         e = edubfm_Insert(trainId, index, type);
         if (e != eNOERROR) ERR( e );
+
+        edubfm_ChargeBuffer(type, index);
+        if (BI_VOLIDX(type, index) != NIL)
+            volumeStats[BI_VOLIDX(type, index)].nMisses[type]++;
+
+        /* edubfm_AllocTrain() returns the buffer with only REFER set */
+        if (prio == BFM_PRIO_LOW)
+            BI_BITS(type, index) &= ~REFER;
     }
+    else {
+        if (prio != BFM_PRIO_LOW)
+            BI_BITS(type, index) |= REFER;
+
+        if (BI_VOLIDX(type, index) != NIL)
+            volumeStats[BI_VOLIDX(type, index)].nHits[type]++;
+    }
+
+    if (prio == BFM_PRIO_HIGH)
+        BI_BITS(type, index) |= HOT;
+
     BI_FIXED(type, index)++;
 
     *retBuf = (char**)BI_BUFFER(type, index);
@@ -104,4 +259,4 @@ Four EduBfM_GetTrain(
 
     return( eNOERROR );   /* No error */
 
-}  /* EduBfM_GetTrain() */
+}  /* edubfm_GetTrain() */
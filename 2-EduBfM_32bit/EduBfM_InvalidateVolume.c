@@ -0,0 +1,106 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_InvalidateVolume.c
+ *
+ * Description :
+ *  Discard the buffers holding the trains of a volume.
+ *
+ * Exports:
+ *  Four EduBfM_InvalidateVolume(Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_InvalidateVolume()
+ *================================*/
+/*
+ * Function: Four EduBfM_InvalidateVolume(Four)
+ *
+ * Description :
+ *  Discard the buffers holding the trains of the given volume, e.g. when
+ *  the volume is dismounted or restored from a backup. Like
+ *  EduBfM_DiscardAll(), the buffers are not visited: the epoch of the
+ *  volume is advanced, so that its buffers become stale and are reclaimed
+ *  when the hash lookup or the replacement meets them. Dirty buffers are
+ *  not written.
+ *  When the volume table is full and the volume has no entry, its buffers
+ *  are not charged to it and are searched for in the buffer pool and among
+ *  the compressed trains instead.
+ *  The snapshots in the flush queue were taken from buffers already
+ *  flushed, so they are written rather than discarded.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_EDUBFM - bad volume number
+ */
+Four EduBfM_InvalidateVolume(
+    Four                volNo)                  /* IN volume number */
+{
+    Four                e;                      /* error */
+    Two                 i;                      /* index */
+    Four                type;                   /* buffer type */
+    Two                 volIdx;
+
+
+    if (volNo < 0) ERR(eBADPARAMETER_EDUBFM);
+
+    for (type = 0; type < NUM_BUF_TYPES; type++) {
+        e = edubfm_DrainFlushQueue(type);
+        if (e < eNOERROR) ERR(e);
+
+        CHECK_BUFTABLEEXT(type);
+    }
+
+    volIdx = edubfm_LookUpVolumeStats(volNo, TRUE);
+
+    if (volIdx != NIL) {
+        /* every buffer charged to the volume becomes stale */
+        volumeStats[volIdx].epoch++;
+        for (type = 0; type < NUM_BUF_TYPES; type++)
+            volumeStats[volIdx].nBufs[type] = 0;
+    }
+    else {
+        for (type = 0; type < NUM_BUF_TYPES; type++) {
+            for (i = 0; i < BI_NBUFS(type); i++) {
+                if (BI_KEY(type, i).volNo == volNo && !IS_NILBFMHASHKEY(BI_KEY(type, i)) &&
+                    !BI_STALE(type, i)) {
+                    edubfm_Delete(&BI_KEY(type, i), type);
+                    edubfm_ReclaimBuffer(type, i);
+                }
+            }
+        }
+        edubfm_DropCompressedVolume(volNo);
+    }
+
+    return(eNOERROR);
+
+}  /* EduBfM_InvalidateVolume() */
@@ -0,0 +1,192 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_Log.c
+ *
+ * Description:
+ *  Interface of the log manager to transactions.
+ *  Updates of a train are logged before the train is marked dirty, and
+ *  the page LSN of the train is set to the LSN of the update log record.
+ *  A transaction commits by writing a commit log record and forcing the
+ *  log; concurrent commits share log forces (see edubfm_Log.c).
+ *
+ * Exports:
+ *  Four EduBfM_LogUpdate(TrainID *, Four, char *, Four, Lsn_T *)
+ *  Four EduBfM_LogCommit(char *, Four, Lsn_T *)
+ *  Four EduBfM_SetGroupCommitDelay(Four)
+ */
+
+
+#include <string.h>
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+#include "EduBfM.h"
+
+
+
+/*@================================
+ * EduBfM_LogUpdate()
+ *================================*/
+/*
+ * Function: Four EduBfM_LogUpdate(TrainID *, Four, char *, Four, Lsn_T *)
+ *
+ * Description:
+ *  Write the update log record of a train which is fixed in the buffer
+ *  pool and mark the train dirty. The redo data of the update is given by
+ *  'redo' and 'length'. The page LSN of the buffer is set to the LSN of the
+ *  log record, so that the train is not written to the disk before the
+ *  log record; for PAGE_BUF, it is also set in the page header.
+ *  The train is marked dirty before the record is written, hence its
+ *  recovery LSN never follows the log record.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - bad length of the redo data
+ *    eNOTFOUND_BFM - the train is not in the buffer pool
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter lsn
+ *     LSN of the update log record
+ */
+Four EduBfM_LogUpdate(
+    TrainID             *trainId,               /* IN updated train */
+    Four                type,                   /* IN buffer type */
+    char                *redo,                  /* IN redo data of the update */
+    Four                length,                 /* IN length of the redo data */
+    Lsn_T               *lsn)                   /* OUT LSN of the update log record */
+{
+    Four                e;                      /* for errors */
+    Four                index;                  /* an index of the buffer table & pool */
+    Lsn_T               recLsn;                 /* LSN of the update log record */
+    char                body[sizeof(UpdateLogRec) + PAGESIZE];  /* body of the log record */
+    UpdateLogRec        *upd = (UpdateLogRec*)body;
+
+
+    /*@ Are the parameters valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+    if (length < 0 || length > PAGESIZE) ERR(eBADPARAMETER_EDUBFM);
+
+    index = edubfm_LookUp((BfMHashKey*)trainId, type);
+    if (index == NOTFOUND_IN_HTABLE) ERR(eNOTFOUND_BFM);
+
+    e = EduBfM_SetDirty(trainId, type);
+    if (e < eNOERROR) ERR(e);
+
+    upd->pid = *(PageID*)trainId;
+    upd->length = length;
+    if (length > 0) memcpy(&body[sizeof(UpdateLogRec)], redo, length);
+
+    e = edubfm_WriteLogRecord(LOG_UPDATE, body, sizeof(UpdateLogRec) + length, &recLsn);
+    if (e < eNOERROR) ERR(e);
+
+    BI_PAGELSN(type, index) = recLsn;
+    BI_LOGGED(type, index) = TRUE;
+    if (type == PAGE_BUF)
+        ((PageHdr*)BI_BUFFER(type, index))->lsn = recLsn;
+
+    if (lsn != NULL) *lsn = recLsn;
+
+    return(eNOERROR);
+
+}  /* EduBfM_LogUpdate() */
+
+
+
+/*@================================
+ * EduBfM_LogCommit()
+ *================================*/
+/*
+ * Function: Four EduBfM_LogCommit(char *, Four, Lsn_T *)
+ *
+ * Description:
+ *  Write the commit log record of a transaction and return after the
+ *  record is on the disk. The body of the record, e.g. the transaction
+ *  id, is given by the caller. This function may be called by many
+ *  threads at the same time; the commits arriving while the log is being
+ *  forced are made durable together by the next force (group commit).
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_EDUBFM - bad length of the body
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter lsn
+ *     LSN of the commit log record
+ */
+Four EduBfM_LogCommit(
+    char                *body,                  /* IN body of the commit log record */
+    Four                length,                 /* IN length of the body */
+    Lsn_T               *lsn)                   /* OUT LSN of the commit log record */
+{
+    Four                e;                      /* for errors */
+    Lsn_T               commitLsn;              /* LSN of the commit log record */
+
+
+    /*@ Is the parameter valid? */
+    if (length < 0) ERR(eBADPARAMETER_EDUBFM);
+
+    e = edubfm_WriteLogRecord(LOG_COMMIT, body, length, &commitLsn);
+    if (e < eNOERROR) ERR(e);
+
+    e = edubfm_ForceLog(&commitLsn);
+    if (e < eNOERROR) ERR(e);
+
+    if (lsn != NULL) *lsn = commitLsn;
+
+    return(eNOERROR);
+
+}  /* EduBfM_LogCommit() */
+
+
+
+/*@================================
+ * EduBfM_SetGroupCommitDelay()
+ *================================*/
+/*
+ * Function: Four EduBfM_SetGroupCommitDelay(Four)
+ *
+ * Description:
+ *  Set how long(usec) the leader of a log force waits for other committing
+ *  transactions before calling fsync(). With 0, which is the default, a
+ *  force batches only the commits which arrived during the previous force.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_EDUBFM - bad delay
+ */
+Four EduBfM_SetGroupCommitDelay(
+    Four                delay)                  /* IN delay in usec */
+{
+    /*@ Is the parameter valid? */
+    if (delay < 0) ERR(eBADPARAMETER_EDUBFM);
+
+    bfmGroupCommitDelay = delay;
+
+    return(eNOERROR);
+
+}  /* EduBfM_SetGroupCommitDelay() */
@@ -0,0 +1,170 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_MapVolume.c
+ *
+ * Description:
+ *  Map the device file of a read-mostly volume into memory, or unmap it.
+ *
+ * Exports:
+ *  Four EduBfM_MapVolume(Four, char *)
+ *  Four EduBfM_UnmapVolume(Four)
+ */
+
+
+#include <stdlib.h> /* for calloc & free */
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_MapVolume()
+ *================================*/
+/*
+ * Function: Four EduBfM_MapVolume(Four, char *)
+ *
+ * Description:
+ *  Map the device file of a volume into memory read only. From then on,
+ *  the trains of the volume fixed by EduBfM_GetTrain() are returned from
+ *  the mapping unless they are in the buffer pool (see
+ *  edubfm_MappedVolume.c). Only a volume on a single device is supported.
+ *  The first page of the device should be the header page of the volume,
+ *  holding the volume number in its page header.
+ *  Page checksums are not verified for the trains returned from the
+ *  mapping.
+ *
+ * Returns:
+ *  error code
+ *    eMAPVOLUMEFAILED_EDUBFM - the volume is already mapped, too many
+ *                              volumes are mapped, or the device file
+ *                              cannot be mapped
+ *    eMEMORYALLOCERR_EDUBFM
+ */
+Four EduBfM_MapVolume(
+    Four                volNo,                  /* IN volume to be mapped */
+    char                *devName)               /* IN device file of the volume */
+{
+    Four                i;                      /* index */
+    MappedVolume        *mv = NULL;             /* free entry of the table */
+    struct stat         st;                     /* status of the device file */
+    Four                fd;                     /* file descriptor of the device file */
+    char                *base;                  /* start of the mapping */
+    Four                nPages;                 /* # of pages of the device */
+
+
+    for (i = 0; i < MAX_MAPPED_VOLUMES; i++) {
+        if (mappedVolume[i].base == NULL) {
+            if (mv == NULL) mv = &mappedVolume[i];
+        }
+        else if (mappedVolume[i].volNo == volNo)
+            ERR(eMAPVOLUMEFAILED_EDUBFM);
+    }
+    if (mv == NULL) ERR(eMAPVOLUMEFAILED_EDUBFM);
+
+    fd = open(devName, O_RDONLY);
+    if (fd < 0) ERR(eMAPVOLUMEFAILED_EDUBFM);
+
+    if (fstat(fd, &st) < 0 || st.st_size < PAGESIZE) {
+        close(fd);
+        ERR(eMAPVOLUMEFAILED_EDUBFM);
+    }
+    nPages = st.st_size / PAGESIZE;
+
+    base = (char*)mmap(NULL, (size_t)nPages * PAGESIZE, PROT_READ, MAP_SHARED, fd, 0);
+    if (base == (char*)MAP_FAILED) {
+        close(fd);
+        ERR(eMAPVOLUMEFAILED_EDUBFM);
+    }
+
+    /* the device should be the first device of the volume */
+    if (((PageHdr*)base)->pid.volNo != volNo) {
+        munmap(base, (size_t)nPages * PAGESIZE);
+        close(fd);
+        ERR(eMAPVOLUMEFAILED_EDUBFM);
+    }
+
+    mv->nFixed = (Two*)calloc(nPages, sizeof(Two));
+    if (mv->nFixed == NULL) {
+        munmap(base, (size_t)nPages * PAGESIZE);
+        close(fd);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    mv->volNo = volNo;
+    mv->fd = fd;
+    mv->nPages = nPages;
+    mv->nFixedTotal = 0;
+    mv->base = base;
+
+    return(eNOERROR);
+
+}  /* EduBfM_MapVolume() */
+
+
+
+/*@================================
+ * EduBfM_UnmapVolume()
+ *================================*/
+/*
+ * Function: Four EduBfM_UnmapVolume(Four)
+ *
+ * Description:
+ *  Unmap a volume mapped by EduBfM_MapVolume(). No train of the volume
+ *  may be fixed in the mapping.
+ *
+ * Returns:
+ *  error code
+ *    eMAPVOLUMEFAILED_EDUBFM - the volume is not mapped
+ *    eMAPPEDVOLUMEINUSE_EDUBFM - a train of the volume is fixed
+ */
+Four EduBfM_UnmapVolume(
+    Four                volNo)                  /* IN volume to be unmapped */
+{
+    Four                i;                      /* index */
+    MappedVolume        *mv;                    /* the mapped volume */
+
+
+    for (i = 0; i < MAX_MAPPED_VOLUMES; i++)
+        if (mappedVolume[i].base != NULL && mappedVolume[i].volNo == volNo) break;
+    if (i == MAX_MAPPED_VOLUMES) ERR(eMAPVOLUMEFAILED_EDUBFM);
+
+    mv = &mappedVolume[i];
+    if (mv->nFixedTotal > 0) ERR(eMAPPEDVOLUMEINUSE_EDUBFM);
+
+    munmap(mv->base, (size_t)mv->nPages * PAGESIZE);
+    close(mv->fd);
+    free(mv->nFixed);
+
+    mv->base = NULL;
+    mv->nFixed = NULL;
+
+    return(eNOERROR);
+
+}  /* EduBfM_UnmapVolume() */
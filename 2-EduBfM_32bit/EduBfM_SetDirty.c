@@ -54,16 +54,22 @@
  *  Set the dirty bit of an entry in the buffer table.
  *  Look up the entry in the using given parameters and set the dirty
  *  bit of the entry.
+ *  (EduBfM) When a clean buffer becomes dirty, the end of log is recorded
+ *  as its recovery LSN for the dirty page table (see EduBfM_Checkpoint()).
+ *  A train fixed only in the mapping of a mapped volume cannot be dirty;
+ *  it should be fixed by EduBfM_GetTrainForUpdate() instead.
  * 
  * Returns:
  *  error code
  *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eREADONLYTRAIN_EDUBFM - the train is fixed in a read only mapping
  *    some errors caused by function calls
  */
 Four EduBfM_SetDirty(
     TrainID             *trainId,               /* IN which train has been modified in the buffer?  */
     Four                type )                  /* IN buffer type */
 {
+    Four                e;                      /* for errors */
     Four                index;                  /* an index of the buffer table & pool */
 
 
@@ -71,10 +77,17 @@ Four EduBfM_SetDirty(
     if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
 
     index = edubfm_LookUp((BfMHashKey*)trainId, type);
-    if (index < 0)
+    if (index < 0) {
+        if (edubfm_IsMappedTrainFixed(trainId, type)) ERR(eREADONLYTRAIN_EDUBFM);
         return index;
-    else
-        BI_BITS(type, index) |= DIRTY;
+    }
+
+    if ((BI_BITS(type, index) & DIRTY) != DIRTY) {
+        CHECK_BUFTABLEEXT(type);
+        e = edubfm_GetEndOfLog(&BI_RECLSN(type, index));
+        if (e < eNOERROR) ERR(e);
+    }
+    BI_BITS(type, index) |= DIRTY;
 
 
     return( eNOERROR );
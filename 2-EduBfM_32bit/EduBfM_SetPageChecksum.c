@@ -0,0 +1,70 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_SetPageChecksum.c
+ *
+ * Description:
+ *  Turn the page checksums on or off.
+ *
+ * Exports:
+ *  Four EduBfM_SetPageChecksum(Boolean)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_SetPageChecksum()
+ *================================*/
+/*
+ * Function: Four EduBfM_SetPageChecksum(Boolean)
+ *
+ * Description:
+ *  Turn the page checksums on or off. While they are on, the CRC32C of a
+ *  page is stamped in the page header whenever the page is written, and
+ *  verified whenever the page is read from the disk (see
+ *  edubfm_Checksum.c). While they are off, the checksum field is left as
+ *  it is; a page which had been written with the checksum and is modified
+ *  while the checksums are off keeps its old checksum, so the checksums
+ *  are to be turned on before a volume is used and kept on.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_EDUBFM - bad flag
+ */
+Four EduBfM_SetPageChecksum(
+    Boolean             on)                     /* IN TRUE to turn the checksums on */
+{
+    /*@ Is the parameter valid? */
+    if (on != TRUE && on != FALSE) ERR(eBADPARAMETER_EDUBFM);
+
+    bfmPageChecksum = on;
+
+    return(eNOERROR);
+
+}  /* EduBfM_SetPageChecksum() */
@@ -0,0 +1,116 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_SetPageCompression.c
+ *
+ * Description:
+ *  Turn the compression of the cold trains on or off.
+ *
+ * Exports:
+ *  Four EduBfM_SetPageCompression(Four)
+ *  Four EduBfM_GetCompressionStats(BfMCompressionStats *)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_SetPageCompression()
+ *================================*/
+/*
+ * Function: Four EduBfM_SetPageCompression(Four)
+ *
+ * Description:
+ *  Keep up to 'nBytes' bytes of compressed trains in memory, or turn the
+ *  page compression off if 'nBytes' is 0. While it is on, a page evicted
+ *  from the buffer pool is compressed and kept, and is decompressed
+ *  instead of being read from the disk when it is fixed again (see
+ *  edubfm_CompressedTrain.c); the disk content itself is never
+ *  compressed. Pages holding similar objects often compress to a fraction
+ *  of their size, so the memory holds more pages than the same memory
+ *  given to the buffer pool would.
+ *  The trains kept so far are dropped.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_EDUBFM - 'nBytes' is neither 0 nor at least a page
+ *    eMEMORYALLOCERR_EDUBFM
+ */
+Four EduBfM_SetPageCompression(
+    Four                nBytes)                 /* IN memory for the compressed trains, 0 for off */
+{
+    Four                e;                      /* for errors */
+
+
+    /*@ Is the parameter valid? */
+    if (nBytes != 0 && nBytes < PAGESIZE) ERR(eBADPARAMETER_EDUBFM);
+
+    e = edubfm_InitCompressedTrains(nBytes);
+    if (e < eNOERROR) ERR(e);
+
+    return(eNOERROR);
+
+}  /* EduBfM_SetPageCompression() */
+
+
+
+/*@================================
+ * EduBfM_GetCompressionStats()
+ *================================*/
+/*
+ * Function: Four EduBfM_GetCompressionStats(BfMCompressionStats *)
+ *
+ * Description:
+ *  Return the usage of the compressed trains since the page compression
+ *  was last turned on. The trains invalidated by EduBfM_DiscardAll() or
+ *  EduBfM_InvalidateVolume() are counted until they are overwritten.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_EDUBFM - NULL 'stats'
+ *
+ * Side effects:
+ *  1) parameter stats
+ *     usage of the compressed trains
+ */
+Four EduBfM_GetCompressionStats(
+    BfMCompressionStats *stats)                 /* OUT usage of the compressed trains */
+{
+    /*@ Is the parameter valid? */
+    if (stats == NULL) ERR(eBADPARAMETER_EDUBFM);
+
+    stats->nTrains = bfmCompressedTrains.nTrains;
+    stats->nBytes = bfmCompressedTrains.nBytes;
+    stats->nStored = bfmCompressedTrains.nStored;
+    stats->nRejected = bfmCompressedTrains.nRejected;
+    stats->nHits = bfmCompressedTrains.nHits;
+
+    return(eNOERROR);
+
+}  /* EduBfM_GetCompressionStats() */
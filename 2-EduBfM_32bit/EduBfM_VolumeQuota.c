@@ -0,0 +1,156 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBfM_VolumeQuota.c
+ *
+ * Description:
+ *  Buffer quotas and buffer usage statistics per volume.
+ *
+ * Exports:
+ *  Four EduBfM_SetVolumeQuota(Four, Four, Four, Four)
+ *  Four EduBfM_GetVolumeStats(Four, Four, BfMVolumeStats *)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@================================
+ * EduBfM_SetVolumeQuota()
+ *================================*/
+/*
+ * Function: Four EduBfM_SetVolumeQuota(Four, Four, Four, Four)
+ *
+ * Description:
+ *  Set the quotas of the volume on the buffers of the given type.
+ *  At least 'minBufs' buffers are kept for the trains of the volume: the
+ *  replacement does not take a buffer from the volume for another volume
+ *  while the volume holds 'minBufs' buffers or less. At most 'maxBufs'
+ *  buffers are used by the volume: once it holds 'maxBufs' buffers, a new
+ *  train of the volume replaces one of its own trains. 0 means no minimum
+ *  or no maximum; a volume scanned by a batch job would be given a
+ *  maximum, and a latency sensitive volume a minimum.
+ *  The quotas are soft: when no buffer satisfying them is unfixed, the
+ *  replacement falls back to ignoring them rather than failing.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - bad volume number or quotas
+ *    eTOOMANYVOLUMES_EDUBFM - the volume table is full
+ */
+Four EduBfM_SetVolumeQuota(
+    Four                volNo,                  /* IN volume number */
+    Four                type,                   /* IN buffer type */
+    Four                minBufs,                /* IN minimum quota, 0 for none */
+    Four                maxBufs)                /* IN maximum quota, 0 for none */
+{
+    Two                 volIdx;
+    Four                i;
+    Four                sumMin;                 /* sum of the minimum quotas */
+
+
+    /*@ Are the parameters valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (volNo < 0 || minBufs < 0 || maxBufs < 0 || maxBufs > BI_NBUFS(type) ||
+        (maxBufs > 0 && minBufs > maxBufs))
+        ERR(eBADPARAMETER_EDUBFM);
+
+    /* a buffer must remain for the volumes without a minimum quota */
+    for (i = 0, sumMin = minBufs; i < nVolumeStats; i++)
+        if (volumeStats[i].volNo != volNo) sumMin += volumeStats[i].minBufs[type];
+    if (sumMin >= BI_NBUFS(type)) ERR(eBADPARAMETER_EDUBFM);
+
+    volIdx = edubfm_LookUpVolumeStats(volNo, TRUE);
+    if (volIdx == NIL) ERR(eTOOMANYVOLUMES_EDUBFM);
+
+    volumeStats[volIdx].minBufs[type] = minBufs;
+    volumeStats[volIdx].maxBufs[type] = maxBufs;
+
+    for (i = 0, bfmVolumeQuota[type] = FALSE; i < nVolumeStats; i++)
+        if (volumeStats[i].minBufs[type] > 0 || volumeStats[i].maxBufs[type] > 0)
+            bfmVolumeQuota[type] = TRUE;
+
+    return(eNOERROR);
+
+}  /* EduBfM_SetVolumeQuota() */
+
+
+
+/*@================================
+ * EduBfM_GetVolumeStats()
+ *================================*/
+/*
+ * Function: Four EduBfM_GetVolumeStats(Four, Four, BfMVolumeStats *)
+ *
+ * Description:
+ *  Return the buffer usage of the volume for the buffers of the given type:
+ *  the number of buffers holding its trains, its quotas, and the number of
+ *  fixes which found the train in the buffer pool (hits) or read it into
+ *  the buffer pool (misses). Fixes served from the mapping of a mapped
+ *  volume are not counted. A volume never accessed has all zero.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM - bad buffer type
+ *    eBADPARAMETER_EDUBFM - bad volume number or NULL 'stats'
+ *
+ * Side effects:
+ *  1) parameter stats
+ *     buffer usage of the volume
+ */
+Four EduBfM_GetVolumeStats(
+    Four                volNo,                  /* IN volume number */
+    Four                type,                   /* IN buffer type */
+    BfMVolumeStats      *stats)                 /* OUT buffer usage of the volume */
+{
+    Two                 volIdx;
+
+
+    /*@ Are the parameters valid? */
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (volNo < 0 || stats == NULL) ERR(eBADPARAMETER_EDUBFM);
+
+    volIdx = edubfm_LookUpVolumeStats(volNo, FALSE);
+    if (volIdx == NIL) {
+        stats->nBufs = stats->minBufs = stats->maxBufs = 0;
+        stats->nHits = stats->nMisses = 0;
+        return(eNOERROR);
+    }
+
+    stats->nBufs = volumeStats[volIdx].nBufs[type];
+    stats->minBufs = volumeStats[volIdx].minBufs[type];
+    stats->maxBufs = volumeStats[volIdx].maxBufs[type];
+    stats->nHits = volumeStats[volIdx].nHits[type];
+    stats->nMisses = volumeStats[volIdx].nMisses[type];
+
+    return(eNOERROR);
+
+}  /* EduBfM_GetVolumeStats() */
@@ -26,15 +26,60 @@
 #define _EDUBFM_H_
 
 
+/*@
+ * Constant Definitions
+ */
+/* Page priority hints given to EduBfM_GetTrainWithPrio() */
+#define BFM_PRIO_LOW    0	/* pages read once, e.g. data pages of a scan */
+#define BFM_PRIO_NORMAL 1	/* ordinary second chance replacement */
+#define BFM_PRIO_HIGH   2	/* pages re-read often, e.g. B+ tree root and internal pages */
+
+
+/*@
+ * Type Definitions
+ */
+/* Buffer usage of a volume returned by EduBfM_GetVolumeStats() */
+typedef struct {
+    Four        nBufs;          /* # of buffers holding trains of the volume */
+    Four        minBufs;        /* minimum quota (0: none) */
+    Four        maxBufs;        /* maximum quota (0: none) */
+    Four        nHits;          /* # of fixes found in the buffer pool */
+    Four        nMisses;        /* # of fixes read into the buffer pool */
+} BfMVolumeStats;
+
+/* Usage of the compressed trains returned by EduBfM_GetCompressionStats() */
+typedef struct {
+    Four        nTrains;        /* # of trains kept compressed */
+    Four        nBytes;         /* bytes of the trains kept compressed */
+    Four        nStored;        /* # of evicted trains compressed and kept */
+    Four        nRejected;      /* # of evicted trains which did not compress enough */
+    Four        nHits;          /* # of trains read back from the compressed copy */
+} BfMCompressionStats;
+
+
 /*@
  * Function Prototypes
  */
 /* Interface Function Prototypes */
 Four EduBfM_FreeTrain(TrainID *, Four);
 Four EduBfM_GetTrain(TrainID *, char **, Four);
+Four EduBfM_GetTrainWithPrio(TrainID *, char **, Four, Four);
+Four EduBfM_GetTrainForUpdate(TrainID *, char **, Four);
 Four EduBfM_SetDirty(TrainID *, Four);
 Four EduBfM_DiscardAll(void);
+Four EduBfM_InvalidateVolume(Four);
 Four EduBfM_FlushAll(void);
+Four EduBfM_Checkpoint(void);
+Four EduBfM_LogUpdate(TrainID *, Four, char *, Four, Lsn_T *);
+Four EduBfM_LogCommit(char *, Four, Lsn_T *);
+Four EduBfM_SetGroupCommitDelay(Four);
+Four EduBfM_SetPageChecksum(Boolean);
+Four EduBfM_SetPageCompression(Four);
+Four EduBfM_GetCompressionStats(BfMCompressionStats *);
+Four EduBfM_MapVolume(Four, char *);
+Four EduBfM_UnmapVolume(Four);
+Four EduBfM_SetVolumeQuota(Four, Four, Four, Four);
+Four EduBfM_GetVolumeStats(Four, Four, BfMVolumeStats *);
 
 
 #endif /* _EDUBFM_H_ */
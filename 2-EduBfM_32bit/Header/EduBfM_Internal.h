@@ -44,6 +44,14 @@
  */
 #define IS_BAD_BUFFERTYPE(type) (type < 0 || type >= NUM_BUF_TYPES)
 
+/* Macro: IS_BAD_BUFFERPRIO(prio)
+ * Description: check whether the page priority hint is invalid
+ * Parameter:
+ *  Four prio       : page priority hint (BFM_PRIO_XXX)
+ * Returns: TRUE(1) if the priority hint is invalid, otherwise FALSE(0)
+ */
+#define IS_BAD_BUFFERPRIO(prio) (prio < BFM_PRIO_LOW || prio > BFM_PRIO_HIGH)
+
 /* The structure of key type used at hashing in buffer manager */
 /* same as "typedef BfMHashKey PageID; */
 typedef struct {
@@ -89,16 +97,31 @@ typedef struct {
 typedef struct {
     BfMHashKey 	key;		/* identify a page */
     Two    	fixed;		/* fixed count */
-    One    	bits;		/* bit 1 : DIRTY, bit 2 : VALID, bit 3 : REFER, bit 4 : NEW */
+    One    	bits;		/* bit 1 : DIRTY, bit 2 : VALID, bit 3 : REFER, bit 4 : NEW, bit 5 : HOT */
     Two    	nextHashEntry;
 } BufferTable;
 
 #define DIRTY  0x01
 #define VALID  0x02
 #define REFER  0x04
+#define HOT    0x10		/* high priority train: survives one more clock pass */
 #define ALL_0  0x00
 #define ALL_1  ((sizeof(One) == 1) ? (0xff) : (0xffff))
 
+/* The structure of the per-buffer information kept by EduBfM only.
+ * The layout of BufferTable is fixed by the buffer pool initialization
+ * (BfM_Init()), so the additional fields live in a parallel array which is
+ * allocated on first use by edubfm_InitBufferTableExt().
+ */
+typedef struct {
+    Lsn_T       recLsn;         /* end of log when the buffer became dirty */
+    Lsn_T       pageLsn;        /* LSN of the last update log record of the train */
+    Boolean     logged;         /* is pageLsn set by EduBfM_LogUpdate()? */
+    Two         volIdx;         /* entry of volumeStats[] charged for the buffer, NIL if none */
+    UFour       epoch;          /* bfmEpoch when the train was read into the buffer */
+    UFour       volEpoch;       /* epoch of the volume table entry when the train was read */
+} BufferTableExt;
+
 /* type definition for buffer pool information */
 typedef struct {
     Two                 bufSize;        /* size of a buffer in page size */
@@ -169,6 +192,63 @@ typedef struct {
  */
 #define BI_NEXTHASHENTRY(type, idx)  (((BufferTable*)bufInfo[type].bufTable)[idx].nextHashEntry)
 
+/* Macro: BI_RECLSN(type, idx)
+ * Description: return the recovery LSN of the dirty page/train residing in the buffer element,
+ *              i.e. the end of log when the buffer element became dirty
+ * Parameters:
+ *  Four type       : buffer type
+ *  Four idx        : array index of the buffer element
+ * Returns: (Lsn_T) recovery LSN
+ */
+#define BI_RECLSN(type, idx)         (bufTableExt[type][idx].recLsn)
+
+/* Macro: BI_PAGELSN(type, idx)
+ * Description: return the LSN of the last update log record of the page/train residing in the buffer element;
+ *              kept for every buffer type since only the pages of PAGE_BUF have a page header
+ * Parameters:
+ *  Four type       : buffer type
+ *  Four idx        : array index of the buffer element
+ * Returns: (Lsn_T) page LSN
+ */
+#define BI_PAGELSN(type, idx)        (bufTableExt[type][idx].pageLsn)
+
+/* Macro: BI_LOGGED(type, idx)
+ * Description: return whether the page/train residing in the buffer element has been updated
+ *              through EduBfM_LogUpdate() since it was read, i.e. whether BI_PAGELSN() is valid
+ * Parameters:
+ *  Four type       : buffer type
+ *  Four idx        : array index of the buffer element
+ * Returns: (Boolean) TRUE if the page LSN is valid
+ */
+#define BI_LOGGED(type, idx)         (bufTableExt[type][idx].logged)
+
+/* Macro: BI_VOLIDX(type, idx)
+ * Description: return the entry of the volume table (volumeStats[]) charged for the buffer element
+ * Parameters:
+ *  Four type       : buffer type
+ *  Four idx        : array index of the buffer element
+ * Returns: (Two) index of the volume table, NIL if the buffer element is not charged to a volume
+ */
+#define BI_VOLIDX(type, idx)         (bufTableExt[type][idx].volIdx)
+
+/* Macro: BI_EPOCH(type, idx)
+ * Description: return the buffer pool epoch (bfmEpoch) at which the train was read into the buffer element
+ * Parameters:
+ *  Four type       : buffer type
+ *  Four idx        : array index of the buffer element
+ * Returns: (UFour) buffer pool epoch
+ */
+#define BI_EPOCH(type, idx)          (bufTableExt[type][idx].epoch)
+
+/* Macro: BI_VOLEPOCH(type, idx)
+ * Description: return the epoch of the volume charged for the buffer element at which the train was read
+ * Parameters:
+ *  Four type       : buffer type
+ *  Four idx        : array index of the buffer element
+ * Returns: (UFour) volume epoch
+ */
+#define BI_VOLEPOCH(type, idx)       (bufTableExt[type][idx].volEpoch)
+
 /* Macro: BI_BUFFERPOOL(type)
  * Description: return the buffer pool
  * Parameter:
@@ -229,18 +309,220 @@ typedef struct {
 #define NOTFOUND_IN_HTABLE  -1
 
 extern BufferInfo bufInfo[];
+extern BufferTableExt *bufTableExt[];
+extern UFour bfmEpoch;
+extern Four bfmGroupCommitDelay;
+extern Boolean bfmPageChecksum;
+
+/* Macro: CHECK_BUFTABLEEXT(type)
+ * Description: allocate the parallel buffer table of EduBfM if not yet allocated
+ * Parameter:
+ *  Four type       : buffer type
+ */
+#define CHECK_BUFTABLEEXT(type) \
+BEGIN_MACRO \
+    if (bufTableExt[type] == NULL) { \
+        Four _e = edubfm_InitBufferTableExt(type); \
+        if (_e < eNOERROR) ERR(_e); \
+    } \
+END_MACRO
+
+/* number of snapshots which can wait in the flush queue of a buffer type */
+#define FLUSHQUEUE_SIZE 16
+
+/* The structure of an element of the flush queue */
+typedef struct {
+    TrainID     trainId;        /* train whose snapshot is waiting to be written */
+    char*       snapshot;       /* copy of the buffer taken by edubfm_FlushTrain() */
+    Lsn_T       lsn;            /* page LSN of the train when the snapshot was taken */
+    Boolean     logged;         /* is 'lsn' valid, i.e. was the train logged by EduBfM? */
+} FlushQueueEntry;
+
+/* The structure of the flush queue used for copy-on-flush */
+typedef struct {
+    Two                 nEntries;       /* # of snapshots in the queue */
+    FlushQueueEntry     entry[FLUSHQUEUE_SIZE];
+} FlushQueue;
+
+/* largest compressed train kept in memory: a train which does not compress
+ * to 3/4 of its size is read from the disk again rather than kept */
+#define COMPRESSED_TRAIN_MAX_LENGTH     (PAGESIZE * 3 / 4)
+
+/* average length of a compressed train assumed to size the table of the
+ * compressed trains; smaller trains may leave the arena partly unused */
+#define COMPRESSED_TRAIN_AVG_LENGTH     64
+
+/* The structure of a train kept compressed in memory */
+typedef struct {
+    BfMHashKey  key;            /* train, NIL if the train has been read back */
+    Four        offset;         /* start of the compressed train in the arena */
+    Four        length;         /* length of the compressed train */
+    UFour       epoch;          /* bfmEpoch when the train was evicted */
+    Two         volIdx;         /* entry of volumeStats[] of the train, NIL if none */
+    UFour       volEpoch;       /* epoch of the volume when the train was evicted */
+    Four        nextHashEntry;  /* next entry with the same hash value */
+} CompressedTrain;
+
+/* The structure of the cache of the compressed trains.
+ * The compressed trains are written one after another into a circular
+ * arena, and the entries describing them form a ring in the same order,
+ * so the oldest train is always the next one to be overwritten.
+ */
+typedef struct {
+    char                *arena;         /* compressed trains */
+    Four                arenaSize;      /* size of the arena in bytes */
+    Four                arenaTail;      /* where the next train is written */
+    CompressedTrain     *entry;         /* ring of the entries, oldest first */
+    Four                maxEntries;     /* size of the ring */
+    Four                firstEntry;     /* oldest entry */
+    Four                nEntries;       /* # of entries in the ring, including the ones read back */
+    Four                *hashTable;     /* first entry of each hash value, NIL if none */
+    Four                nTrains;        /* # of trains kept */
+    Four                nBytes;         /* bytes of the trains kept */
+    Four                nStored;        /* # of trains compressed and kept */
+    Four                nRejected;      /* # of trains which did not compress enough */
+    Four                nHits;          /* # of reads served from the cache */
+} CompressedTrainCache;
+
+/* Macro: CT_HASHTABLESIZE(c)
+ * Description: return the size of the hash table of the compressed trains
+ * Parameter:
+ *  CompressedTrainCache *c : the cache
+ * Returns: (Four) size of the hash table
+ */
+#define CT_HASHTABLESIZE(c)             (HASHTABLESIZE_TO_NBUFS((c)->maxEntries))
+
+extern CompressedTrainCache bfmCompressedTrains;
+extern Boolean bfmPageCompression;
+
+/* max # of volumes mapped into memory at the same time */
+#define MAX_MAPPED_VOLUMES      4
+
+/* The structure of a volume mapped into memory */
+typedef struct {
+    VolNo       volNo;          /* volume number */
+    Four        fd;             /* file descriptor of the device file */
+    char        *base;          /* start of the mapping, NULL if the entry is free */
+    Four        nPages;         /* # of pages mapped */
+    Two         *nFixed;        /* fix count of the train starting at each page */
+    Four        nFixedTotal;    /* sum of the fix counts */
+} MappedVolume;
+
+extern MappedVolume mappedVolume[];
+
+/* max # of volumes whose buffers are accounted at the same time */
+#define MAX_VOLUME_STATS        16
+
+/* The structure of the buffer accounting of a volume.
+ * 'minBufs' buffers of a type are kept for the volume against the other
+ * volumes, and the volume may use at most 'maxBufs' buffers of the type;
+ * 0 means no minimum or no maximum.
+ */
+typedef struct {
+    VolNo       volNo;                          /* volume number */
+    Four        minBufs[NUM_BUF_TYPES];         /* minimum quota */
+    Four        maxBufs[NUM_BUF_TYPES];         /* maximum quota */
+    Four        nBufs[NUM_BUF_TYPES];           /* # of buffers holding trains of the volume */
+    Four        nHits[NUM_BUF_TYPES];           /* # of fixes found in the buffer pool */
+    Four        nMisses[NUM_BUF_TYPES];         /* # of fixes read into the buffer pool */
+    UFour       epoch;                          /* incremented by EduBfM_InvalidateVolume() */
+} VolumeStats;
+
+extern VolumeStats volumeStats[];
+extern Four nVolumeStats;
+extern Boolean bfmVolumeQuota[];
+
+/* Macro: BI_STALE(type, idx)
+ * Description: check whether the buffer element holds a train invalidated by
+ *              EduBfM_DiscardAll() or EduBfM_InvalidateVolume() and not reclaimed yet
+ * Parameters:
+ *  Four type       : buffer type
+ *  Four idx        : array index of the buffer element
+ * Returns: (Boolean) TRUE if the train in the buffer element is stale
+ */
+#define BI_STALE(type, idx) \
+    (bufTableExt[type] != NULL && \
+     (BI_EPOCH(type, idx) != bfmEpoch || \
+      (BI_VOLIDX(type, idx) != NIL && \
+       BI_VOLEPOCH(type, idx) != volumeStats[BI_VOLIDX(type, idx)].epoch)))
+
+/* name of the local file used as the log volume */
+#define BFM_LOG_FILE_NAME "EduBfM.log"
+
+/* Log record types */
+#define LOG_BEGIN_CHECKPOINT    1
+#define LOG_END_CHECKPOINT      2
+#define LOG_UPDATE              3
+#define LOG_COMMIT              4
+
+/* The structure of the header of a log record */
+typedef struct {
+    Four        type;           /* log record type (LOG_XXX) */
+    Four        length;         /* length of the body following the header */
+} LogRecHdr;
+
+/* The structure of an entry of the dirty page table written at checkpoint */
+typedef struct {
+    PageID      pid;            /* dirty page/train */
+    Lsn_T       recLsn;         /* its recovery LSN */
+} DirtyPageTableEntry;
+
+/* The structure of the body of the end checkpoint log record */
+typedef struct {
+    Lsn_T       redoLsn;        /* where the redo pass should start */
+    Four        nEntries;       /* # of entries of the dirty page table */
+    DirtyPageTableEntry entry[1];   /* dirty page table (variable length) */
+} EndCheckpointLogRec;
+
+/* The structure of the body of the update log record */
+typedef struct {
+    PageID      pid;            /* updated page/train */
+    Four        length;         /* length of the redo data following */
+} UpdateLogRec;
+
+/* number of trains flushed by a checkpoint before the flush queue is drained */
+#define CHECKPOINT_BATCH_SIZE   FLUSHQUEUE_SIZE
+
 
 /*@
  * Function Prototypes
  */
 /* internal function prototypes */
-Four edubfm_AllocTrain(Four);
+Four edubfm_AllocTrain(BfMHashKey *, Four);
+void edubfm_ChargeBuffer(Four, Four);
+UFour edubfm_ComputeChecksum(char *, Four);
+Four edubfm_CompressTrain(char *, Four, char *, Four);
+Boolean edubfm_DecompressTrain(char *, Four, char *, Four);
 Four edubfm_Delete(BfMHashKey *, Four);
 Four edubfm_DeleteAll(void);
+Four edubfm_DrainFlushQueue(Four);
+void edubfm_DropCompressedTrain(TrainID *, Four);
+void edubfm_DropCompressedVolume(VolNo);
+Four edubfm_EnqueueFlush(TrainID *, char *, Lsn_T *, Four);
+Four edubfm_FlushLog(void);
 Four edubfm_FlushTrain(TrainID *, Four);
+char *edubfm_FixMappedTrain(TrainID *, Four);
+Four edubfm_ForceLog(Lsn_T *);
+Four edubfm_GetEndOfLog(Lsn_T *);
+Four edubfm_GetNumLogForces(void);
+Four edubfm_InitBufferTableExt(Four);
+Four edubfm_InitCompressedTrains(Four);
 Four edubfm_Insert(BfMHashKey *, Two, Four); 
+void edubfm_InsertCompressedTrain(Four, Four);
+Boolean edubfm_IsChecksumHardware(void);
+Boolean edubfm_IsMappedTrainFixed(TrainID *, Four);
+Boolean edubfm_IsVictimAllowed(Four, Four, Two);
 Four edubfm_LookUp(BfMHashKey *, Four);
+Boolean edubfm_LookUpCompressedTrain(TrainID *, char *, Four);
+Boolean edubfm_LookUpFlushQueue(TrainID *, char *, Four);
+Two edubfm_LookUpVolumeStats(VolNo, Boolean);
 Four edubfm_ReadTrain(TrainID *, char *, Four);
+void edubfm_ReclaimBuffer(Four, Four);
+void edubfm_StampChecksum(char *, Four);
+void edubfm_UnchargeBuffer(Four, Four);
+Boolean edubfm_UnfixMappedTrain(TrainID *, Four);
+Boolean edubfm_VerifyChecksum(char *, Four);
+Four edubfm_WriteLogRecord(Four, char *, Four, Lsn_T *);
 
 
 #endif /* _EDUBFM_INTERNAL_H_ */
@@ -44,29 +44,6 @@
 #define BI_BUFTABLE_ENTRY(type, idx) (((BufferTable*)bufInfo[type].bufTable)[idx]) 
 
 
-/*
- * Type Definition of Page
- */
-typedef struct Lsn_T_tag {
-    UFour offset;               /* byte position in a log volume */
-    UFour wrapCount;            /* # of wrapping around a log volume */
-} Lsn_T;
-
-typedef struct PageHdr_T_tag {
-    PageID pid;                 /* page id of this page */
-    Four flags;
-    Four reserved;
-    PageID fidOrIid;            /* file id or index id containing this page */
-    Lsn_T lsn;                  /* page lsn */
-    Four logRecLen;             /* log record length */
-} PageHdr;
-
-typedef struct Page_tag {
-    PageHdr header;
-    char data[PAGESIZE-sizeof(PageHdr)];
-} Page;
-
-
 /*
  * Type Definition about transaction
  */
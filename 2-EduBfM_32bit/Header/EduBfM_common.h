@@ -90,6 +90,42 @@ typedef PageID TrainID;		/* use its first page's PageID as the TrainID */
 
 #define PRINT_TRAINID(x,y) PRINT_PAGEID(x,y)
 
+/*
+ * log sequence number
+ */
+typedef struct Lsn_T_tag {
+    UFour offset;               /* byte position in a log volume */
+    UFour wrapCount;            /* # of wrapping around a log volume */
+} Lsn_T;
+
+/* Macro: LSN_CMP_LT(x, y)
+ * Description: check whether the log sequence number x precedes y
+ * Parameters:
+ *  Lsn_T x     : log sequence number
+ *  Lsn_T y     : log sequence number
+ * Returns: TRUE(1) if x is less than y, otherwise FALSE(0)
+ */
+#define LSN_CMP_LT(x, y)	\
+    ((((x).wrapCount < (y).wrapCount) || \
+      ((x).wrapCount == (y).wrapCount && (x).offset < (y).offset)) ? TRUE:FALSE)
+
+/*
+ * Type Definition of Page
+ */
+typedef struct PageHdr_T_tag {
+    PageID pid;                 /* page id of this page */
+    Four flags;
+    Four reserved;              /* owned by the buffer manager: page checksum */
+    PageID fidOrIid;            /* file id or index id containing this page */
+    Lsn_T lsn;                  /* page lsn */
+    Four logRecLen;             /* log record length */
+} PageHdr;
+
+typedef struct Page_tag {
+    PageHdr header;
+    char data[PAGESIZE-sizeof(PageHdr)];
+} Page;
+
 /*
  * Error Handling
  */
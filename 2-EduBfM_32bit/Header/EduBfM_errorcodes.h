@@ -97,3 +97,13 @@
 #define eNOMORELOCKCONTROLBLOCKS_BFM             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,59)
 #define NUM_ERRORS_BFM_ERR_BASE                  60
 #define eNOTSUPPORTED_EDUBFM		             ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,61)
+#define eBADBUFFERPRIO_EDUBFM                    ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,62)
+#define eMEMORYALLOCERR_EDUBFM                   ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,63)
+#define eLOGOPENFAILED_EDUBFM                    ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,64)
+#define eLOGWRITEFAILED_EDUBFM                   ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,65)
+#define eBADPARAMETER_EDUBFM                     ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,66)
+#define eBADCHECKSUM_EDUBFM                      ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,67)
+#define eMAPVOLUMEFAILED_EDUBFM                  ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,68)
+#define eMAPPEDVOLUMEINUSE_EDUBFM                ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,69)
+#define eREADONLYTRAIN_EDUBFM                    ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,70)
+#define eTOOMANYVOLUMES_EDUBFM                   ERR_ENCODE_ERROR_CODE(BFM_ERR_BASE,71)
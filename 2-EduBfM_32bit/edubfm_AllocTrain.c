@@ -29,7 +29,7 @@
  *  Allocate a new buffer from the buffer pool.
  *
  * Exports:
- *  Four edubfm_AllocTrain(Four)
+ *  Four edubfm_AllocTrain(BfMHashKey *, Four)
  */
 
 
@@ -44,7 +44,7 @@ extern CfgParams_T sm_cfgParams;
  * edubfm_AllocTrain()
  *================================*/
 /*
- * Function: Four edubfm_AllocTrain(Four)
+ * Function: Four edubfm_AllocTrain(BfMHashKey *, Four)
  *
  * Description : 
  * (Following description is for original ODYSSEUS/COSMOS BfM.
@@ -59,8 +59,19 @@ extern CfgParams_T sm_cfgParams;
  *  the bit for the second chance and proceed to the next entry, otherwise
  *  the current buffer indicated by BI_NEXTVICTIM(type) is selected to be
  *  returned.
+ *  A buffer whose HOT bit is set (see EduBfM_GetTrainWithPrio()) gets one
+ *  more chance: after its reference bit has been cleared, the HOT bit is
+ *  cleared on the next pass instead of selecting it as the victim.
+ *  While some volume has a buffer quota (see EduBfM_SetVolumeQuota()),
+ *  the buffers which the quotas do not allow to be given to the volume of
+ *  'key' are passed over without touching their bits; if no buffer is
+ *  allowed, the quotas are ignored.
+ *  A stale buffer, holding a train invalidated by EduBfM_DiscardAll() or
+ *  EduBfM_InvalidateVolume(), is selected at once even if it is fixed.
  *  Before return the buffer, if the dirty bit of the victim is set, it 
  *  must be force out to the disk.
+ *  While the page compression is on, the train of the victim is then kept
+ *  compressed in memory (see edubfm_CompressedTrain.c).
  *
  * Returns;
  *  1) An index of a new buffer from the buffer pool
@@ -69,6 +80,7 @@ extern CfgParams_T sm_cfgParams;
  *     some errors caused by fuction calls
  */
 Four edubfm_AllocTrain(
+    BfMHashKey  *key,           /* IN train to be read into the buffer */
     Four 	type)			/* IN type of buffer (PAGE or TRAIN) */
 {
     Four 	e;			/* for error */
@@ -76,34 +88,65 @@ Four edubfm_AllocTrain(
     Four 	i;
     Two     fixed;
     One     bits;
+    Boolean quota;          /* are the quotas enforced? */
+    Two     reqIdx;         /* volume table entry of the requesting volume */
 
 
 	/* Error check whether using not supported functionality by EduBfM */
 	if (sm_cfgParams.useBulkFlush) ERR( eNOTSUPPORTED_EDUBFM );
 
+    CHECK_BUFTABLEEXT(type);
+
+    quota = bfmVolumeQuota[type];
+    reqIdx = (quota) ? edubfm_LookUpVolumeStats(key->volNo, TRUE) : NIL;
+
     /* Second chance buffer replacement algorithm to select buffer element */
-    victim = BI_NEXTVICTIM(type);
-    for (i=0; i<BI_NBUFS(type)*2; i++) {
-        fixed = BI_FIXED(type, victim);
-        bits = BI_BITS(type, victim);
-        if (fixed == 0) {
-            if ((bits & REFER) != REFER)
-                break;
-            else
-                BI_BITS(type, victim) -= REFER;
+    /* (three passes are needed when every unfixed buffer is HOT) */
+    for (;;) {
+        victim = BI_NEXTVICTIM(type);
+        for (i=0; i<BI_NBUFS(type)*3; i++) {
+            fixed = BI_FIXED(type, victim);
+            bits = BI_BITS(type, victim);
+            if (BI_STALE(type, victim)) break;
+            if (fixed == 0 && (!quota || edubfm_IsVictimAllowed(type, victim, reqIdx))) {
+                if ((bits & REFER) == REFER)
+                    BI_BITS(type, victim) -= REFER;
+                else if ((bits & HOT) == HOT)
+                    BI_BITS(type, victim) -= HOT;
+                else
+                    break;
+            }
+            victim++;
+            victim %= BI_NBUFS(type);
         }
-        victim++;
-        victim %= BI_NBUFS(type);
+        if (i < BI_NBUFS(type) * 3) break;
+
+        if (!quota) ERR( eNOUNFIXEDBUF_BFM );
+        quota = FALSE;      /* the quotas cannot be met; ignore them */
     }
-    if (i == BI_NBUFS(type) * 2) ERR( eNOUNFIXEDBUF_BFM );
+
+    /* the clock hand continues from the buffer next to the victim */
+    BI_NEXTVICTIM(type) = (victim + 1) % BI_NBUFS(type);
 
     /* Initialization of the data structure related to selected buffer element */
-    if ((bits & DIRTY) == DIRTY) {
-        e = edubfm_FlushTrain((TrainID*)&BI_KEY(type, victim), type);
-        if (e != eNOERROR) ERR( e );
+    if (BI_STALE(type, victim)) {
+        /* the train has been invalidated; drop it without writing */
+        if (!IS_NILBFMHASHKEY(BI_KEY(type, victim)))
+            edubfm_Delete(&BI_KEY(type, victim), type);
+        edubfm_ReclaimBuffer(type, victim);
     }
-    
-    edubfm_Delete(&BI_KEY(type, victim), type); 
+    else {
+        if ((bits & DIRTY) == DIRTY) {
+            e = edubfm_FlushTrain((TrainID*)&BI_KEY(type, victim), type);
+            if (e != eNOERROR) ERR( e );
+        }
+
+        edubfm_InsertCompressedTrain(type, victim);
+
+        edubfm_UnchargeBuffer(type, victim);
+        edubfm_Delete(&BI_KEY(type, victim), type);
+    }
+
     SET_NILBFMHASHKEY(BI_KEY(type, victim));
     BI_FIXED(type, victim) = 0;
     BI_BITS(type, victim) = REFER;
@@ -0,0 +1,120 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_BufferTableExt.c
+ *
+ * Description:
+ *  Allocate the per-buffer information kept by EduBfM in parallel with the
+ *  buffer table (see BufferTableExt in EduBfM_Internal.h).
+ *  The trains read into the buffers are stamped with the epoch of the
+ *  buffer pool; EduBfM_DiscardAll() invalidates all of them at once by
+ *  advancing the epoch, and the stale buffers are reclaimed lazily by
+ *  edubfm_ReclaimBuffer() when the hash lookup or the replacement meets them.
+ *
+ * Exports:
+ *  Four edubfm_InitBufferTableExt(Four)
+ *  void edubfm_ReclaimBuffer(Four, Four)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@
+ * Global variables
+ */
+/* parallel buffer table of each buffer type */
+BufferTableExt *bufTableExt[NUM_BUF_TYPES] = { NULL, NULL };
+
+/* epoch of the buffer pool, advanced by EduBfM_DiscardAll() */
+UFour bfmEpoch = 0;
+
+
+
+/*@================================
+ * edubfm_InitBufferTableExt()
+ *================================*/
+/*
+ * Function: Four edubfm_InitBufferTableExt(Four)
+ *
+ * Description:
+ *  Allocate the parallel buffer table for the buffer pool of the given
+ *  type. All the entries are cleared to zero, and no buffer is charged
+ *  to a volume.
+ *
+ * Returns:
+ *  error code
+ *    eBADBUFFERTYPE_BFM
+ *    eMEMORYALLOCERR_EDUBFM
+ */
+Four edubfm_InitBufferTableExt(
+    Four                type)                   /* IN buffer type */
+{
+    Four                i;
+
+
+    if (IS_BAD_BUFFERTYPE(type)) ERR(eBADBUFFERTYPE_BFM);
+
+    if (bufTableExt[type] != NULL) return(eNOERROR);
+
+    bufTableExt[type] = (BufferTableExt*)calloc(BI_NBUFS(type), sizeof(BufferTableExt));
+    if (bufTableExt[type] == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+
+    for (i = 0; i < BI_NBUFS(type); i++)
+        BI_VOLIDX(type, i) = NIL;
+
+    return(eNOERROR);
+
+}  /* edubfm_InitBufferTableExt() */
+
+
+
+/*@================================
+ * edubfm_ReclaimBuffer()
+ *================================*/
+/*
+ * Function: void edubfm_ReclaimBuffer(Four, Four)
+ *
+ * Description:
+ *  Make the stale buffer empty. The buffer must have been removed from
+ *  the hash table by the caller. The buffer is not uncharged because the
+ *  invalidation has already cleared the buffer count of its volume, and a
+ *  dirty stale train is dropped without being written.
+ */
+void edubfm_ReclaimBuffer(
+    Four                type,                   /* IN buffer type */
+    Four                index)                  /* IN index of the stale buffer */
+{
+    SET_NILBFMHASHKEY(BI_KEY(type, index));
+    BI_FIXED(type, index) = 0;
+    BI_BITS(type, index) = ALL_0;
+    BI_NEXTHASHENTRY(type, index) = NIL;
+    BI_VOLIDX(type, index) = NIL;
+    BI_EPOCH(type, index) = bfmEpoch;
+
+}  /* edubfm_ReclaimBuffer() */
@@ -0,0 +1,307 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Checksum.c
+ *
+ * Description:
+ *  Page checksums of EduBfM.
+ *  While the checksums are on, the CRC32C of a PAGE_BUF train is stored in
+ *  the 'reserved' field of its page header when the train is written, and
+ *  verified when the train is read again. The field belongs to the buffer
+ *  manager (see PageHdr); no page format stores anything there. While the
+ *  checksums are off, the field is neither written nor verified. The field
+ *  itself is regarded as zero while computing the checksum, and zero in the
+ *  field means that the train has no checksum, i.e. it was never written
+ *  while the checksums were on; a computed CRC of zero is stored as 1.
+ *  The CRC32 instruction of SSE4.2 is used if the processor supports it,
+ *  otherwise a table driven software CRC gives the same result.
+ *
+ * Exports:
+ *  UFour edubfm_ComputeChecksum(char *, Four)
+ *  void edubfm_StampChecksum(char *, Four)
+ *  Boolean edubfm_VerifyChecksum(char *, Four)
+ *  Boolean edubfm_IsChecksumHardware(void)
+ */
+
+
+#include <stddef.h> /* for offsetof */
+#include <string.h> /* for memcpy */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@
+ * Constant Definitions
+ */
+#define CRC32C_POLY     0x82F63B78      /* reflected Castagnoli polynomial */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRC32C_HARDWARE
+#endif
+
+
+/*@
+ * Global variables
+ */
+Boolean         bfmPageChecksum = FALSE;    /* stamp and verify page checksums? */
+
+static UFour    crcTable[256];              /* table for the software CRC */
+static Four     crcImpl = NIL;              /* NIL: not yet chosen, TRUE: hardware, FALSE: software */
+
+
+/*@ Internal Function Prototypes */
+static void edubfm_InitChecksum(void);
+static UFour edubfm_Crc32cSoftware(UFour, unsigned char *, Four);
+#ifdef CRC32C_HARDWARE
+static UFour edubfm_Crc32cHardware(UFour, unsigned char *, Four);
+#endif
+
+
+
+/*@================================
+ * edubfm_InitChecksum()
+ *================================*/
+/*
+ * Function: static void edubfm_InitChecksum(void)
+ *
+ * Description:
+ *  Build the table of the software CRC and choose the implementation.
+ */
+static void edubfm_InitChecksum(void)
+{
+    UFour               crc;
+    Four                i, j;
+
+
+    for (i = 0; i < 256; i++) {
+        crc = i;
+        for (j = 0; j < 8; j++)
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+        crcTable[i] = crc;
+    }
+
+#ifdef CRC32C_HARDWARE
+    __builtin_cpu_init();
+    crcImpl = __builtin_cpu_supports("sse4.2") ? TRUE : FALSE;
+#else
+    crcImpl = FALSE;
+#endif
+
+}  /* edubfm_InitChecksum() */
+
+
+
+/*@================================
+ * edubfm_Crc32cSoftware()
+ *================================*/
+/*
+ * Function: static UFour edubfm_Crc32cSoftware(UFour, unsigned char *, Four)
+ *
+ * Description:
+ *  Continue the CRC32C 'crc' over the given bytes, a byte at a time.
+ *
+ * Returns:
+ *  CRC32C
+ */
+static UFour edubfm_Crc32cSoftware(
+    UFour               crc,                    /* IN CRC so far */
+    unsigned char       *p,                     /* IN bytes */
+    Four                len)                    /* IN # of bytes */
+{
+    while (len-- > 0)
+        crc = crcTable[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+
+    return(crc);
+
+}  /* edubfm_Crc32cSoftware() */
+
+
+
+#ifdef CRC32C_HARDWARE
+/*@================================
+ * edubfm_Crc32cHardware()
+ *================================*/
+/*
+ * Function: static UFour edubfm_Crc32cHardware(UFour, unsigned char *, Four)
+ *
+ * Description:
+ *  Continue the CRC32C 'crc' over the given bytes using the CRC32
+ *  instruction of SSE4.2, a word at a time.
+ *
+ * Returns:
+ *  CRC32C
+ */
+__attribute__((target("sse4.2")))
+static UFour edubfm_Crc32cHardware(
+    UFour               crc,                    /* IN CRC so far */
+    unsigned char       *p,                     /* IN bytes */
+    Four                len)                    /* IN # of bytes */
+{
+#if defined(__x86_64__)
+    unsigned long long  crc64 = crc;
+    unsigned long long  word;
+
+
+    for ( ; len >= 8; len -= 8, p += 8) {
+        memcpy(&word, p, 8);
+        crc64 = __builtin_ia32_crc32di(crc64, word);
+    }
+    crc = (UFour)crc64;
+#else
+    UFour               word;
+
+
+    for ( ; len >= 4; len -= 4, p += 4) {
+        memcpy(&word, p, 4);
+        crc = __builtin_ia32_crc32si(crc, word);
+    }
+#endif
+
+    for ( ; len > 0; len--, p++)
+        crc = __builtin_ia32_crc32qi(crc, *p);
+
+    return(crc);
+
+}  /* edubfm_Crc32cHardware() */
+#endif
+
+
+
+/*@================================
+ * edubfm_ComputeChecksum()
+ *================================*/
+/*
+ * Function: UFour edubfm_ComputeChecksum(char *, Four)
+ *
+ * Description:
+ *  Compute the checksum of a train of 'size' bytes, skipping the
+ *  'reserved' field of the page header where the checksum is stored.
+ *
+ * Returns:
+ *  checksum (never zero)
+ */
+UFour edubfm_ComputeChecksum(
+    char                *aTrain,                /* IN train */
+    Four                size)                   /* IN size of the train in bytes */
+{
+    UFour               crc = 0xFFFFFFFF;
+    UFour               zero = 0;               /* stands in for the checksum field */
+    Four                off = offsetof(PageHdr, reserved);
+    UFour               (*crcFn)(UFour, unsigned char *, Four);
+
+
+    if (crcImpl == NIL) edubfm_InitChecksum();
+
+#ifdef CRC32C_HARDWARE
+    crcFn = (crcImpl == TRUE) ? edubfm_Crc32cHardware : edubfm_Crc32cSoftware;
+#else
+    crcFn = edubfm_Crc32cSoftware;
+#endif
+
+    crc = crcFn(crc, (unsigned char*)aTrain, off);
+    crc = crcFn(crc, (unsigned char*)&zero, sizeof(Four));
+    crc = crcFn(crc, (unsigned char*)aTrain + off + sizeof(Four), size - off - sizeof(Four));
+    crc = ~crc;
+
+    return((crc == 0) ? 1 : crc);
+
+}  /* edubfm_ComputeChecksum() */
+
+
+
+/*@================================
+ * edubfm_StampChecksum()
+ *================================*/
+/*
+ * Function: void edubfm_StampChecksum(char *, Four)
+ *
+ * Description:
+ *  Store the checksum of a train of the given buffer type in its page
+ *  header if the checksums are on. Nothing is written while they are off.
+ *  Only the trains of PAGE_BUF have the page header.
+ */
+void edubfm_StampChecksum(
+    char                *aTrain,                /* INOUT train */
+    Four                type)                   /* IN buffer type */
+{
+    if (type != PAGE_BUF || !bfmPageChecksum) return;
+
+    ((PageHdr*)aTrain)->reserved = (Four)edubfm_ComputeChecksum(aTrain, PAGESIZE * BI_BUFSIZE(type));
+
+}  /* edubfm_StampChecksum() */
+
+
+
+/*@================================
+ * edubfm_VerifyChecksum()
+ *================================*/
+/*
+ * Function: Boolean edubfm_VerifyChecksum(char *, Four)
+ *
+ * Description:
+ *  Check the checksum stored in the page header of a train.
+ *  A train without the checksum is regarded as valid.
+ *
+ * Returns:
+ *  FALSE if the train is corrupted, otherwise TRUE
+ */
+Boolean edubfm_VerifyChecksum(
+    char                *aTrain,                /* IN train */
+    Four                type)                   /* IN buffer type */
+{
+    UFour               stored;                 /* checksum in the page header */
+
+
+    if (type != PAGE_BUF) return(TRUE);
+
+    stored = (UFour)((PageHdr*)aTrain)->reserved;
+    if (stored == 0) return(TRUE);
+
+    return((stored == edubfm_ComputeChecksum(aTrain, PAGESIZE * BI_BUFSIZE(type))) ? TRUE : FALSE);
+
+}  /* edubfm_VerifyChecksum() */
+
+
+
+/*@================================
+ * edubfm_IsChecksumHardware()
+ *================================*/
+/*
+ * Function: Boolean edubfm_IsChecksumHardware(void)
+ *
+ * Description:
+ *  Tell whether the checksum is computed by the CRC32 instruction.
+ *
+ * Returns:
+ *  TRUE if SSE4.2 is used, otherwise FALSE
+ */
+Boolean edubfm_IsChecksumHardware(void)
+{
+    if (crcImpl == NIL) edubfm_InitChecksum();
+
+    return((crcImpl == TRUE) ? TRUE : FALSE);
+
+}  /* edubfm_IsChecksumHardware() */
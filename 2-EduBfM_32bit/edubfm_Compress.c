@@ -0,0 +1,307 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Compress.c
+ *
+ * Description:
+ *  Compression of trains kept in memory by EduBfM.
+ *  The compressed form is an LZ4 block: a sequence of a token, literals,
+ *  a 2-byte offset and a match length, where the high 4 bits of the token
+ *  give the length of the literals and the low 4 bits the length of the
+ *  match minus 4, both continued by bytes of 255 if they do not fit.
+ *  The last 5 bytes are always literals and the last match starts at least
+ *  12 bytes before the end, as the format requires.
+ *  The compressor keeps a single hash table of the last position of each
+ *  4-byte sequence, which is fast and good enough for pages holding many
+ *  similar objects.
+ *
+ * Exports:
+ *  Four edubfm_CompressTrain(char *, Four, char *, Four)
+ *  Boolean edubfm_DecompressTrain(char *, Four, char *, Four)
+ */
+
+
+#include <string.h> /* for memcpy & memset */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@
+ * Constant Definitions
+ */
+#define LZ4_MINMATCH            4       /* shortest match */
+#define LZ4_LASTLITERALS        5       /* # of bytes at the end which are always literals */
+#define LZ4_MFLIMIT             12      /* no match starts in the last LZ4_MFLIMIT bytes */
+#define LZ4_MAXOFFSET           65535   /* largest distance of a match */
+#define LZ4_HASHLOG             12      /* log2 of the size of the hash table */
+#define LZ4_RUNMASK             15      /* largest length kept in the token */
+
+/* Macro: LZ4_HASH(seq)
+ * Description: return the hash value of a 4-byte sequence
+ * Parameter:
+ *  UFour seq       : 4 bytes read from the input
+ * Returns: (UFour) hash value
+ */
+#define LZ4_HASH(seq)           (((UFour)(seq) * 2654435761U) >> (32 - LZ4_HASHLOG))
+
+
+/*@ Internal Function Prototypes */
+static UFour edubfm_Read32(unsigned char *);
+static unsigned char *edubfm_PutLength(unsigned char *, Four);
+
+
+
+/*@================================
+ * edubfm_Read32()
+ *================================*/
+/*
+ * Function: static UFour edubfm_Read32(unsigned char *)
+ *
+ * Description:
+ *  Read 4 bytes from a position which may be unaligned.
+ *
+ * Returns:
+ *  4 bytes read
+ */
+static UFour edubfm_Read32(
+    unsigned char       *p)                     /* IN where to read */
+{
+    UFour               v;
+
+
+    memcpy(&v, p, sizeof(UFour));
+
+    return(v);
+
+}  /* edubfm_Read32() */
+
+
+
+/*@================================
+ * edubfm_PutLength()
+ *================================*/
+/*
+ * Function: static unsigned char *edubfm_PutLength(unsigned char *, Four)
+ *
+ * Description:
+ *  Write the part of a length which does not fit in the token, i.e. the
+ *  length minus LZ4_RUNMASK, as bytes of 255 followed by the remainder.
+ *
+ * Returns:
+ *  position following the bytes written
+ */
+static unsigned char *edubfm_PutLength(
+    unsigned char       *op,                    /* OUT where to write */
+    Four                len)                    /* IN length minus LZ4_RUNMASK */
+{
+    for ( ; len >= 255; len -= 255) *op++ = 255;
+    *op++ = (unsigned char)len;
+
+    return(op);
+
+}  /* edubfm_PutLength() */
+
+
+
+/*@================================
+ * edubfm_CompressTrain()
+ *================================*/
+/*
+ * Function: Four edubfm_CompressTrain(char *, Four, char *, Four)
+ *
+ * Description:
+ *  Compress 'srcLen' bytes of a train into an LZ4 block of at most
+ *  'dstCap' bytes; 'srcLen' is at most 64KB, the reach of an offset.
+ *  The compression gives up as soon as the block would
+ *  exceed 'dstCap', so a caller keeping only well compressed trains does
+ *  not pay for compressing the others to the end.
+ *
+ * Returns:
+ *  length of the block, 0 if it does not fit in 'dstCap' bytes
+ */
+Four edubfm_CompressTrain(
+    char                *src,                   /* IN train */
+    Four                srcLen,                 /* IN size of the train in bytes */
+    char                *dst,                   /* OUT compressed train */
+    Four                dstCap)                 /* IN size of 'dst' */
+{
+    unsigned char       *in = (unsigned char*)src;
+    unsigned char       *op = (unsigned char*)dst;
+    unsigned char       *oend = (unsigned char*)dst + dstCap;
+    UTwo                table[1 << LZ4_HASHLOG];        /* last position of each hash value */
+    Four                ip, ref, anchor;        /* positions in the input */
+    Four                mfLimit = srcLen - LZ4_MFLIMIT;
+    Four                matchLimit = srcLen - LZ4_LASTLITERALS;
+    Four                litLen, matchLen;
+    UFour               seq, h;
+    unsigned char       *token;
+
+
+    anchor = 0;
+
+    if (srcLen > LZ4_MFLIMIT) {
+        memset(table, 0, sizeof(table));
+
+        for (ip = 1; ip < mfLimit; ) {
+            seq = edubfm_Read32(in + ip);
+            h = LZ4_HASH(seq);
+            ref = table[h];
+            table[h] = (UTwo)ip;
+
+            if (ip - ref > LZ4_MAXOFFSET || edubfm_Read32(in + ref) != seq) {
+                ip++;
+                continue;
+            }
+
+            /* extend the match backwards over the pending literals, then forwards */
+            while (ip > anchor && ref > 0 && in[ip-1] == in[ref-1]) { ip--; ref--; }
+            for (matchLen = LZ4_MINMATCH; ip + matchLen < matchLimit && in[ip+matchLen] == in[ref+matchLen]; matchLen++);
+
+            litLen = ip - anchor;
+            if (op + 1 + litLen + litLen/255 + 1 + 2 + (matchLen-LZ4_MINMATCH)/255 + 1 > oend) return(0);
+
+            token = op++;
+            if (litLen >= LZ4_RUNMASK) {
+                *token = LZ4_RUNMASK << 4;
+                op = edubfm_PutLength(op, litLen - LZ4_RUNMASK);
+            }
+            else
+                *token = (unsigned char)(litLen << 4);
+            memcpy(op, in + anchor, litLen);
+            op += litLen;
+
+            *op++ = (unsigned char)(ip - ref);
+            *op++ = (unsigned char)((ip - ref) >> 8);
+
+            if (matchLen - LZ4_MINMATCH >= LZ4_RUNMASK) {
+                *token |= LZ4_RUNMASK;
+                op = edubfm_PutLength(op, matchLen - LZ4_MINMATCH - LZ4_RUNMASK);
+            }
+            else
+                *token |= (unsigned char)(matchLen - LZ4_MINMATCH);
+
+            ip += matchLen;
+            anchor = ip;
+
+            /* remember a position inside the match, which helps runs of similar objects */
+            if (ip < mfLimit) table[LZ4_HASH(edubfm_Read32(in + ip - 2))] = (UTwo)(ip - 2);
+        }
+    }
+
+    /* the last literals */
+    litLen = srcLen - anchor;
+    if (op + 1 + litLen + litLen/255 + 1 > oend) return(0);
+
+    token = op++;
+    if (litLen >= LZ4_RUNMASK) {
+        *token = LZ4_RUNMASK << 4;
+        op = edubfm_PutLength(op, litLen - LZ4_RUNMASK);
+    }
+    else
+        *token = (unsigned char)(litLen << 4);
+    memcpy(op, in + anchor, litLen);
+    op += litLen;
+
+    return((Four)(op - (unsigned char*)dst));
+
+}  /* edubfm_CompressTrain() */
+
+
+
+/*@================================
+ * edubfm_DecompressTrain()
+ *================================*/
+/*
+ * Function: Boolean edubfm_DecompressTrain(char *, Four, char *, Four)
+ *
+ * Description:
+ *  Decompress an LZ4 block of 'srcLen' bytes into a train of exactly
+ *  'dstLen' bytes. Every length and offset is checked against the bounds
+ *  of both buffers, so a damaged block cannot write outside the train.
+ *
+ * Returns:
+ *  TRUE if the block is valid and gives 'dstLen' bytes, otherwise FALSE
+ */
+Boolean edubfm_DecompressTrain(
+    char                *src,                   /* IN compressed train */
+    Four                srcLen,                 /* IN length of the compressed train */
+    char                *dst,                   /* OUT train */
+    Four                dstLen)                 /* IN size of the train in bytes */
+{
+    unsigned char       *in = (unsigned char*)src;
+    unsigned char       *out = (unsigned char*)dst;
+    Four                ip = 0, op = 0;         /* positions in the input and the output */
+    Four                len, offset, i;
+    unsigned char       token, b;
+
+
+    for (;;) {
+        if (ip >= srcLen) return(FALSE);
+        token = in[ip++];
+
+        /* literals */
+        len = token >> 4;
+        if (len == LZ4_RUNMASK) {
+            do {
+                if (ip >= srcLen) return(FALSE);
+                b = in[ip++];
+                len += b;
+            } while (b == 255);
+        }
+        if (len > srcLen - ip || len > dstLen - op) return(FALSE);
+        memcpy(out + op, in + ip, len);
+        ip += len;
+        op += len;
+
+        /* the last sequence has no match */
+        if (ip == srcLen) return((op == dstLen) ? TRUE : FALSE);
+
+        /* match */
+        if (srcLen - ip < 2) return(FALSE);
+        offset = in[ip] | (in[ip+1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) return(FALSE);
+
+        len = token & LZ4_RUNMASK;
+        if (len == LZ4_RUNMASK) {
+            do {
+                if (ip >= srcLen) return(FALSE);
+                b = in[ip++];
+                len += b;
+            } while (b == 255);
+        }
+        len += LZ4_MINMATCH;
+        if (len > dstLen - op) return(FALSE);
+
+        /* the match may overlap the bytes it produces */
+        if (offset >= len)
+            memcpy(out + op, out + op - offset, len);
+        else
+            for (i = 0; i < len; i++) out[op+i] = out[op-offset+i];
+        op += len;
+    }
+
+}  /* edubfm_DecompressTrain() */
@@ -0,0 +1,409 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_CompressedTrain.c
+ *
+ * Description:
+ *  Cache of the cold trains kept compressed in memory.
+ *  While the page compression is on (see EduBfM_SetPageCompression()), a
+ *  PAGE_BUF train chosen as the victim of the replacement is compressed
+ *  (see edubfm_Compress.c) and kept in the cache, after it has been
+ *  flushed if it was dirty. When the train is fixed again, edubfm_ReadTrain()
+ *  decompresses it instead of reading the disk. A train is kept either
+ *  in the buffer pool or in the cache, never in both: it leaves the cache
+ *  when it is read back.
+ *  The compressed trains are written one after another into a circular
+ *  arena and replaced oldest first, so a scan over more pages than the
+ *  arena holds evicts its own pages rather than searching for room.
+ *  Like the buffers, the entries are stamped with the epochs of the buffer
+ *  pool and of the volume, and the entries invalidated by
+ *  EduBfM_DiscardAll() or EduBfM_InvalidateVolume() are dropped when they
+ *  are met.
+ *
+ * Exports:
+ *  Four edubfm_InitCompressedTrains(Four)
+ *  void edubfm_InsertCompressedTrain(Four, Four)
+ *  Boolean edubfm_LookUpCompressedTrain(TrainID *, char *, Four)
+ *  void edubfm_DropCompressedTrain(TrainID *, Four)
+ *  void edubfm_DropCompressedVolume(VolNo)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include <string.h> /* for memcpy */
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@
+ * macro definitions
+ */
+/* Macro: CT_HASH(c,k)
+ * Description: return the hash value of the key given as a parameter
+ * Parameters:
+ *  CompressedTrainCache *c : the cache
+ *  BfMHashKey *k   : pointer to the key
+ * Returns: (Four) hash value
+ */
+#define CT_HASH(c,k)            (((k)->volNo + (k)->pageNo) % CT_HASHTABLESIZE(c))
+
+/* Macro: CT_STALE(ct)
+ * Description: check whether the compressed train has been invalidated
+ * Parameter:
+ *  CompressedTrain *ct : the entry of the compressed train
+ * Returns: (Boolean) TRUE if the compressed train is stale
+ */
+#define CT_STALE(ct) \
+    ((ct)->epoch != bfmEpoch || \
+     ((ct)->volIdx != NIL && (ct)->volEpoch != volumeStats[(ct)->volIdx].epoch))
+
+
+/*@
+ * Global variables
+ */
+/* the compressed trains */
+CompressedTrainCache bfmCompressedTrains;
+
+/* keep the cold trains compressed? */
+Boolean bfmPageCompression = FALSE;
+
+
+/*@ Internal Function Prototypes */
+static Four edubfm_FindCompressedTrain(BfMHashKey *);
+static void edubfm_UnlinkCompressedTrain(Four);
+static void edubfm_EvictCompressedTrain(void);
+
+
+
+/*@================================
+ * edubfm_InitCompressedTrains()
+ *================================*/
+/*
+ * Function: Four edubfm_InitCompressedTrains(Four)
+ *
+ * Description:
+ *  Drop all the compressed trains and give the cache an arena of 'nBytes'
+ *  bytes; 0 frees the cache and turns the page compression off.
+ *  'nBytes' must be 0 or at least PAGESIZE.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUBFM
+ */
+Four edubfm_InitCompressedTrains(
+    Four                nBytes)                 /* IN size of the arena */
+{
+    CompressedTrainCache *c = &bfmCompressedTrains;
+    Four                i;
+
+
+    bfmPageCompression = FALSE;
+
+    if (c->arena != NULL) free(c->arena);
+    if (c->entry != NULL) free(c->entry);
+    if (c->hashTable != NULL) free(c->hashTable);
+    memset(c, 0, sizeof(CompressedTrainCache));
+
+    if (nBytes == 0) return(eNOERROR);
+
+    c->arenaSize = nBytes;
+    c->maxEntries = nBytes / COMPRESSED_TRAIN_AVG_LENGTH + 1;
+
+    c->arena = (char*)malloc(c->arenaSize);
+    c->entry = (CompressedTrain*)malloc(sizeof(CompressedTrain) * c->maxEntries);
+    c->hashTable = (Four*)malloc(sizeof(Four) * CT_HASHTABLESIZE(c));
+    if (c->arena == NULL || c->entry == NULL || c->hashTable == NULL) {
+        edubfm_InitCompressedTrains(0);
+        ERR(eMEMORYALLOCERR_EDUBFM);
+    }
+
+    for (i = 0; i < CT_HASHTABLESIZE(c); i++)
+        c->hashTable[i] = NIL;
+
+    bfmPageCompression = TRUE;
+
+    return(eNOERROR);
+
+}  /* edubfm_InitCompressedTrains() */
+
+
+
+/*@================================
+ * edubfm_FindCompressedTrain()
+ *================================*/
+/*
+ * Function: static Four edubfm_FindCompressedTrain(BfMHashKey *)
+ *
+ * Description:
+ *  Look up the entry of the compressed train.
+ *
+ * Returns:
+ *  index of the entry, NIL if the train is not kept
+ */
+static Four edubfm_FindCompressedTrain(
+    BfMHashKey          *key)                   /* IN train */
+{
+    CompressedTrainCache *c = &bfmCompressedTrains;
+    Four                i;
+
+
+    for (i = c->hashTable[CT_HASH(c, key)]; i != NIL; i = c->entry[i].nextHashEntry)
+        if (EQUALKEY(&c->entry[i].key, key)) return(i);
+
+    return(NIL);
+
+}  /* edubfm_FindCompressedTrain() */
+
+
+
+/*@================================
+ * edubfm_UnlinkCompressedTrain()
+ *================================*/
+/*
+ * Function: static void edubfm_UnlinkCompressedTrain(Four)
+ *
+ * Description:
+ *  Remove the entry from the hash table. The entry stays in the ring, and
+ *  its bytes in the arena, until the oldest end of the ring reaches it.
+ */
+static void edubfm_UnlinkCompressedTrain(
+    Four                idx)                    /* IN index of the entry */
+{
+    CompressedTrainCache *c = &bfmCompressedTrains;
+    Four                *link;
+
+
+    for (link = &c->hashTable[CT_HASH(c, &c->entry[idx].key)]; *link != idx; link = &c->entry[*link].nextHashEntry);
+    *link = c->entry[idx].nextHashEntry;
+
+    SET_NILBFMHASHKEY(c->entry[idx].key);
+    c->nTrains--;
+    c->nBytes -= c->entry[idx].length;
+
+}  /* edubfm_UnlinkCompressedTrain() */
+
+
+
+/*@================================
+ * edubfm_EvictCompressedTrain()
+ *================================*/
+/*
+ * Function: static void edubfm_EvictCompressedTrain(void)
+ *
+ * Description:
+ *  Remove the oldest entry from the ring, freeing its bytes in the arena.
+ */
+static void edubfm_EvictCompressedTrain(void)
+{
+    CompressedTrainCache *c = &bfmCompressedTrains;
+
+
+    if (!IS_NILBFMHASHKEY(c->entry[c->firstEntry].key))
+        edubfm_UnlinkCompressedTrain(c->firstEntry);
+
+    c->firstEntry = (c->firstEntry + 1) % c->maxEntries;
+    c->nEntries--;
+
+}  /* edubfm_EvictCompressedTrain() */
+
+
+
+/*@================================
+ * edubfm_InsertCompressedTrain()
+ *================================*/
+/*
+ * Function: void edubfm_InsertCompressedTrain(Four, Four)
+ *
+ * Description:
+ *  Compress the train held by the buffer, which is about to be replaced,
+ *  and keep it in the cache. The buffer must not be dirty and must still
+ *  be charged to its volume. A train which does not compress to
+ *  COMPRESSED_TRAIN_MAX_LENGTH bytes is not kept.
+ *  Room is made in the arena by dropping the oldest trains.
+ */
+void edubfm_InsertCompressedTrain(
+    Four                type,                   /* IN buffer type */
+    Four                index)                  /* IN index of the buffer */
+{
+    CompressedTrainCache *c = &bfmCompressedTrains;
+    CompressedTrain     *ct;                    /* the new entry */
+    char                buf[COMPRESSED_TRAIN_MAX_LENGTH];       /* compressed train */
+    Four                len;                    /* length of the compressed train */
+    Four                oldest;                 /* start of the oldest train in the arena */
+    Four                i;
+
+
+    if (!bfmPageCompression || type != PAGE_BUF) return;
+
+    /* an older copy of the train is replaced */
+    i = edubfm_FindCompressedTrain(&BI_KEY(type, index));
+    if (i != NIL) edubfm_UnlinkCompressedTrain(i);
+
+    len = edubfm_CompressTrain(BI_BUFFER(type, index), PAGESIZE, buf, COMPRESSED_TRAIN_MAX_LENGTH);
+    if (len == 0) {
+        c->nRejected++;
+        return;
+    }
+
+    /* free the oldest trains until the train fits after the newest one */
+    for (;;) {
+        if (c->nEntries == 0) {
+            c->arenaTail = 0;
+            break;
+        }
+
+        if (c->nEntries < c->maxEntries) {
+            oldest = c->entry[c->firstEntry].offset;
+            if (c->arenaTail > oldest) {
+                /* the free bytes are at the end and at the start of the arena */
+                if (c->arenaTail + len <= c->arenaSize) break;
+                if (len <= oldest) {
+                    c->arenaTail = 0;
+                    break;
+                }
+            }
+            else if (c->arenaTail + len <= oldest) break;
+        }
+
+        edubfm_EvictCompressedTrain();
+    }
+
+    i = (c->firstEntry + c->nEntries) % c->maxEntries;
+    ct = &c->entry[i];
+    ct->key = BI_KEY(type, index);
+    ct->offset = c->arenaTail;
+    ct->length = len;
+    ct->epoch = bfmEpoch;
+    ct->volIdx = BI_VOLIDX(type, index);
+    ct->volEpoch = (ct->volIdx != NIL) ? BI_VOLEPOCH(type, index) : 0;
+
+    memcpy(c->arena + ct->offset, buf, len);
+    c->arenaTail += len;
+
+    ct->nextHashEntry = c->hashTable[CT_HASH(c, &ct->key)];
+    c->hashTable[CT_HASH(c, &ct->key)] = i;
+
+    c->nEntries++;
+    c->nTrains++;
+    c->nBytes += len;
+    c->nStored++;
+
+}  /* edubfm_InsertCompressedTrain() */
+
+
+
+/*@================================
+ * edubfm_LookUpCompressedTrain()
+ *================================*/
+/*
+ * Function: Boolean edubfm_LookUpCompressedTrain(TrainID *, char *, Four)
+ *
+ * Description:
+ *  If the train is kept compressed, decompress it into the given buffer
+ *  and drop it from the cache.
+ *
+ * Returns:
+ *  TRUE if the buffer has been filled, otherwise FALSE
+ */
+Boolean edubfm_LookUpCompressedTrain(
+    TrainID             *trainId,               /* IN train to be read */
+    char                *aTrain,                /* OUT buffer */
+    Four                type)                   /* IN buffer type */
+{
+    CompressedTrainCache *c = &bfmCompressedTrains;
+    CompressedTrain     *ct;
+    Four                i;
+    Boolean             found;
+
+
+    if (!bfmPageCompression || type != PAGE_BUF) return(FALSE);
+
+    i = edubfm_FindCompressedTrain((BfMHashKey*)trainId);
+    if (i == NIL) return(FALSE);
+
+    ct = &c->entry[i];
+    found = (!CT_STALE(ct) && edubfm_DecompressTrain(c->arena + ct->offset, ct->length, aTrain, PAGESIZE));
+
+    edubfm_UnlinkCompressedTrain(i);
+    if (found) c->nHits++;
+
+    return(found);
+
+}  /* edubfm_LookUpCompressedTrain() */
+
+
+
+/*@================================
+ * edubfm_DropCompressedTrain()
+ *================================*/
+/*
+ * Function: void edubfm_DropCompressedTrain(TrainID *, Four)
+ *
+ * Description:
+ *  Drop the compressed copy of the train if it is kept, e.g. when the
+ *  train is read from a newer copy.
+ */
+void edubfm_DropCompressedTrain(
+    TrainID             *trainId,               /* IN train */
+    Four                type)                   /* IN buffer type */
+{
+    Four                i;
+
+
+    if (!bfmPageCompression || type != PAGE_BUF) return;
+
+    i = edubfm_FindCompressedTrain((BfMHashKey*)trainId);
+    if (i != NIL) edubfm_UnlinkCompressedTrain(i);
+
+}  /* edubfm_DropCompressedTrain() */
+
+
+
+/*@================================
+ * edubfm_DropCompressedVolume()
+ *================================*/
+/*
+ * Function: void edubfm_DropCompressedVolume(VolNo)
+ *
+ * Description:
+ *  Drop all the compressed trains of the volume. Only needed for a volume
+ *  without an entry in the volume table, whose trains cannot be
+ *  invalidated through the epoch of the volume.
+ */
+void edubfm_DropCompressedVolume(
+    VolNo               volNo)                  /* IN volume number */
+{
+    CompressedTrainCache *c = &bfmCompressedTrains;
+    Four                i, n;
+
+
+    if (!bfmPageCompression) return;
+
+    for (n = 0, i = c->firstEntry; n < c->nEntries; n++, i = (i + 1) % c->maxEntries)
+        if (c->entry[i].key.volNo == volNo && !IS_NILBFMHASHKEY(c->entry[i].key))
+            edubfm_UnlinkCompressedTrain(i);
+
+}  /* edubfm_DropCompressedVolume() */
@@ -0,0 +1,230 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_FlushQueue.c
+ *
+ * Description:
+ *  Copy-on-flush support for the buffer manager.
+ *  edubfm_FlushTrain() does not write a train from the live buffer.
+ *  It copies the buffer into a staging buffer (snapshot) of the flush queue
+ *  and clears the dirty bit right away, so the buffer may be modified again
+ *  while the snapshot is waiting to be written. The snapshots are written
+ *  behind, when the queue becomes full or when the queue is drained
+ *  explicitly (e.g. EduBfM_FlushAll()).
+ *  A train read from the disk while its snapshot is still in the queue is
+ *  served from the snapshot.
+ *  Before the snapshots are written, the log is forced up to the largest
+ *  page LSN among them (write-ahead logging), so a single log force covers
+ *  the whole queue. Only the page LSNs set by EduBfM_LogUpdate() count;
+ *  an LSN in a page header may come from another log and is ignored.
+ *
+ * Exports:
+ *  Four edubfm_EnqueueFlush(TrainID *, char *, Lsn_T *, Four)
+ *  Four edubfm_DrainFlushQueue(Four)
+ *  Boolean edubfm_LookUpFlushQueue(TrainID *, char *, Four)
+ */
+
+
+#include <stdlib.h> /* for malloc & free */
+#include <string.h>
+#include "EduBfM_common.h"
+#include "RDsM.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@
+ * Global variables
+ */
+/* flush queue for each buffer type */
+static FlushQueue flushQueue[NUM_BUF_TYPES];
+
+
+
+/*@================================
+ * edubfm_EnqueueFlush()
+ *================================*/
+/*
+ * Function: Four edubfm_EnqueueFlush(TrainID *, char *, Lsn_T *, Four)
+ *
+ * Description:
+ *  Take a snapshot of the buffer 'aTrain' holding the train 'trainId' and
+ *  put it into the flush queue with the page LSN 'lsn' of the train, or
+ *  NULL if the train has not been logged by EduBfM_LogUpdate(). If a
+ *  snapshot of the same train is already in the queue, it is replaced by
+ *  the new one. If the queue is full, the queue is drained first.
+ *
+ * Returns:
+ *  error code
+ *    eNOERROR
+ *    some errors caused by function calls
+ */
+Four edubfm_EnqueueFlush(
+    TrainID             *trainId,               /* IN train to be flushed */
+    char                *aTrain,                /* IN buffer holding the train */
+    Lsn_T               *lsn,                   /* IN page LSN of the train, NULL if not logged */
+    Four                type)                   /* IN buffer type */
+{
+    Four                e;                      /* for errors */
+    Two                 i;                      /* index */
+    FlushQueue          *q = &flushQueue[type]; /* flush queue of the buffer type */
+
+
+    for (i = 0; i < q->nEntries; i++) {
+        if (EQUALKEY(&q->entry[i].trainId, trainId)) break;
+    }
+
+    if (i == q->nEntries) {
+        if (q->nEntries == FLUSHQUEUE_SIZE) {
+            e = edubfm_DrainFlushQueue(type);
+            if (e < eNOERROR) ERR(e);
+            i = 0;
+        }
+
+        /* staging buffers are allocated once and reused */
+        if (q->entry[i].snapshot == NULL) {
+            q->entry[i].snapshot = (char*)malloc(PAGESIZE * BI_BUFSIZE(type));
+            if (q->entry[i].snapshot == NULL) ERR(eMEMORYALLOCERR_EDUBFM);
+        }
+
+        q->entry[i].trainId = *trainId;
+        q->nEntries++;
+    }
+
+    memcpy(q->entry[i].snapshot, aTrain, PAGESIZE * BI_BUFSIZE(type));
+    q->entry[i].logged = (lsn != NULL);
+    if (lsn != NULL) q->entry[i].lsn = *lsn;
+
+    return(eNOERROR);
+
+}  /* edubfm_EnqueueFlush() */
+
+
+
+/*@================================
+ * edubfm_DrainFlushQueue()
+ *================================*/
+/*
+ * Function: Four edubfm_DrainFlushQueue(Four)
+ *
+ * Description:
+ *  Write all the snapshots in the flush queue of the given buffer type
+ *  into the disk and empty the queue.
+ *  No snapshot is written before the log records up to its page LSN are
+ *  on the disk. Only the snapshots of the trains logged by
+ *  EduBfM_LogUpdate() have a page LSN; the LSN in a page header is not
+ *  used.
+ *  The checksum is stamped on the snapshot just before it is written.
+ *
+ * Returns:
+ *  error code
+ *    eNOERROR
+ *    some errors caused by function calls
+ */
+Four edubfm_DrainFlushQueue(
+    Four                type)                   /* IN buffer type */
+{
+    Four                e;                      /* for errors */
+    Two                 i;                      /* index */
+    FlushQueue          *q = &flushQueue[type]; /* flush queue of the buffer type */
+    Boolean             logged = FALSE;         /* is any snapshot logged by EduBfM? */
+    Lsn_T               maxLsn;                 /* largest page LSN of the snapshots */
+    FlushQueueEntry     written[FLUSHQUEUE_SIZE]; /* entries written before an error */
+
+
+    for (i = 0; i < q->nEntries; i++) {
+        if (!q->entry[i].logged) continue;
+        if (!logged || LSN_CMP_LT(maxLsn, q->entry[i].lsn)) maxLsn = q->entry[i].lsn;
+        logged = TRUE;
+    }
+
+    if (logged) {
+        e = edubfm_ForceLog(&maxLsn);
+        if (e < eNOERROR) ERR(e);
+    }
+
+    for (i = 0; i < q->nEntries; i++) {
+        edubfm_StampChecksum(q->entry[i].snapshot, type);
+
+        e = RDsM_WriteTrain(q->entry[i].snapshot, (PageID*)&q->entry[i].trainId, BI_BUFSIZE(type));
+        if (e < eNOERROR) {
+            /* keep the snapshots not yet written at the front; the staging
+               buffers of the written ones are rotated behind them, so that
+               each buffer stays owned by exactly one entry */
+            memcpy(written, &q->entry[0], sizeof(FlushQueueEntry) * i);
+            memmove(&q->entry[0], &q->entry[i], sizeof(FlushQueueEntry) * (q->nEntries - i));
+            memcpy(&q->entry[q->nEntries - i], written, sizeof(FlushQueueEntry) * i);
+            q->nEntries -= i;
+            ERR(e);
+        }
+    }
+
+    q->nEntries = 0;
+
+    return(eNOERROR);
+
+}  /* edubfm_DrainFlushQueue() */
+
+
+
+/*@================================
+ * edubfm_LookUpFlushQueue()
+ *================================*/
+/*
+ * Function: Boolean edubfm_LookUpFlushQueue(TrainID *, char *, Four)
+ *
+ * Description:
+ *  If a snapshot of the train 'trainId' is waiting in the flush queue,
+ *  copy it into the buffer 'aTrain'; the snapshot is newer than the disk
+ *  content of the train. With NULL 'aTrain', only the existence of the
+ *  snapshot is checked.
+ *
+ * Returns:
+ *  TRUE if the snapshot is found, otherwise FALSE
+ *
+ * Side effects:
+ *  1) parameter aTrain
+ *     a buffer specified by 'aTrain' is filled with the snapshot
+ */
+Boolean edubfm_LookUpFlushQueue(
+    TrainID             *trainId,               /* IN which train? */
+    char                *aTrain,                /* OUT a pointer to buffer */
+    Four                type)                   /* IN buffer type */
+{
+    Two                 i;                      /* index */
+    FlushQueue          *q = &flushQueue[type]; /* flush queue of the buffer type */
+
+
+    for (i = 0; i < q->nEntries; i++) {
+        if (EQUALKEY(&q->entry[i].trainId, trainId)) {
+            if (aTrain != NULL)
+                memcpy(aTrain, q->entry[i].snapshot, PAGESIZE * BI_BUFSIZE(type));
+            return(TRUE);
+        }
+    }
+
+    return(FALSE);
+
+}  /* edubfm_LookUpFlushQueue() */
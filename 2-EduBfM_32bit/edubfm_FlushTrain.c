@@ -56,6 +56,14 @@
  *  found, then force it out to the disk using RDsM, especially
  *  RDsM_WriteTrain().
  *
+ *  (EduBfM) The train is not written from the live buffer. A snapshot of
+ *  the buffer is put into the flush queue and the dirty bit is cleared
+ *  before the write, so that the buffer can be updated again while the
+ *  snapshot is written behind (see edubfm_FlushQueue.c).
+ *  The write-ahead logging rule is kept when the snapshot is written, for
+ *  the updates logged by EduBfM_LogUpdate(). The log of EduBfM is not the
+ *  log of the recovery manager, hence rollback is still not supported.
+ *
  * Returns:
  *  error code
  *    some errors caused by function calls
@@ -77,8 +85,13 @@ Four edubfm_FlushTrain(
     }
     else {
         if ((BI_BITS(type, index) & DIRTY) == DIRTY) {
-            RDsM_WriteTrain(BI_BUFFER(type, index), (PageID*)trainId, BI_BUFSIZE(type)); 
             BI_BITS(type, index) -= DIRTY;
+            e = edubfm_EnqueueFlush(trainId, BI_BUFFER(type, index),
+                                    BI_LOGGED(type, index) ? &BI_PAGELSN(type, index) : NULL, type);
+            if (e < eNOERROR) {
+                BI_BITS(type, index) |= DIRTY;
+                ERR(e);
+            }
         }
     }
 
@@ -141,7 +141,7 @@ Four edubfm_Delete(
                 BI_HASHTABLEENTRY(type, hashValue) = BI_NEXTHASHENTRY(type, i);
             else
                 BI_NEXTHASHENTRY(type, prev) = BI_NEXTHASHENTRY(type, i);                
-            BI_NEXTHASHENTRY(type, hashValue) = NIL;
+            BI_NEXTHASHENTRY(type, i) = NIL;
             break;
         }
         prev = i;
@@ -166,6 +166,8 @@ Four edubfm_Delete(
  *
  *  Look up the given key in the hash table and return its
  *  corressponding index to the buffer table.
+ *  The stale entries in the chain are removed and their buffers are
+ *  reclaimed, so a stale train is never found.
  *
  * Retruns:
  *  index on buffer table entry holding the train specified by 'key'
@@ -176,15 +178,30 @@ Four edubfm_LookUp(
     Four                type)                   /* IN buffer type */
 {
     Two                 i, j;                   /* indices */
+    Two                 prev;                   /* entry preceding 'i' in the chain */
     Two                 hashValue;
 
 
     CHECKKEY(key);    /*@ check validity of key */
 
     hashValue = BFM_HASH(key, type);
-    for (i = BI_HASHTABLEENTRY(type, hashValue); i!=NIL; i = BI_NEXTHASHENTRY(type, i)) {
+    prev = NIL;
+    for (i = BI_HASHTABLEENTRY(type, hashValue); i!=NIL; i = j) {
+        j = BI_NEXTHASHENTRY(type, i);
+
+        /* unlink and reclaim the stale entries met on the way */
+        if (BI_STALE(type, i)) {
+            if (prev == NIL)
+                BI_HASHTABLEENTRY(type, hashValue) = j;
+            else
+                BI_NEXTHASHENTRY(type, prev) = j;
+            edubfm_ReclaimBuffer(type, i);
+            continue;
+        }
+
         if (EQUALKEY(&BI_KEY(type, i), key))
             return i;
+        prev = i;
     }
 
     return(NOTFOUND_IN_HTABLE);
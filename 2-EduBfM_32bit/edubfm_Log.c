@@ -0,0 +1,387 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_Log.c
+ *
+ * Description:
+ *  Log manager of EduBfM.
+ *  A local file stands in for the log volume of the recovery manager.
+ *  Log records are appended to the file named BFM_LOG_FILE_NAME and the
+ *  log sequence number(LSN) of a record is its byte position in the file.
+ *  The file is opened on first use. These LSNs are unrelated to those of the
+ *  recovery manager, which are not supported by the log manager.
+ *
+ *  The log manager keeps the flushed LSN, i.e. the end of the part of the
+ *  log which is known to be on the disk. Forcing the log uses group commit:
+ *  the first transaction which finds no force in progress becomes the
+ *  leader and calls fsync() for every record appended so far, while the
+ *  transactions arriving in the meantime wait for the leader and are made
+ *  durable together by the next force. Only the log manager is thread safe;
+ *  the buffer manager itself is still used by one thread at a time.
+ *
+ * Exports:
+ *  Four edubfm_WriteLogRecord(Four, char *, Four, Lsn_T *)
+ *  Four edubfm_GetEndOfLog(Lsn_T *)
+ *  Four edubfm_ForceLog(Lsn_T *)
+ *  Four edubfm_FlushLog(void)
+ *  Four edubfm_GetNumLogForces(void)
+ */
+
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@
+ * Global variables
+ */
+Four            bfmGroupCommitDelay = 0;    /* usec a leader waits for followers before fsync() */
+
+static Four     logFd = NIL;            /* file descriptor of the log file */
+static Lsn_T    endOfLog;               /* LSN of the next log record */
+static Lsn_T    flushedLsn;             /* log records before this LSN are on the disk */
+static Boolean  forceInProgress = FALSE;    /* is a leader calling fsync()? */
+static Four     nLogForces = 0;         /* # of fsync() calls on the log file */
+
+static pthread_mutex_t logMutex = PTHREAD_MUTEX_INITIALIZER;    /* protects the variables above */
+static pthread_cond_t  logForced = PTHREAD_COND_INITIALIZER;    /* signaled when a force is done */
+
+
+/*@ Internal Function Prototypes */
+static Four edubfm_OpenLog(void);
+static Four edubfm_ForceLogUpTo(Lsn_T *);
+
+
+
+/*@================================
+ * edubfm_OpenLog()
+ *================================*/
+/*
+ * Function: static Four edubfm_OpenLog(void)
+ *
+ * Description:
+ *  Open the log file and position the end of log at the end of the file.
+ *  The existing contents of the file are regarded as flushed.
+ *  The caller should hold logMutex.
+ *
+ * Returns:
+ *  error code
+ *    eLOGOPENFAILED_EDUBFM
+ */
+static Four edubfm_OpenLog(void)
+{
+    off_t               size;                   /* size of the log file */
+
+
+    logFd = open(BFM_LOG_FILE_NAME, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (logFd < 0) {
+        logFd = NIL;
+        ERR(eLOGOPENFAILED_EDUBFM);
+    }
+
+    size = lseek(logFd, 0, SEEK_END);
+    if (size < 0) {
+        close(logFd);
+        logFd = NIL;
+        ERR(eLOGOPENFAILED_EDUBFM);
+    }
+
+    endOfLog.offset = (UFour)size;
+    endOfLog.wrapCount = 0;
+    flushedLsn = endOfLog;
+
+    return(eNOERROR);
+
+}  /* edubfm_OpenLog() */
+
+
+
+/*@================================
+ * edubfm_WriteLogRecord()
+ *================================*/
+/*
+ * Function: Four edubfm_WriteLogRecord(Four, char *, Four, Lsn_T *)
+ *
+ * Description:
+ *  Append a log record of the given type and body to the log.
+ *  The record is written to the file but not forced to the disk;
+ *  use edubfm_ForceLog() to make it durable.
+ *
+ * Returns:
+ *  error code
+ *    eLOGWRITEFAILED_EDUBFM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter lsn
+ *     LSN of the written log record
+ */
+Four edubfm_WriteLogRecord(
+    Four                type,                   /* IN log record type */
+    char                *body,                  /* IN body of the log record */
+    Four                length,                 /* IN length of the body */
+    Lsn_T               *lsn)                   /* OUT LSN of the log record */
+{
+    Four                e = eNOERROR;           /* for errors */
+    LogRecHdr           hdr;                    /* header of the log record */
+    struct iovec        iov[2];                 /* header and body written at once */
+
+
+    hdr.type = type;
+    hdr.length = length;
+
+    iov[0].iov_base = (void*)&hdr;
+    iov[0].iov_len = sizeof(LogRecHdr);
+    iov[1].iov_base = (void*)body;
+    iov[1].iov_len = (length > 0) ? length : 0;
+
+    pthread_mutex_lock(&logMutex);
+
+    if (logFd == NIL) e = edubfm_OpenLog();
+
+    if (e >= eNOERROR) {
+        if (writev(logFd, iov, 2) != sizeof(LogRecHdr) + iov[1].iov_len)
+            e = eLOGWRITEFAILED_EDUBFM;
+        else {
+            if (lsn != NULL) *lsn = endOfLog;
+            endOfLog.offset += sizeof(LogRecHdr) + iov[1].iov_len;
+        }
+    }
+
+    pthread_mutex_unlock(&logMutex);
+
+    if (e < eNOERROR) ERR(e);
+
+    return(eNOERROR);
+
+}  /* edubfm_WriteLogRecord() */
+
+
+
+/*@================================
+ * edubfm_GetEndOfLog()
+ *================================*/
+/*
+ * Function: Four edubfm_GetEndOfLog(Lsn_T *)
+ *
+ * Description:
+ *  Return the LSN which will be given to the next log record.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter lsn
+ *     end of log
+ */
+Four edubfm_GetEndOfLog(
+    Lsn_T               *lsn)                   /* OUT end of log */
+{
+    Four                e = eNOERROR;           /* for errors */
+
+
+    pthread_mutex_lock(&logMutex);
+
+    if (logFd == NIL) e = edubfm_OpenLog();
+    if (e >= eNOERROR) *lsn = endOfLog;
+
+    pthread_mutex_unlock(&logMutex);
+
+    if (e < eNOERROR) ERR(e);
+
+    return(eNOERROR);
+
+}  /* edubfm_GetEndOfLog() */
+
+
+
+/*@================================
+ * edubfm_ForceLogUpTo()
+ *================================*/
+/*
+ * Function: static Four edubfm_ForceLogUpTo(Lsn_T *)
+ *
+ * Description:
+ *  Wait until the flushed LSN passes the given LSN, becoming the leader of
+ *  a force if no force is in progress. The leader waits bfmGroupCommitDelay
+ *  usec so that more transactions can join, and forces all the records
+ *  appended until then. The caller should hold logMutex.
+ *
+ * Returns:
+ *  error code
+ *    eLOGWRITEFAILED_EDUBFM
+ */
+static Four edubfm_ForceLogUpTo(
+    Lsn_T               *lsn)                   /* IN LSN which should be on the disk */
+{
+    Lsn_T               target;                 /* end of log forced by the leader */
+    int                 rc;                     /* return value of fsync() */
+
+
+    while (!LSN_CMP_LT(*lsn, flushedLsn)) {
+
+        if (forceInProgress) {
+            /* follower: the leader forces our record, or the next leader does */
+            pthread_cond_wait(&logForced, &logMutex);
+            continue;
+        }
+
+        /* leader */
+        forceInProgress = TRUE;
+
+        if (bfmGroupCommitDelay > 0) {
+            pthread_mutex_unlock(&logMutex);
+            usleep(bfmGroupCommitDelay);
+            pthread_mutex_lock(&logMutex);
+        }
+
+        target = endOfLog;
+
+        pthread_mutex_unlock(&logMutex);
+        rc = fsync(logFd);
+        pthread_mutex_lock(&logMutex);
+
+        forceInProgress = FALSE;
+        if (rc == 0) {
+            flushedLsn = target;
+            nLogForces++;
+        }
+        pthread_cond_broadcast(&logForced);
+
+        if (rc != 0) return(eLOGWRITEFAILED_EDUBFM);
+    }
+
+    return(eNOERROR);
+
+}  /* edubfm_ForceLogUpTo() */
+
+
+
+/*@================================
+ * edubfm_ForceLog()
+ *================================*/
+/*
+ * Function: Four edubfm_ForceLog(Lsn_T *)
+ *
+ * Description:
+ *  Force the log to the disk up to and including the log record of the
+ *  given LSN. The LSN must be one given by this log manager; LSNs of other
+ *  logs, e.g. the page LSNs set by the recovery manager, are not supported
+ *  and an LSN beyond the end of log is rejected.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_EDUBFM - the LSN is beyond the end of log
+ *    eLOGWRITEFAILED_EDUBFM
+ *    some errors caused by function calls
+ */
+Four edubfm_ForceLog(
+    Lsn_T               *lsn)                   /* IN LSN of the log record to be forced */
+{
+    Four                e = eNOERROR;           /* for errors */
+
+
+    pthread_mutex_lock(&logMutex);
+
+    if (logFd == NIL) e = edubfm_OpenLog();
+
+    /* no log record of this log manager starts at or after the end of log */
+    if (e >= eNOERROR && !LSN_CMP_LT(*lsn, endOfLog)) e = eBADPARAMETER_EDUBFM;
+
+    if (e >= eNOERROR && LSN_CMP_LT(flushedLsn, endOfLog))
+        e = edubfm_ForceLogUpTo(lsn);
+
+    pthread_mutex_unlock(&logMutex);
+
+    if (e < eNOERROR) ERR(e);
+
+    return(eNOERROR);
+
+}  /* edubfm_ForceLog() */
+
+
+
+/*@================================
+ * edubfm_FlushLog()
+ *================================*/
+/*
+ * Function: Four edubfm_FlushLog(void)
+ *
+ * Description:
+ *  Force the log records written so far to the disk.
+ *
+ * Returns:
+ *  error code
+ *    eLOGWRITEFAILED_EDUBFM
+ *    some errors caused by function calls
+ */
+Four edubfm_FlushLog(void)
+{
+    Four                e;                      /* for errors */
+    Lsn_T               last;                   /* beyond every log record */
+
+
+    last.offset = ~(UFour)0;
+    last.wrapCount = ~(UFour)0;
+
+    e = edubfm_ForceLog(&last);
+    if (e < eNOERROR) ERR(e);
+
+    return(eNOERROR);
+
+}  /* edubfm_FlushLog() */
+
+
+
+/*@================================
+ * edubfm_GetNumLogForces()
+ *================================*/
+/*
+ * Function: Four edubfm_GetNumLogForces(void)
+ *
+ * Description:
+ *  Return the number of fsync() calls made on the log file so far.
+ *
+ * Returns:
+ *  # of log forces
+ */
+Four edubfm_GetNumLogForces(void)
+{
+    Four                n;                      /* # of log forces */
+
+
+    pthread_mutex_lock(&logMutex);
+    n = nLogForces;
+    pthread_mutex_unlock(&logMutex);
+
+    return(n);
+
+}  /* edubfm_GetNumLogForces() */
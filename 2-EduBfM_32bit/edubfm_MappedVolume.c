@@ -0,0 +1,200 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_MappedVolume.c
+ *
+ * Description:
+ *  Memory mapped volumes of EduBfM.
+ *  The device file of a read-mostly volume may be mapped into memory by
+ *  EduBfM_MapVolume(). A train of a mapped volume which is not in the
+ *  buffer pool is returned as a pointer into the mapping instead of being
+ *  read into a buffer; only a fix count per train is kept, and caching
+ *  and eviction are left to the kernel. The mapping is read only, so the
+ *  trains to be updated are fixed in the buffer pool as before (see
+ *  EduBfM_GetTrainForUpdate()). A train in the buffer pool or in the
+ *  flush queue is never served from the mapping because the mapping may
+ *  not have its latest contents yet.
+ *  The page p of a volume on a single device is at the byte p * PAGESIZE
+ *  of the device file.
+ *
+ * Exports:
+ *  char *edubfm_FixMappedTrain(TrainID *, Four)
+ *  Boolean edubfm_UnfixMappedTrain(TrainID *, Four)
+ *  Boolean edubfm_IsMappedTrainFixed(TrainID *, Four)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@
+ * Global variables
+ */
+/* table of the mapped volumes; an entry with NULL 'base' is free */
+MappedVolume mappedVolume[MAX_MAPPED_VOLUMES];
+
+
+/*@ Internal Function Prototypes */
+static MappedVolume *edubfm_LookUpMappedTrain(TrainID *, Four);
+
+
+
+/*@================================
+ * edubfm_LookUpMappedTrain()
+ *================================*/
+/*
+ * Function: static MappedVolume *edubfm_LookUpMappedTrain(TrainID *, Four)
+ *
+ * Description:
+ *  Find the mapped volume holding the whole given train.
+ *
+ * Returns:
+ *  the mapped volume, or NULL if the train is not in a mapped volume
+ */
+static MappedVolume *edubfm_LookUpMappedTrain(
+    TrainID             *trainId,               /* IN train */
+    Four                type)                   /* IN buffer type */
+{
+    Four                i;                      /* index */
+
+
+    for (i = 0; i < MAX_MAPPED_VOLUMES; i++) {
+        if (mappedVolume[i].base != NULL && mappedVolume[i].volNo == trainId->volNo) {
+            if (trainId->pageNo < 0 || trainId->pageNo + BI_BUFSIZE(type) > mappedVolume[i].nPages)
+                return(NULL);
+            return(&mappedVolume[i]);
+        }
+    }
+
+    return(NULL);
+
+}  /* edubfm_LookUpMappedTrain() */
+
+
+
+/*@================================
+ * edubfm_FixMappedTrain()
+ *================================*/
+/*
+ * Function: char *edubfm_FixMappedTrain(TrainID *, Four)
+ *
+ * Description:
+ *  Fix a train in the mapping of its volume. The caller should have
+ *  checked that the train is not in the buffer pool.
+ *  A train waiting in the flush queue, or a PAGE_BUF train whose page
+ *  header does not hold its own page id (e.g. a page never written), is
+ *  not served from the mapping.
+ *
+ * Returns:
+ *  pointer to the train in the mapping, or NULL if the train should be
+ *  read into the buffer pool
+ */
+char *edubfm_FixMappedTrain(
+    TrainID             *trainId,               /* IN train to be fixed */
+    Four                type)                   /* IN buffer type */
+{
+    MappedVolume        *mv;                    /* volume holding the train */
+    char                *aTrain;                /* the train in the mapping */
+
+
+    mv = edubfm_LookUpMappedTrain(trainId, type);
+    if (mv == NULL) return(NULL);
+
+    if (edubfm_LookUpFlushQueue(trainId, NULL, type)) return(NULL);
+
+    aTrain = mv->base + (size_t)trainId->pageNo * PAGESIZE;
+
+    if (type == PAGE_BUF && !EQUALKEY(&((PageHdr*)aTrain)->pid, trainId)) return(NULL);
+
+    mv->nFixed[trainId->pageNo]++;
+    mv->nFixedTotal++;
+
+    return(aTrain);
+
+}  /* edubfm_FixMappedTrain() */
+
+
+
+/*@================================
+ * edubfm_UnfixMappedTrain()
+ *================================*/
+/*
+ * Function: Boolean edubfm_UnfixMappedTrain(TrainID *, Four)
+ *
+ * Description:
+ *  Unfix a train fixed in the mapping of its volume.
+ *  If the same train is fixed both in the mapping and in the buffer pool,
+ *  the fix in the mapping is released first; the buffer then stays fixed
+ *  longer than needed, which is safe, and the total of the fix counts is
+ *  right when all the fixes are released.
+ *
+ * Returns:
+ *  TRUE if a fix in the mapping is released, otherwise FALSE
+ */
+Boolean edubfm_UnfixMappedTrain(
+    TrainID             *trainId,               /* IN train to be unfixed */
+    Four                type)                   /* IN buffer type */
+{
+    MappedVolume        *mv;                    /* volume holding the train */
+
+
+    mv = edubfm_LookUpMappedTrain(trainId, type);
+    if (mv == NULL || mv->nFixed[trainId->pageNo] == 0) return(FALSE);
+
+    mv->nFixed[trainId->pageNo]--;
+    mv->nFixedTotal--;
+
+    return(TRUE);
+
+}  /* edubfm_UnfixMappedTrain() */
+
+
+
+/*@================================
+ * edubfm_IsMappedTrainFixed()
+ *================================*/
+/*
+ * Function: Boolean edubfm_IsMappedTrainFixed(TrainID *, Four)
+ *
+ * Description:
+ *  Tell whether the train is fixed in the mapping of its volume.
+ *
+ * Returns:
+ *  TRUE if the train is fixed in the mapping, otherwise FALSE
+ */
+Boolean edubfm_IsMappedTrainFixed(
+    TrainID             *trainId,               /* IN train */
+    Four                type)                   /* IN buffer type */
+{
+    MappedVolume        *mv;                    /* volume holding the train */
+
+
+    mv = edubfm_LookUpMappedTrain(trainId, type);
+
+    return((mv != NULL && mv->nFixed[trainId->pageNo] > 0) ? TRUE : FALSE);
+
+}  /* edubfm_IsMappedTrainFixed() */
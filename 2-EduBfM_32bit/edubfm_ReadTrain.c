@@ -55,9 +55,17 @@
  *  when RDsM_ReadTrain() is called, simply return it.  The function has
  *  no code for checking input parameters since this will be done RDsM,
  *  especially RDsM_ReadTrain().
+ *  If a snapshot of the train is waiting in the flush queue, the train is
+ *  copied from the snapshot instead of the disk.
+ *  If the train is kept compressed in memory (see
+ *  edubfm_CompressedTrain.c), it is decompressed instead of read from the
+ *  disk.
+ *  If page checksums are on, the checksum of the train read from the disk
+ *  is verified.
  *
  * Returns;
  *  error code
+ *    eBADCHECKSUM_EDUBFM - the train read is corrupted
  *    some errors caused by RDsM_ReadTrain()
  *
  * Side effects
@@ -69,10 +77,26 @@ Four edubfm_ReadTrain(
     char    *aTrain,		/* OUT a pointer to buffer */
     Four    type )		/* IN buffer type */
 {
+    Four    e;			/* for errors */
+
+
     /* Error check whether using not supported functionality by EduBfM */
     if (RM_IS_ROLLBACK_REQUIRED()) ERR(eNOTSUPPORTED_EDUBFM);
 
-    return RDsM_ReadTrain(trainId, aTrain, BI_BUFSIZE(type));
+    /* The disk content is stale if a snapshot is not yet written. */
+    if (edubfm_LookUpFlushQueue(trainId, aTrain, type)) {
+        edubfm_DropCompressedTrain(trainId, type);
+        return(eNOERROR);
+    }
+
+    if (edubfm_LookUpCompressedTrain(trainId, aTrain, type)) return(eNOERROR);
+
+    e = RDsM_ReadTrain(trainId, aTrain, BI_BUFSIZE(type));
+    if (e < eNOERROR) return(e);
+
+    if (bfmPageChecksum && !edubfm_VerifyChecksum(aTrain, type)) ERR(eBADCHECKSUM_EDUBFM);
+
+    return(eNOERROR);
 
 
 }  /* edubfm_ReadTrain */
@@ -0,0 +1,203 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubfm_VolumeStats.c
+ *
+ * Description:
+ *  Buffer accounting per volume.
+ *  Every buffer holding a train is charged to the volume of the train, so
+ *  that the number of buffers used by each volume is known; the volume
+ *  table also keeps the buffer quotas of the volume (see
+ *  EduBfM_SetVolumeQuota()) and its hit and miss counters. The entry of
+ *  the volume charged for a buffer is kept in the parallel buffer table
+ *  (BI_VOLIDX()), so that charging, uncharging and the quota checks of
+ *  the replacement do not search the volume table.
+ *  The entry also keeps the epoch of the volume, which is advanced by
+ *  EduBfM_InvalidateVolume() to invalidate all the trains of the volume.
+ *
+ * Exports:
+ *  Two edubfm_LookUpVolumeStats(VolNo, Boolean)
+ *  void edubfm_ChargeBuffer(Four, Four)
+ *  void edubfm_UnchargeBuffer(Four, Four)
+ *  Boolean edubfm_IsVictimAllowed(Four, Four, Two)
+ */
+
+
+#include "EduBfM_common.h"
+#include "EduBfM_Internal.h"
+
+
+
+/*@
+ * Global variables
+ */
+/* volume table; the first 'nVolumeStats' entries are used */
+VolumeStats volumeStats[MAX_VOLUME_STATS];
+Four nVolumeStats = 0;
+
+/* TRUE if some volume has a quota on the buffers of the type */
+Boolean bfmVolumeQuota[NUM_BUF_TYPES] = { FALSE, FALSE };
+
+
+
+/*@================================
+ * edubfm_LookUpVolumeStats()
+ *================================*/
+/*
+ * Function: Two edubfm_LookUpVolumeStats(VolNo, Boolean)
+ *
+ * Description:
+ *  Return the entry of the volume table for the given volume.
+ *  If the volume has no entry and 'create' is TRUE, a cleared entry is
+ *  added to the table.
+ *
+ * Returns:
+ *  index of the entry, NIL if the volume has no entry (or the table is full)
+ */
+Two edubfm_LookUpVolumeStats(
+    VolNo               volNo,                  /* IN volume number */
+    Boolean             create)                 /* IN add an entry if not found? */
+{
+    Four                i;
+    Four                type;
+
+
+    for (i = 0; i < nVolumeStats; i++)
+        if (volumeStats[i].volNo == volNo) return(i);
+
+    if (!create || nVolumeStats == MAX_VOLUME_STATS) return(NIL);
+
+    volumeStats[i].volNo = volNo;
+    for (type = 0; type < NUM_BUF_TYPES; type++) {
+        volumeStats[i].minBufs[type] = 0;
+        volumeStats[i].maxBufs[type] = 0;
+        volumeStats[i].nBufs[type] = 0;
+        volumeStats[i].nHits[type] = 0;
+        volumeStats[i].nMisses[type] = 0;
+    }
+    volumeStats[i].epoch = 0;
+    nVolumeStats++;
+
+    return(i);
+
+}  /* edubfm_LookUpVolumeStats() */
+
+
+
+/*@================================
+ * edubfm_ChargeBuffer()
+ *================================*/
+/*
+ * Function: void edubfm_ChargeBuffer(Four, Four)
+ *
+ * Description:
+ *  Charge the buffer to the volume of the train it has just been given,
+ *  and stamp the buffer with the current epochs of the buffer pool and of
+ *  the volume.
+ *  The parallel buffer table must have been allocated.
+ */
+void edubfm_ChargeBuffer(
+    Four                type,                   /* IN buffer type */
+    Four                index)                  /* IN index of the buffer */
+{
+    Two                 volIdx;
+
+
+    volIdx = edubfm_LookUpVolumeStats(BI_KEY(type, index).volNo, TRUE);
+
+    BI_VOLIDX(type, index) = volIdx;
+    BI_EPOCH(type, index) = bfmEpoch;
+    if (volIdx != NIL) {
+        BI_VOLEPOCH(type, index) = volumeStats[volIdx].epoch;
+        volumeStats[volIdx].nBufs[type]++;
+    }
+
+}  /* edubfm_ChargeBuffer() */
+
+
+
+/*@================================
+ * edubfm_UnchargeBuffer()
+ *================================*/
+/*
+ * Function: void edubfm_UnchargeBuffer(Four, Four)
+ *
+ * Description:
+ *  Release the charge of the buffer whose train is being removed from
+ *  the buffer pool. A stale buffer is not counted any more.
+ *  The parallel buffer table must have been allocated.
+ */
+void edubfm_UnchargeBuffer(
+    Four                type,                   /* IN buffer type */
+    Four                index)                  /* IN index of the buffer */
+{
+    Two                 volIdx = BI_VOLIDX(type, index);
+
+
+    if (volIdx != NIL && !BI_STALE(type, index)) volumeStats[volIdx].nBufs[type]--;
+    BI_VOLIDX(type, index) = NIL;
+
+}  /* edubfm_UnchargeBuffer() */
+
+
+
+/*@================================
+ * edubfm_IsVictimAllowed()
+ *================================*/
+/*
+ * Function: Boolean edubfm_IsVictimAllowed(Four, Four, Two)
+ *
+ * Description:
+ *  Check whether the quotas allow the buffer to be replaced by a train of
+ *  the requesting volume.
+ *  A volume which has reached its maximum quota may only replace its own
+ *  trains, and a volume may not take a buffer from another volume which
+ *  does not hold more than its minimum quota.
+ *
+ * Returns:
+ *  TRUE if the buffer may be chosen as the victim, FALSE otherwise
+ */
+Boolean edubfm_IsVictimAllowed(
+    Four                type,                   /* IN buffer type */
+    Four                victim,                 /* IN index of the candidate buffer */
+    Two                 reqIdx)                 /* IN entry of the requesting volume, NIL if none */
+{
+    Two                 volIdx = BI_VOLIDX(type, victim);
+    VolumeStats         *vs;
+
+
+    if (reqIdx != NIL) {
+        vs = &volumeStats[reqIdx];
+        if (vs->maxBufs[type] > 0 && vs->nBufs[type] >= vs->maxBufs[type])
+            return(volIdx == reqIdx);
+    }
+
+    if (volIdx == NIL || volIdx == reqIdx) return(TRUE);
+
+    vs = &volumeStats[volIdx];
+
+    return(vs->nBufs[type] > vs->minBufs[type]);
+
+}  /* edubfm_IsVictimAllowed() */
@@ -0,0 +1,323 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : EduOM_AppendToObject.c
+ * 
+ * Description : 
+ *  EduOM_AppendToObject() appends data to the end of the object.
+ *
+ * Exports:
+ *  Four EduOM_AppendToObject(ObjectID*, ObjectID*, Four, void*, Pool*, DeallocListElem*)
+ */
+
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "Util.h"		/* to get Pool */
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+
+
+/*@ Internal Function Prototypes */
+static Four eduom_CreateForwarded(ObjectID*, Two, Four, char*, Four, char*, ObjectID*);
+
+
+
+/*@================================
+ * EduOM_AppendToObject()
+ *================================*/
+/*
+ * Function: Four EduOM_AppendToObject(ObjectID*, ObjectID*, Four, void*, Pool*, DeallocListElem*)
+ * 
+ * Description : 
+ *  (1) What to do?
+ *  EduOM_AppendToObject() appends 'length' bytes of 'data' to the end of
+ *  the object identified by 'oid'. The ObjectID of the object does not
+ *  change. A small object grows in its page if the page has enough free
+ *  space; otherwise it is moved to another page as a forwarded record and
+ *  its slot keeps a stub pointing to the record. A small object growing
+ *  longer than LRGOBJ_THRESHOLD is moved as a large object. Only the last
+ *  leaf and the new leaves of a large object are written.
+ *
+ *  (2) How to do?
+ *  a. Read in the slotted page
+ *  b. Check the object identifier
+ *  c. IF moved object THEN fix the page of the forwarded record
+ *  d. IF large object THEN
+ *	   append the data to the tree of the object with eduom_LotAppend()
+ *     ELSE IF the object can grow in its page THEN
+ *	   grow the object with eduom_ResizeObject() and copy the data
+ *     ELSE
+ *	   create a forwarded record holding the old and the new data
+ *	   IF moved object THEN
+ *	       remove the old forwarded record
+ *	       IF its page becomes empty THEN
+ *	           drop the page from the file and put it into the dealloc list
+ *	       ENDIF
+ *	   ELSE
+ *	       make the object a stub
+ *	   ENDIF
+ *	   point the stub to the new forwarded record
+ *     ENDIF
+ *  e. Set the pages dirty and free them
+ *
+ * Returns:
+ *  error code
+ *    eBADCATALOGOBJECT_OM
+ *    eBADOBJECTID_OM
+ *    eBADLENGTH_OM
+ *    eBADUSERBUF_OM
+ *    some errors caused by function calls
+ */
+Four EduOM_AppendToObject(
+    ObjectID	*catObjForFile,	/* IN file containing the object */
+    ObjectID	*oid,		/* IN object to append to */
+    Four		length,		/* IN amount of data to append */
+    void		*data,		/* IN data to append */
+    Pool		*dlPool,	/* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)	/* INOUT head of dealloc list */
+{
+    Four	e;				/* error number */
+    PageID	pid;			/* page containing the object */
+    SlottedPage	*apage;		/* pointer to the buffer of the page */
+    Object	*obj;			/* pointer to the object in the slotted page */
+    ObjectID	fwdOid;		/* object holding the data: the forwarded record or the object */
+    PageID	fpid;			/* page of 'fwdOid' */
+    SlottedPage	*fpage;		/* pointer to the buffer of 'fpid' */
+    Object	*fobj;			/* pointer to 'fwdOid' */
+    ObjectID	newOid;		/* new forwarded record */
+    Four	oldLen;			/* length of the object */
+    Four	alignedLen;		/* aligned length of the old forwarded record */
+    Four	oldFree;		/* free space of a page before it is changed */
+    Boolean	moved;			/* is the object moved? */
+    Boolean	grown;			/* has the object grown in its page? */
+    sm_CatOverlayForData *catEntry; /* overlay structure for catalog object access */
+    DeallocListElem *dlElem;/* pointer to element of dealloc list */
+    char	buf[PAGESIZE];	/* data of the object to move */
+
+    
+    
+    /*@ check parameters */
+
+    if (catObjForFile == NULL) ERR(eBADCATALOGOBJECT_OM);
+
+    if (oid == NULL) ERR(eBADOBJECTID_OM);
+
+    if (length < 0) ERR(eBADLENGTH_OM);
+
+    if (length > 0 && data == NULL) ERR(eBADUSERBUF_OM);
+
+    MAKE_PAGEID(pid, oid->volNo, oid->pageNo);
+	e = BfM_GetTrain(&pid, (char **)&apage, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	if (oid->slotNo < 0 || oid->slotNo >= apage->header.nSlots || !IS_VALID_OBJECTID(oid, apage))
+		ERRB1(eBADOBJECTID_OM, &pid, PAGE_BUF);
+
+	obj = (Object*)(apage->data + apage->slot[-1*oid->slotNo].offset);
+
+	/*@ find the object holding the data */
+	moved = (obj->header.properties & P_MOVED) ? TRUE : FALSE;
+	if (moved) {
+		memcpy(&fwdOid, obj->data, sizeof(ObjectID));
+		MAKE_PAGEID(fpid, fwdOid.volNo, fwdOid.pageNo);
+		e = BfM_GetTrain(&fpid, (char **)&fpage, PAGE_BUF);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+		fobj = (Object*)(fpage->data + fpage->slot[-1*fwdOid.slotNo].offset);
+	}
+	else {
+		fwdOid = *oid;
+		fpid = pid;
+		fpage = apage;
+		fobj = obj;
+	}
+
+	if (fobj->header.properties & P_LRGOBJ) {
+		e = eduom_LotAppend(catObjForFile, &fpid, fobj, length, data);
+		if (e<0) ERR(e);
+	}
+	else {
+		oldLen = fobj->header.length;
+
+		/*@ grow the object in its page */
+		grown = FALSE;
+		if (ALIGNED_LENGTH(oldLen + length) <= LRGOBJ_THRESHOLD &&
+			ALIGNED_LENGTH(DATA_LENGTH_IN_PAGE(oldLen + length)) - ALIGNED_LENGTH(OBJ_LENGTH_IN_PAGE(fobj)) <= SP_FREE(fpage)) {
+			oldFree = SP_FREE(fpage);
+
+			grown = eduom_ResizeObject(fpage, fwdOid.slotNo, oldLen + length);
+			if (grown) {
+				fobj = (Object*)(fpage->data + fpage->slot[-1*fwdOid.slotNo].offset);
+				memcpy(fobj->data + oldLen, data, length);
+				fobj->header.length = oldLen + length;
+			}
+
+			e = eduom_PutInAvailSpaceList(catObjForFile, &fpid, fpage, oldFree);
+			if (e<0) ERR(e);
+		}
+
+		/*@ move the object to a new forwarded record */
+		if (!grown) {
+			memcpy(buf, fobj->data, oldLen);
+
+			e = eduom_CreateForwarded(catObjForFile, fobj->header.tag, oldLen, buf, length, data, &newOid);
+			if (e<0) ERR(e);
+
+			if (moved) {
+				/* the old forwarded record is not referenced anymore; its page is reused
+				   through the available space list, or dropped if it becomes empty */
+				oldFree = SP_FREE(fpage);
+
+				fobj = (Object*)(fpage->data + fpage->slot[-1*fwdOid.slotNo].offset);
+				alignedLen = sizeof(ObjectHdr) + ALIGNED_LENGTH(OBJ_LENGTH_IN_PAGE(fobj));
+				if (fpage->slot[-1*fwdOid.slotNo].offset + alignedLen == fpage->header.free)
+					fpage->header.free -= alignedLen;
+				else
+					fpage->header.unused += alignedLen;
+				eduom_FreeSlot(fpage, fwdOid.slotNo);
+
+				e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+				if (e<0) ERR(e);
+
+				if (fpage->header.nSlots == 0 && fpid.pageNo != catEntry->firstPage) {
+					e = eduom_RemoveFromAvailSpaceList(catObjForFile, &fpid, fpage, oldFree);
+					if (e<0) ERR(e);
+					e = eduom_FileMapDeletePage(catObjForFile, &fpid);
+					if (e<0) ERR(e);
+					eduom_FsmRemovePage(catObjForFile, &fpid);
+					e = Util_getElementFromPool(dlPool, &dlElem);
+					if (e<0) ERR(e);
+					dlElem->type = DL_PAGE;
+					dlElem->elem.pid = fpid;
+					dlElem->next = dlHead->next;
+					dlHead->next = dlElem;
+				}
+				else {
+					e = eduom_PutInAvailSpaceList(catObjForFile, &fpid, fpage, oldFree);
+					if (e<0) ERR(e);
+				}
+			}
+			else {
+				/* the data area of an object can always hold an ObjectID */
+				oldFree = SP_FREE(apage);
+
+				eduom_ResizeObject(apage, oid->slotNo, sizeof(ObjectID));
+				obj = (Object*)(apage->data + apage->slot[-1*oid->slotNo].offset);
+				obj->header.properties |= P_MOVED;
+				obj->header.length = sizeof(ObjectID);
+
+				e = eduom_PutInAvailSpaceList(catObjForFile, &pid, apage, oldFree);
+				if (e<0) ERR(e);
+			}
+
+			obj = (Object*)(apage->data + apage->slot[-1*oid->slotNo].offset);
+			memcpy(obj->data, &newOid, sizeof(ObjectID));
+
+			e = BfM_SetDirty(&pid, PAGE_BUF);
+			if (e<0) ERR(e);
+		}
+	}
+
+	e = BfM_SetDirty(&fpid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	if (moved) {
+		e = BfM_FreeTrain(&fpid, PAGE_BUF);
+		if (e<0) ERR(e);
+	}
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+    return(eNOERROR);
+    
+} /* EduOM_AppendToObject() */
+
+
+
+/*@================================
+ * eduom_CreateForwarded()
+ *================================*/
+/*
+ * Function: static Four eduom_CreateForwarded(ObjectID*, Two, Four, char*, Four, char*, ObjectID*)
+ *
+ * Description :
+ *  Create the forwarded record of a moved object with the old data of the
+ *  object followed by the appended data, in a page having enough free
+ *  space. The record is a large object if it is longer than
+ *  LRGOBJ_THRESHOLD.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_CreateForwarded(
+    ObjectID	*catObjForFile,	/* IN file containing the object */
+    Two			tag,		/* IN tag of the object */
+    Four		oldLen,		/* IN length of the old data */
+    char		*buf,		/* IN old data; the appended data is put after it if it fits */
+    Four		length,		/* IN amount of data to append */
+    char		*data,		/* IN data to append */
+    ObjectID	*oid)		/* OUT the forwarded record */
+{
+    Four	e;				/* error number */
+    ObjectHdr	objHdr;		/* header of the forwarded record */
+    PageID	pid;			/* page of the forwarded record */
+    SlottedPage	*apage;		/* pointer to the buffer of the page */
+    Object	*obj;			/* pointer to the forwarded record */
+
+
+	objHdr.properties = P_FORWARDED;
+	objHdr.tag = tag;
+	objHdr.length = 0;
+
+	if (ALIGNED_LENGTH(oldLen + length) <= LRGOBJ_THRESHOLD) {
+		memcpy(buf + oldLen, data, length);
+		e = eduom_CreateObject(catObjForFile, NULL, &objHdr, oldLen + length, buf, oid);
+		if (e<0) ERR(e);
+
+		return(eNOERROR);
+	}
+
+	e = eduom_LotCreate(catObjForFile, NULL, &objHdr, oldLen, buf, oid);
+	if (e<0) ERR(e);
+
+	MAKE_PAGEID(pid, oid->volNo, oid->pageNo);
+	e = BfM_GetTrain(&pid, (char **)&apage, PAGE_BUF);
+	if (e<0) ERR(e);
+	obj = (Object*)(apage->data + apage->slot[-1*oid->slotNo].offset);
+
+	e = eduom_LotAppend(catObjForFile, &pid, obj, length, data);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+	e = BfM_SetDirty(&pid, PAGE_BUF);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	return(eNOERROR);
+
+} /* eduom_CreateForwarded() */
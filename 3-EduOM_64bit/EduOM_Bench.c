@@ -0,0 +1,1639 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduOM_Bench.c
+ *
+ * Description :
+ *  Small-object workload driver for the object manager.
+ *  A data file of 'objects' objects of 'object_bytes' bytes is loaded;
+ *  then, in each of 'rounds' rounds, 'churn' percent of the objects chosen
+ *  at random are destroyed and as many new objects are created in the
+ *  pages having free space, so that the pages keep many slots and the
+ *  new objects reuse the slots freed on them.
+ *
+ *  The result is printed in the form "name key=value key=value ...":
+ *  one "om_load" line, one "om_scan" line with the time of a full scan of
+ *  the loaded file by a NextObject()/ReadObject() loop and by an
+ *  EduOM_ScanNext() cursor, one "om_filter" line with the time of a scan
+ *  selecting 'selectivity' percent of the objects by their key (the first
+ *  4 bytes of an object hold its load order), one "om_pscan" line with the
+ *  time of the same selection by the scan cursor and by EduOM_ParallelScan(),
+ *  one "om_churn" line with the throughput and
+ *  the average latency of the destroy and create operations and the # of
+ *  pages of the file after the rounds (before each round, the 'reserved'
+ *  header word of every page is overwritten as the buffer manager does
+ *  with the page checksum, and the pages are flushed and read again; the
+ *  # of objects is checked at the end), one "om_update"
+ *  line with the average latency of an overwrite and of a growth by
+ *  'object_bytes' bytes of 'updates' random objects (for impl=edu, in place
+ *  and by appending, for impl=base, by destroying and recreating the
+ *  object) and the time of a read of every object afterwards, and, if
+ *  'large_bytes' is set, one "om_large" line with the throughput of the
+ *  creation and of a streaming read of 'large_objects' large objects of
+ *  'large_bytes' bytes and, for impl=edu, the average latency of an
+ *  overwrite of 'object_bytes' bytes at a random position and of an append,
+ *  and, if 'pax_columns' is set, one "om_pax" line comparing two new files
+ *  holding 'objects' records of 'pax_columns' 4-byte columns, one of
+ *  objects in slotted pages and one of records in PAX pages: the # of
+ *  pages, the load time and the time of a scan summing the first column
+ *  by the scan cursor and by the PAX projection scan, and, if 'fixed' is
+ *  set, one "om_fixed" line comparing two new files holding 'objects'
+ *  records of 'object_bytes' bytes, one of objects in slotted pages and
+ *  one of records in fixed-length record pages: the # of pages, the load
+ *  time and the time of a scan by the scan cursor, then the # of pages
+ *  after every other record is destroyed and as many are created again
+ *  near the records kept, and, if 'truncate' is set, one "om_truncate"
+ *  line with the time of emptying a new file holding 'objects' objects by
+ *  EduOM_DestroyObject() per object, by EduOM_DestroyObjects() and by
+ *  EduOM_TruncateFile(), the file being loaded again before each.
+ *
+ *  Usage: EduOM_Bench [key=value ...]
+ *    impl=edu|base         EduOM_*() or the original OM_*() functions (edu)
+ *    objects=N             # of objects kept in the file (100000)
+ *    object_bytes=N        size of an object (16)
+ *    rounds=N              # of destroy/create rounds (10)
+ *    churn=N               percentage of the objects replaced in a round (50)
+ *    seed=N                seed of the random number generator (1)
+ *    batch=N               # of objects loaded by an EduOM_CreateObjects()
+ *                          call; 1 for EduOM_CreateObject() (1)
+ *    readahead=N           # of pages read ahead by the scan cursor (8)
+ *    selectivity=N         percentage of the objects selected by om_filter (10)
+ *    workers=N             # of workers of om_pscan (4)
+ *    updates=N             # of overwrites and of growths of om_update (10000)
+ *    large_bytes=N         size of a large object; 0 for no om_large (0)
+ *    large_objects=N       # of large objects of om_large (4)
+ *    pax_columns=N         # of columns of a record; 0 for no om_pax (0)
+ *    fixed=N               1 for om_fixed (0)
+ *    truncate=N            1 for om_truncate (0)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "EduOM_common.h"
+#include "BfM.h"
+#include "EduOM.h"
+#include "EduOM_Internal.h"
+#include "EduOM_TestModule.h"
+
+
+
+/*@
+ * Constant Definitions
+ */
+#define BENCH_DEFAULT_OBJECTS       100000
+#define BENCH_DEFAULT_OBJECTSIZE    16
+#define BENCH_DEFAULT_ROUNDS        10
+#define BENCH_DEFAULT_CHURN         50
+#define BENCH_DEFAULT_READAHEAD     8
+#define BENCH_DEFAULT_SELECTIVITY   10
+#define BENCH_DEFAULT_WORKERS       4
+#define BENCH_DEFAULT_UPDATES       10000
+#define BENCH_DEFAULT_LARGEOBJECTS  4
+#define BENCH_PAX_WIDTH             ((Four)sizeof(Four))    /* length of a column of om_pax */
+#define BENCH_LARGE_CHUNK           65536   /* bytes read by a call of om_large */
+#define BENCH_LARGE_WRITES          1000    /* # of overwrites of om_large */
+#define BENCH_OBJECT_OVERHEAD       (sizeof(ObjectHdr) + sizeof(SlottedPageSlot))
+#define BENCH_VOLUME_NAME           "bench.vol"
+#define BENCH_VOLUME_ID             1000
+#define BENCH_EXTENT_SIZE           16
+
+
+/*@
+ * Type Definitions
+ */
+/* the object manager functions under test */
+typedef struct {
+    char        *name;
+    Four        (*createObject)(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*);
+    Four        (*destroyObject)(ObjectID*, ObjectID*, Pool*, DeallocListElem*);
+    Four        (*nextObject)(ObjectID*, ObjectID*, ObjectID*, ObjectHdr*);
+    Four        (*readObject)(ObjectID*, Four, Four, char*);
+} BenchOMImpl;
+
+/* parameters of a run */
+typedef struct {
+    BenchOMImpl *impl;          /* functions under test */
+    Four        nObjects;       /* # of objects kept in the file */
+    Four        objectSize;     /* size of an object */
+    Four        nRounds;        /* # of destroy/create rounds */
+    Four        churn;          /* percentage of the objects replaced in a round */
+    UFour       seed;           /* seed of the random number generator */
+    Four        batchSize;      /* # of objects loaded by a call */
+    Four        readAhead;      /* # of pages read ahead by the scan cursor */
+    Four        selectivity;    /* percentage of the objects selected by the filter */
+    Four        nWorkers;       /* # of workers of the parallel scan */
+    Four        nUpdates;       /* # of overwrites and of growths */
+    Four        largeSize;      /* size of a large object; 0 if none */
+    Four        nLarge;         /* # of large objects */
+    Four        paxColumns;     /* # of columns of a record of om_pax; 0 if none */
+    Boolean     fixed;          /* run om_fixed? */
+    Boolean     truncate;       /* run om_truncate? */
+} BenchConfig;
+
+/* the database under test */
+typedef struct {
+    BenchConfig *config;
+    Four        handle;         /* system handle */
+    Four        volId;          /* volume identifier */
+    XactID      xactId;         /* transaction of the benchmark */
+    FileID      fid;            /* data file */
+    ObjectID    catalogEntry;   /* catalog entry of the data file */
+    ObjectID    *oids;          /* the live objects */
+} BenchDB;
+
+
+/*@ Function Prototypes */
+Four SM_CreateFile(Four, FileID*, Boolean, void*);
+Four sm_GetCatalogEntryFromDataFileId(Four, FileID*, ObjectID*);
+Four OM_CreateObject(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*);
+Four OM_DestroyObject(ObjectID*, ObjectID*, Pool*, DeallocListElem*);
+Four OM_NextObject(ObjectID*, ObjectID*, ObjectID*, ObjectHdr*);
+Four OM_ReadObject(ObjectID*, Four, Four, char*);
+Four BfM_FlushAll(void);
+Four BfM_DiscardAll(void);
+
+static double bench_Now(void);
+static UFour bench_Random(UFour *);
+static Four bench_Open(BenchDB *, BenchConfig *);
+static void bench_Close(BenchDB *);
+static Four bench_CountPages(ObjectID *, Four *);
+static Four bench_FlushPages(ObjectID *, UFour *);
+static Four bench_Load(BenchDB *);
+static Four bench_Scan(BenchDB *);
+static Boolean bench_KeyFilter(ObjectID *, ObjectHdr *, char *, void *);
+static Four bench_Filter(BenchDB *);
+static Four bench_ParallelScan(BenchDB *);
+static Four bench_Churn(BenchDB *);
+static Four bench_Update(BenchDB *);
+static Four bench_Large(BenchDB *);
+static Four bench_Pax(BenchDB *);
+static Four bench_Fixed(BenchDB *);
+static Four bench_Truncate(BenchDB *);
+static Four bench_ParseArgs(BenchConfig *, int, char **);
+
+static BenchOMImpl benchImpls[] = {
+    { "edu",  EduOM_CreateObject, EduOM_DestroyObject, EduOM_NextObject, EduOM_ReadObject },
+    { "base", OM_CreateObject,    OM_DestroyObject,    OM_NextObject,    OM_ReadObject    },
+};
+
+
+
+/*@================================
+ * bench_Now()
+ *================================*/
+/*
+ * Function: static double bench_Now(void)
+ *
+ * Description:
+ *  Return the current time in seconds.
+ */
+static double bench_Now(void)
+{
+    struct timespec     ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return(ts.tv_sec + ts.tv_nsec / 1e9);
+
+}  /* bench_Now() */
+
+
+
+/*@================================
+ * bench_Random()
+ *================================*/
+/*
+ * Function: static UFour bench_Random(UFour *)
+ *
+ * Description:
+ *  Return the next number of a xorshift32 generator.
+ */
+static UFour bench_Random(
+    UFour               *state)                 /* INOUT state of the generator; not 0 */
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+
+    return(*state);
+
+}  /* bench_Random() */
+
+
+
+/*@================================
+ * bench_Open()
+ *================================*/
+/*
+ * Function: static Four bench_Open(BenchDB *, BenchConfig *)
+ *
+ * Description:
+ *  Format and mount the volume of the benchmark and create its data file.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Open(
+    BenchDB             *db,                    /* OUT the database */
+    BenchConfig         *config)                /* IN parameters of the run */
+{
+    Four                e;                      /* for errors */
+    char                *devNames[1];           /* device name */
+    Four                numPagesInDevices[1];   /* # of pages in the device */
+    Four                objectsPerPage;
+
+
+    db->config = config;
+    db->oids = (ObjectID*)malloc(sizeof(ObjectID) * config->nObjects);
+    if (db->oids == NULL) ERR(eMEMORYALLOCERR_EDUOM);
+
+    objectsPerPage = (PAGESIZE - SP_FIXED) / (ALIGNED_LENGTH(config->objectSize) + BENCH_OBJECT_OVERHEAD);
+
+    /* a round may spill objects into new pages, and the pages emptied by a
+       round are not reused before the commit */
+    numPagesInDevices[0] = (config->nObjects / objectsPerPage + 1) * (config->nRounds + 4) + 10 * BENCH_EXTENT_SIZE;
+    /* the grown objects and, for impl=base, the recreated ones */
+    numPagesInDevices[0] += 4 * (config->nUpdates / objectsPerPage + 1);
+    /* the trains of the large objects and their internal nodes, with the
+       trains appended by the benchmark */
+    if (config->largeSize > 0)
+        numPagesInDevices[0] += 2 * config->nLarge * LOT_TRAINSIZE * (LOT_NUM_LEAVES(config->largeSize) + 2)
+                                + BENCH_LARGE_WRITES * LOT_TRAINSIZE;
+    /* the two files of om_pax */
+    if (config->paxColumns > 0)
+        numPagesInDevices[0] += 2 * (config->nObjects / ((PAGESIZE - SP_FIXED) /
+                                     (ALIGNED_LENGTH(DATA_LENGTH_IN_PAGE(config->paxColumns * BENCH_PAX_WIDTH)) + BENCH_OBJECT_OVERHEAD))
+                                     + config->nObjects / PAX_MAX_RECORDS(config->paxColumns, config->paxColumns * BENCH_PAX_WIDTH))
+                                + 4 * BENCH_EXTENT_SIZE;
+    /* the two files of om_fixed */
+    if (config->fixed)
+        numPagesInDevices[0] += 4 * (config->nObjects / objectsPerPage + 1) + 4 * BENCH_EXTENT_SIZE;
+    /* the four loads of om_truncate */
+    if (config->truncate)
+        numPagesInDevices[0] += 4 * (config->nObjects / objectsPerPage + 1) + 2 * BENCH_EXTENT_SIZE;
+    numPagesInDevices[0] -= numPagesInDevices[0] % BENCH_EXTENT_SIZE;
+    devNames[0] = BENCH_VOLUME_NAME;
+    db->volId = BENCH_VOLUME_ID;
+
+    e = LRDS_Init();
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_AllocHandle(&db->handle);
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_FormatDataVolume(1, devNames, "bench", db->volId, BENCH_EXTENT_SIZE, numPagesInDevices, BENCH_EXTENT_SIZE);
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_Mount(1, devNames, &db->volId);
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_BeginTransaction(&db->xactId, X_RR_RR);
+    if (e < eNOERROR) ERR(e);
+
+    e = SM_CreateFile(db->volId, &db->fid, FALSE, NULL);
+    if (e < eNOERROR) ERR(e);
+
+    e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &db->fid, &db->catalogEntry);
+    if (e < eNOERROR) ERR(e);
+
+    return(eNOERROR);
+
+}  /* bench_Open() */
+
+
+
+/*@================================
+ * bench_Close()
+ *================================*/
+/*
+ * Function: static void bench_Close(BenchDB *)
+ *
+ * Description:
+ *  Commit the transaction, dismount the volume and finalize the system.
+ */
+static void bench_Close(
+    BenchDB             *db)                    /* IN the database */
+{
+    LRDS_CommitTransaction(&db->xactId);
+    LRDS_Dismount(db->volId);
+    LRDS_FreeHandle(db->handle);
+    LRDS_Final();
+
+    free(db->oids);
+    unlink(BENCH_VOLUME_NAME);
+
+}  /* bench_Close() */
+
+
+
+/*@================================
+ * bench_CountPages()
+ *================================*/
+/*
+ * Function: static Four bench_CountPages(ObjectID *, Four *)
+ *
+ * Description:
+ *  Count the pages of a data file by following the page list.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_CountPages(
+    ObjectID            *catObjForFile,         /* IN catalog entry of the file */
+    Four                *nPages)                /* OUT # of pages of the file */
+{
+    Four                e;                      /* for errors */
+    PageID              pid;                    /* page of the file */
+    SlottedPage         *apage;                 /* pointer to the buffer of the page */
+    sm_CatOverlayForData *catEntry;             /* catalog entry of the file */
+    ShortPageID         nextPage;               /* next page of the file */
+
+
+    MAKE_PAGEID(pid, catObjForFile->volNo, catObjForFile->pageNo);
+    e = BfM_GetTrain(&pid, (char**)&apage, PAGE_BUF);
+    if (e < eNOERROR) ERR(e);
+    GET_PTR_TO_CATENTRY_FOR_DATA(catObjForFile, apage, catEntry);
+    nextPage = catEntry->firstPage;
+    e = BfM_FreeTrain(&pid, PAGE_BUF);
+    if (e < eNOERROR) ERR(e);
+
+    for (*nPages = 0; nextPage != NIL; (*nPages)++) {
+        pid.pageNo = nextPage;
+        e = BfM_GetTrain(&pid, (char**)&apage, PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+        nextPage = apage->header.nextPage;
+        e = BfM_FreeTrain(&pid, PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+    }
+
+    return(eNOERROR);
+
+}  /* bench_CountPages() */
+
+
+
+/*@================================
+ * bench_FlushPages()
+ *================================*/
+/*
+ * Function: static Four bench_FlushPages(ObjectID *, UFour *)
+ *
+ * Description:
+ *  Overwrite the 'reserved' header word of every page of a data file as the
+ *  buffer manager does when it stores the page checksum, then flush and
+ *  discard all buffers, so that the pages are read again from the volume.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_FlushPages(
+    ObjectID            *catObjForFile,         /* IN catalog entry of the file */
+    UFour               *random)                /* INOUT state of the random number generator */
+{
+    Four                e;                      /* for errors */
+    PageID              pid;                    /* page of the file */
+    SlottedPage         *apage;                 /* pointer to the buffer of the page */
+    sm_CatOverlayForData *catEntry;             /* catalog entry of the file */
+    ShortPageID         nextPage;               /* next page of the file */
+
+
+    MAKE_PAGEID(pid, catObjForFile->volNo, catObjForFile->pageNo);
+    e = BfM_GetTrain(&pid, (char**)&apage, PAGE_BUF);
+    if (e < eNOERROR) ERR(e);
+    GET_PTR_TO_CATENTRY_FOR_DATA(catObjForFile, apage, catEntry);
+    nextPage = catEntry->firstPage;
+    e = BfM_FreeTrain(&pid, PAGE_BUF);
+    if (e < eNOERROR) ERR(e);
+
+    while (nextPage != NIL) {
+        pid.pageNo = nextPage;
+        e = BfM_GetTrain(&pid, (char**)&apage, PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+        ((PageHdr*)apage)->reserved = (Four)bench_Random(random);
+        nextPage = apage->header.nextPage;
+        e = BfM_SetDirty(&pid, PAGE_BUF);
+        if (e < eNOERROR) ERRB1(e, &pid, PAGE_BUF);
+        e = BfM_FreeTrain(&pid, PAGE_BUF);
+        if (e < eNOERROR) ERR(e);
+    }
+
+    e = BfM_FlushAll();
+    if (e < eNOERROR) ERR(e);
+
+    e = BfM_DiscardAll();
+    if (e < eNOERROR) ERR(e);
+
+    return(eNOERROR);
+
+}  /* bench_FlushPages() */
+
+
+
+/*@================================
+ * bench_Load()
+ *================================*/
+/*
+ * Function: static Four bench_Load(BenchDB *)
+ *
+ * Description:
+ *  Create the initial objects and print the load throughput.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Load(
+    BenchDB             *db)                    /* INOUT the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    char                *data;                  /* object data */
+    Four                *lengths;               /* lengths of a batch */
+    void                **datas;                /* data of a batch */
+    Four                key;                    /* key of an object */
+    Four                i, n;
+    double              start, elapsed;
+
+
+    data = (char*)malloc(config->objectSize * config->batchSize);
+    lengths = (Four*)malloc(sizeof(Four) * config->batchSize);
+    datas = (void**)malloc(sizeof(void*) * config->batchSize);
+    if (data == NULL || lengths == NULL || datas == NULL) {
+        free(data); free(lengths); free(datas);
+        ERR(eMEMORYALLOCERR_EDUOM);
+    }
+    memset(data, 'x', config->objectSize * config->batchSize);
+    for (i = 0; i < config->batchSize; i++) {
+        lengths[i] = config->objectSize;
+        datas[i] = data + i * config->objectSize;
+    }
+
+    start = bench_Now();
+
+    for (i = 0; i < config->nObjects; i += n) {
+        /* the key of an object is its load order */
+        if (config->objectSize >= sizeof(Four))
+            for (n = 0; n < config->batchSize; n++) {
+                key = i + n;
+                memcpy(datas[n], &key, sizeof(Four));
+            }
+
+        if (config->batchSize == 1) {
+            n = 1;
+            e = config->impl->createObject(&db->catalogEntry, (i == 0) ? NULL : &db->oids[i-1],
+                                           NULL, config->objectSize, data, &db->oids[i]);
+        }
+        else {
+            n = config->nObjects - i;
+            if (n > config->batchSize) n = config->batchSize;
+            e = EduOM_CreateObjects(&db->catalogEntry, (i == 0) ? NULL : &db->oids[i-1],
+                                    n, NULL, lengths, datas, &db->oids[i]);
+        }
+        if (e < eNOERROR) break;
+    }
+
+    elapsed = bench_Now() - start;
+    free(data); free(lengths); free(datas);
+    if (e < eNOERROR) ERR(e);
+
+    printf("om_load impl=%s objects=%ld object_bytes=%ld batch=%ld seconds=%.3f ops_per_sec=%.0f\n",
+           config->impl->name, (long)config->nObjects, (long)config->objectSize,
+           (long)config->batchSize, elapsed, config->nObjects / elapsed);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Load() */
+
+
+
+/*@================================
+ * bench_Scan()
+ *================================*/
+/*
+ * Function: static Four bench_Scan(BenchDB *)
+ *
+ * Description:
+ *  Scan the file by the NextObject()/ReadObject() loop and by the scan
+ *  cursor, summing the data read, and print the time of each scan.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Scan(
+    BenchDB             *db)                    /* IN the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    char                *buf;                   /* object data read by the loop */
+    char                *data;                  /* object data returned by the cursor */
+    ObjectID            oid;
+    ObjectHdr           objHdr;
+    EduOM_ScanCursor    cursor;
+    Four                i, nLoop, nCursor;      /* # of objects scanned */
+    UFour               sumLoop, sumCursor;     /* sum of the data scanned */
+    double              t, loopTime, cursorTime;
+
+
+    buf = (char*)malloc(config->objectSize);
+    if (buf == NULL) ERR(eMEMORYALLOCERR_EDUOM);
+
+    nLoop = 0; sumLoop = 0;
+    t = bench_Now();
+    e = config->impl->nextObject(&db->catalogEntry, NULL, &oid, &objHdr);
+    while (e == eNOERROR) {
+        e = config->impl->readObject(&oid, 0, REMAINDER, buf);
+        if (e < eNOERROR) break;
+        for (i = 0; i < e; i++) sumLoop += (unsigned char)buf[i];
+        nLoop++;
+        e = config->impl->nextObject(&db->catalogEntry, &oid, &oid, &objHdr);
+    }
+    loopTime = bench_Now() - t;
+    free(buf);
+    if (e < eNOERROR) ERR(e);
+
+    nCursor = 0; sumCursor = 0;
+    t = bench_Now();
+    e = EduOM_OpenScan(&db->catalogEntry, config->readAhead, &cursor);
+    if (e < eNOERROR) ERR(e);
+    while ((e = EduOM_ScanNext(&cursor, &oid, &objHdr, &data)) == eNOERROR) {
+        for (i = 0; i < objHdr.length; i++) sumCursor += (unsigned char)data[i];
+        nCursor++;
+    }
+    if (e < eNOERROR) ERR(e);
+    e = EduOM_CloseScan(&cursor);
+    if (e < eNOERROR) ERR(e);
+    cursorTime = bench_Now() - t;
+
+    if (nLoop != config->nObjects || nCursor != nLoop || sumCursor != sumLoop) {
+        fprintf(stderr, "om_scan: the scans do not agree (%ld, %ld objects)\n", (long)nLoop, (long)nCursor);
+        ERR(eBADPARAMETER_OM);
+    }
+
+    printf("om_scan impl=%s objects=%ld object_bytes=%ld readahead=%ld loop_seconds=%.3f cursor_seconds=%.3f loop_ns_per_obj=%.1f cursor_ns_per_obj=%.1f\n",
+           config->impl->name, (long)config->nObjects, (long)config->objectSize, (long)config->readAhead,
+           loopTime, cursorTime, loopTime * 1e9 / nLoop, cursorTime * 1e9 / nCursor);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Scan() */
+
+
+
+/*@================================
+ * bench_KeyFilter()
+ *================================*/
+/*
+ * Function: static Boolean bench_KeyFilter(ObjectID *, ObjectHdr *, char *, void *)
+ *
+ * Description:
+ *  Scan filter selecting the objects whose key is less than '*arg'.
+ */
+static Boolean bench_KeyFilter(
+    ObjectID            *oid,                   /* IN the object */
+    ObjectHdr           *objHdr,                /* IN its header */
+    char                *data,                  /* IN its data */
+    void                *arg)                   /* IN bound of the key */
+{
+    Four                key;
+
+
+    memcpy(&key, data, sizeof(Four));
+
+    return(key < *(Four*)arg);
+
+}  /* bench_KeyFilter() */
+
+
+
+/*@================================
+ * bench_Filter()
+ *================================*/
+/*
+ * Function: static Four bench_Filter(BenchDB *)
+ *
+ * Description:
+ *  Select 'selectivity' percent of the objects by their key with the
+ *  NextObject()/ReadObject() loop, the scan cursor with a predicate and
+ *  the scan cursor with a filter, and print the time of each scan.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Filter(
+    BenchDB             *db)                    /* IN the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    char                *buf;                   /* object data read by the loop */
+    ObjectID            oid;
+    ObjectHdr           objHdr;
+    EduOM_ScanCursor    cursor;
+    EduOM_ScanPredicate pred;
+    Four                bound;                  /* the objects whose key < bound are selected */
+    Four                key;
+    Four                nLoop, nPred, nFilter;  /* # of objects selected */
+    double              t, loopTime, predTime, filterTime;
+
+
+    if (config->objectSize < sizeof(Four)) return(eNOERROR);
+
+    bound = (Four)((double)config->nObjects * config->selectivity / 100);
+
+    buf = (char*)malloc(config->objectSize);
+    if (buf == NULL) ERR(eMEMORYALLOCERR_EDUOM);
+
+    nLoop = 0;
+    t = bench_Now();
+    e = config->impl->nextObject(&db->catalogEntry, NULL, &oid, &objHdr);
+    while (e == eNOERROR) {
+        e = config->impl->readObject(&oid, 0, REMAINDER, buf);
+        if (e < eNOERROR) break;
+        memcpy(&key, buf, sizeof(Four));
+        if (key < bound) nLoop++;
+        e = config->impl->nextObject(&db->catalogEntry, &oid, &oid, &objHdr);
+    }
+    loopTime = bench_Now() - t;
+    free(buf);
+    if (e < eNOERROR) ERR(e);
+
+    pred.type = SM_INT;
+    pred.op = SM_LT;
+    pred.offset = 0;
+    pred.value.l = bound;
+
+    nPred = 0;
+    t = bench_Now();
+    e = EduOM_OpenScan(&db->catalogEntry, config->readAhead, &cursor);
+    if (e < eNOERROR) ERR(e);
+    e = EduOM_SetScanPredicate(&cursor, &pred);
+    if (e < eNOERROR) ERR(e);
+    while ((e = EduOM_ScanNext(&cursor, &oid, NULL, NULL)) == eNOERROR) nPred++;
+    if (e < eNOERROR) ERR(e);
+    e = EduOM_CloseScan(&cursor);
+    if (e < eNOERROR) ERR(e);
+    predTime = bench_Now() - t;
+
+    nFilter = 0;
+    t = bench_Now();
+    e = EduOM_OpenScan(&db->catalogEntry, config->readAhead, &cursor);
+    if (e < eNOERROR) ERR(e);
+    e = EduOM_SetScanFilter(&cursor, bench_KeyFilter, &bound);
+    if (e < eNOERROR) ERR(e);
+    while ((e = EduOM_ScanNext(&cursor, &oid, NULL, NULL)) == eNOERROR) nFilter++;
+    if (e < eNOERROR) ERR(e);
+    e = EduOM_CloseScan(&cursor);
+    if (e < eNOERROR) ERR(e);
+    filterTime = bench_Now() - t;
+
+    if (nLoop != bound || nPred != nLoop || nFilter != nLoop) {
+        fprintf(stderr, "om_filter: the scans do not agree (%ld, %ld, %ld objects)\n",
+                (long)nLoop, (long)nPred, (long)nFilter);
+        ERR(eBADPARAMETER_OM);
+    }
+
+    printf("om_filter impl=%s objects=%ld object_bytes=%ld selectivity_percent=%ld selected=%ld loop_seconds=%.3f predicate_seconds=%.3f filter_seconds=%.3f\n",
+           config->impl->name, (long)config->nObjects, (long)config->objectSize, (long)config->selectivity,
+           (long)nLoop, loopTime, predTime, filterTime);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Filter() */
+
+
+
+/*@================================
+ * bench_ParallelScan()
+ *================================*/
+/*
+ * Function: static Four bench_ParallelScan(BenchDB *)
+ *
+ * Description:
+ *  Select 'selectivity' percent of the objects by their key with the scan
+ *  cursor and with EduOM_ParallelScan(), check that both return the same
+ *  objects in the same order and print the time of each scan.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_ParallelScan(
+    BenchDB             *db)                    /* IN the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    ObjectID            *seqOids, *parOids;     /* objects selected by each scan */
+    EduOM_ScanCursor    cursor;
+    EduOM_ScanPredicate pred;
+    Four                nSeq, nPar;             /* # of objects selected */
+    double              t, seqTime, parTime;
+
+
+    if (config->objectSize < sizeof(Four)) return(eNOERROR);
+
+    seqOids = (ObjectID*)malloc(sizeof(ObjectID) * config->nObjects);
+    parOids = (ObjectID*)malloc(sizeof(ObjectID) * config->nObjects);
+    if (seqOids == NULL || parOids == NULL) {
+        free(seqOids); free(parOids);
+        ERR(eMEMORYALLOCERR_EDUOM);
+    }
+
+    pred.type = SM_INT;
+    pred.op = SM_LT;
+    pred.offset = 0;
+    pred.value.l = (Four)((double)config->nObjects * config->selectivity / 100);
+
+    nSeq = 0;
+    t = bench_Now();
+    e = EduOM_OpenScan(&db->catalogEntry, config->readAhead, &cursor);
+    if (e >= eNOERROR) e = EduOM_SetScanPredicate(&cursor, &pred);
+    if (e >= eNOERROR) {
+        while ((e = EduOM_ScanNext(&cursor, &seqOids[nSeq], NULL, NULL)) == eNOERROR) nSeq++;
+        if (e >= eNOERROR) e = EduOM_CloseScan(&cursor);
+    }
+    seqTime = bench_Now() - t;
+
+    if (e >= eNOERROR) {
+        t = bench_Now();
+        e = EduOM_ParallelScan(&db->catalogEntry, config->nWorkers, &pred, NULL, NULL,
+                               config->nObjects, parOids, &nPar);
+        parTime = bench_Now() - t;
+    }
+
+    if (e >= eNOERROR && (nPar != nSeq || memcmp(seqOids, parOids, sizeof(ObjectID) * nSeq) != 0)) {
+        fprintf(stderr, "om_pscan: the scans do not agree (%ld, %ld objects)\n", (long)nSeq, (long)nPar);
+        e = eBADPARAMETER_OM;
+    }
+    free(seqOids); free(parOids);
+    if (e < eNOERROR) ERR(e);
+
+    printf("om_pscan impl=%s objects=%ld object_bytes=%ld selectivity_percent=%ld workers=%ld selected=%ld cursor_seconds=%.3f parallel_seconds=%.3f\n",
+           config->impl->name, (long)config->nObjects, (long)config->objectSize, (long)config->selectivity,
+           (long)config->nWorkers, (long)nSeq, seqTime, parTime);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_ParallelScan() */
+
+
+
+/*@================================
+ * bench_Churn()
+ *================================*/
+/*
+ * Function: static Four bench_Churn(BenchDB *)
+ *
+ * Description:
+ *  Run the destroy/create rounds and print their throughput and the
+ *  average latency of each operation type.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Churn(
+    BenchDB             *db)                    /* INOUT the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    char                *data;                  /* object data */
+    Four                nReplaced;              /* # of objects replaced in a round */
+    Four                round, i, j;
+    Four                nPages;                 /* # of pages of the file after the rounds */
+    Four                nFound;                 /* # of objects of the file after the rounds */
+    ObjectID            oid;
+    ObjectHdr           objHdr;
+    UFour               random;                 /* state of the random number generator */
+    double              start, t, destroyTime, createTime;
+
+
+    data = (char*)malloc(config->objectSize);
+    if (data == NULL) ERR(eMEMORYALLOCERR_EDUOM);
+    memset(data, 'y', config->objectSize);
+
+    nReplaced = (Four)((double)config->nObjects * config->churn / 100);
+    if (nReplaced >= config->nObjects) nReplaced = config->nObjects - 1;
+    random = (config->seed << 1) | 1;
+    destroyTime = createTime = 0.0;
+
+    start = bench_Now();
+
+    for (round = 0; round < config->nRounds; round++) {
+        t = bench_Now();
+        e = bench_FlushPages(&db->catalogEntry, &random);
+        if (e < eNOERROR) { free(data); ERR(e); }
+        start += bench_Now() - t;
+
+        /* move the victims of the round to the end of the array */
+        for (i = config->nObjects - 1; i >= config->nObjects - nReplaced; i--) {
+            j = bench_Random(&random) % (i + 1);
+            oid = db->oids[i]; db->oids[i] = db->oids[j]; db->oids[j] = oid;
+        }
+
+        t = bench_Now();
+        for (i = config->nObjects - nReplaced; i < config->nObjects; i++) {
+            e = config->impl->destroyObject(&db->catalogEntry, &db->oids[i], &dlPool, &dlHead);
+            if (e < eNOERROR) { free(data); ERR(e); }
+        }
+        destroyTime += bench_Now() - t;
+
+        /* the new objects go to the pages on the available space lists */
+        t = bench_Now();
+        for (i = config->nObjects - nReplaced; i < config->nObjects; i++) {
+            e = config->impl->createObject(&db->catalogEntry, NULL, NULL,
+                                           config->objectSize, data, &db->oids[i]);
+            if (e < eNOERROR) { free(data); ERR(e); }
+        }
+        createTime += bench_Now() - t;
+    }
+
+    t = bench_Now() - start;
+    free(data);
+
+    e = bench_CountPages(&db->catalogEntry, &nPages);
+    if (e < eNOERROR) ERR(e);
+
+    nFound = 0;
+    e = config->impl->nextObject(&db->catalogEntry, NULL, &oid, &objHdr);
+    while (e == eNOERROR) {
+        nFound++;
+        e = config->impl->nextObject(&db->catalogEntry, &oid, &oid, &objHdr);
+    }
+    if (e < eNOERROR) ERR(e);
+
+    if (nFound != config->nObjects) {
+        fprintf(stderr, "om_churn: %ld objects are found instead of %ld\n", (long)nFound, (long)config->nObjects);
+        ERR(eBADPARAMETER_OM);
+    }
+
+    printf("om_churn impl=%s objects=%ld object_bytes=%ld rounds=%ld churn_percent=%ld seconds=%.3f ops_per_sec=%.0f destroy_avg_us=%.2f create_avg_us=%.2f file_pages=%ld\n",
+           config->impl->name, (long)config->nObjects, (long)config->objectSize,
+           (long)config->nRounds, (long)config->churn, t,
+           2.0 * nReplaced * config->nRounds / t,
+           destroyTime * 1e6 / ((double)nReplaced * config->nRounds),
+           createTime * 1e6 / ((double)nReplaced * config->nRounds), (long)nPages);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Churn() */
+
+
+
+/*@================================
+ * bench_Update()
+ *================================*/
+/*
+ * Function: static Four bench_Update(BenchDB *)
+ *
+ * Description:
+ *  Overwrite 'updates' random objects, then grow 'updates' random objects
+ *  by 'object_bytes' bytes and read every object back. For impl=edu the
+ *  objects are overwritten in place and grown by appending, so that they
+ *  keep their ObjectIDs; for impl=base, which has no update operation, an
+ *  object is destroyed and recreated with the new data. Print the average
+ *  latency of each operation type and the read time per object.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Update(
+    BenchDB             *db)                    /* INOUT the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    char                *data;                  /* object data */
+    Four                *lengths;               /* lengths of the objects */
+    Four                i, k, nGrown;
+    Boolean             inPlace;                /* update without changing the ObjectIDs? */
+    UFour               random;                 /* state of the random number generator */
+    double              t, writeTime, growTime, readTime;
+
+
+    if (config->nUpdates == 0) return(eNOERROR);
+
+    data = (char*)malloc(LRGOBJ_THRESHOLD + config->objectSize);
+    lengths = (Four*)malloc(sizeof(Four) * config->nObjects);
+    if (data == NULL || lengths == NULL) {
+        free(data); free(lengths);
+        ERR(eMEMORYALLOCERR_EDUOM);
+    }
+    memset(data, 'z', LRGOBJ_THRESHOLD + config->objectSize);
+    for (i = 0; i < config->nObjects; i++) lengths[i] = config->objectSize;
+
+    inPlace = (config->impl == &benchImpls[0]);
+    random = (config->seed << 1) | 1;
+    e = eNOERROR;
+
+    t = bench_Now();
+    for (i = 0; i < config->nUpdates && e >= eNOERROR; i++) {
+        k = bench_Random(&random) % config->nObjects;
+        if (inPlace)
+            e = EduOM_WriteObject(&db->oids[k], 0, lengths[k], data);
+        else {
+            e = config->impl->destroyObject(&db->catalogEntry, &db->oids[k], &dlPool, &dlHead);
+            if (e >= eNOERROR)
+                e = config->impl->createObject(&db->catalogEntry, NULL, NULL, lengths[k], data, &db->oids[k]);
+        }
+    }
+    writeTime = bench_Now() - t;
+
+    /* an object is not grown beyond a small object */
+    nGrown = 0;
+    t = bench_Now();
+    for (i = 0; i < config->nUpdates && e >= eNOERROR; i++) {
+        k = bench_Random(&random) % config->nObjects;
+        if (ALIGNED_LENGTH(lengths[k] + config->objectSize) > LRGOBJ_THRESHOLD) continue;
+
+        if (inPlace)
+            e = EduOM_AppendToObject(&db->catalogEntry, &db->oids[k], config->objectSize, data, &dlPool, &dlHead);
+        else {
+            e = config->impl->readObject(&db->oids[k], 0, lengths[k], data);
+            if (e >= eNOERROR)
+                e = config->impl->destroyObject(&db->catalogEntry, &db->oids[k], &dlPool, &dlHead);
+            if (e >= eNOERROR)
+                e = config->impl->createObject(&db->catalogEntry, NULL, NULL,
+                                               lengths[k] + config->objectSize, data, &db->oids[k]);
+        }
+        lengths[k] += config->objectSize;
+        nGrown++;
+    }
+    growTime = bench_Now() - t;
+
+    t = bench_Now();
+    for (k = 0; k < config->nObjects && e >= eNOERROR; k++) {
+        e = config->impl->readObject(&db->oids[k], 0, REMAINDER, data);
+        if (e >= eNOERROR && e != lengths[k]) {
+            fprintf(stderr, "om_update: object %ld has %ld bytes instead of %ld\n", (long)k, (long)e, (long)lengths[k]);
+            e = eBADPARAMETER_OM;
+        }
+    }
+    readTime = bench_Now() - t;
+
+    free(data); free(lengths);
+    if (e < eNOERROR) ERR(e);
+
+    printf("om_update impl=%s objects=%ld object_bytes=%ld updates=%ld grown=%ld write_avg_us=%.2f grow_avg_us=%.2f read_ns_per_object=%.1f\n",
+           config->impl->name, (long)config->nObjects, (long)config->objectSize, (long)config->nUpdates, (long)nGrown,
+           writeTime * 1e6 / config->nUpdates, growTime * 1e6 / MAX(nGrown, 1),
+           readTime * 1e9 / config->nObjects);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Update() */
+
+
+
+/*@================================
+ * bench_Large()
+ *================================*/
+/*
+ * Function: static Four bench_Large(BenchDB *)
+ *
+ * Description:
+ *  Create the large objects, read each of them back in chunks of
+ *  BENCH_LARGE_CHUNK bytes and check the data read. With 'batch' greater
+ *  than 1, the large objects are created by a single EduOM_CreateObjects()
+ *  call, each after a small object of 'object_bytes' bytes which is
+ *  checked too. For impl=edu, overwrite
+ *  'object_bytes' bytes at random positions and append 'object_bytes'
+ *  bytes to the objects, then print the throughput and latencies.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Large(
+    BenchDB             *db)                    /* IN the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    char                *data;                  /* data of a large object */
+    char                *buf;                   /* chunk read */
+    ObjectID            *oids;                  /* the large objects */
+    ObjectID            *batchOids;             /* the objects of the mixed batch */
+    Four                *lengths;               /* lengths of the objects of the mixed batch */
+    void                **datas;                /* data of the objects of the mixed batch */
+    Four                i, n, start;
+    UFour               random;                 /* state of the random number generator */
+    double              t, createTime, readTime, writeTime, appendTime;
+
+
+    if (config->largeSize == 0) return(eNOERROR);
+
+    data = (char*)malloc(config->largeSize);
+    buf = (char*)malloc(BENCH_LARGE_CHUNK);
+    oids = (ObjectID*)malloc(sizeof(ObjectID) * config->nLarge);
+    batchOids = (ObjectID*)malloc(sizeof(ObjectID) * 2 * config->nLarge);
+    lengths = (Four*)malloc(sizeof(Four) * 2 * config->nLarge);
+    datas = (void**)malloc(sizeof(void*) * 2 * config->nLarge);
+    if (data == NULL || buf == NULL || oids == NULL || batchOids == NULL || lengths == NULL || datas == NULL) {
+        free(data); free(buf); free(oids); free(batchOids); free(lengths); free(datas);
+        ERR(eMEMORYALLOCERR_EDUOM);
+    }
+
+    random = (config->seed << 1) | 1;
+    for (i = 0; i < config->largeSize; i++) data[i] = (char)bench_Random(&random);
+    writeTime = appendTime = 0.0;
+
+    t = bench_Now();
+    if (config->batchSize > 1) {
+        /* a small object and a large one in turn */
+        for (i = 0; i < 2 * config->nLarge; i++) {
+            lengths[i] = (i % 2 == 0) ? config->objectSize : config->largeSize;
+            datas[i] = data;
+        }
+        e = EduOM_CreateObjects(&db->catalogEntry, NULL, 2 * config->nLarge, NULL, lengths, datas, batchOids);
+        for (i = 0; i < config->nLarge; i++) oids[i] = batchOids[2 * i + 1];
+    }
+    else {
+        for (i = 0, e = eNOERROR; i < config->nLarge && e >= eNOERROR; i++)
+            e = config->impl->createObject(&db->catalogEntry, NULL, NULL, config->largeSize, data, &oids[i]);
+    }
+    createTime = bench_Now() - t;
+
+    /* the small objects of the mixed batch */
+    for (i = 0; config->batchSize > 1 && i < config->nLarge && e >= eNOERROR; i++) {
+        e = EduOM_ReadObject(&batchOids[2 * i], 0, REMAINDER, buf);
+        if (e >= eNOERROR && (e != config->objectSize || memcmp(buf, data, config->objectSize) != 0)) {
+            fprintf(stderr, "om_large: small object %ld of the batch differs\n", (long)i);
+            e = eBADPARAMETER_OM;
+        }
+    }
+
+    t = bench_Now();
+    for (i = 0; i < config->nLarge && e >= eNOERROR; i++) {
+        for (start = 0; start < config->largeSize && e >= eNOERROR; start += n) {
+            n = MIN(BENCH_LARGE_CHUNK, config->largeSize - start);
+            e = config->impl->readObject(&oids[i], start, n, buf);
+            if (e >= eNOERROR && memcmp(buf, data + start, n) != 0) {
+                fprintf(stderr, "om_large: object %ld differs at %ld\n", (long)i, (long)start);
+                e = eBADPARAMETER_OM;
+            }
+        }
+    }
+    readTime = bench_Now() - t;
+
+    if (config->impl == &benchImpls[0]) {
+        n = MIN(config->objectSize, config->largeSize);
+
+        t = bench_Now();
+        for (i = 0; i < BENCH_LARGE_WRITES && e >= eNOERROR; i++) {
+            start = bench_Random(&random) % (config->largeSize - n + 1);
+            e = EduOM_WriteObject(&oids[i % config->nLarge], start, n, data);
+        }
+        writeTime = bench_Now() - t;
+
+        t = bench_Now();
+        for (i = 0; i < BENCH_LARGE_WRITES && e >= eNOERROR; i++)
+            e = EduOM_AppendToObject(&db->catalogEntry, &oids[i % config->nLarge], n, data, &dlPool, &dlHead);
+        appendTime = bench_Now() - t;
+    }
+
+    free(data); free(buf); free(oids); free(batchOids); free(lengths); free(datas);
+    if (e < eNOERROR) ERR(e);
+
+    printf("om_large impl=%s large_objects=%ld large_bytes=%ld create_mb_per_sec=%.1f read_mb_per_sec=%.1f",
+           config->impl->name, (long)config->nLarge, (long)config->largeSize,
+           (double)config->nLarge * config->largeSize / createTime / 1e6,
+           (double)config->nLarge * config->largeSize / readTime / 1e6);
+    if (config->impl == &benchImpls[0])
+        printf(" write_bytes=%ld write_avg_us=%.2f append_avg_us=%.2f",
+               (long)MIN(config->objectSize, config->largeSize),
+               writeTime * 1e6 / BENCH_LARGE_WRITES, appendTime * 1e6 / BENCH_LARGE_WRITES);
+    printf("\n");
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Large() */
+
+
+
+/*@================================
+ * bench_Pax()
+ *================================*/
+/*
+ * Function: static Four bench_Pax(BenchDB *)
+ *
+ * Description:
+ *  Load the records into a new file of slotted pages, as objects, and into
+ *  a new file of PAX pages; sum the first column of the records by the scan
+ *  cursor and by the PAX projection scan, check that the sums and the
+ *  records read back agree, and print the # of pages and the times.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Pax(
+    BenchDB             *db)                    /* IN the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    Four                recordLength;           /* length of a record */
+    Four                *records;               /* the records, column after column */
+    ObjectID            *rowOids, *paxOids;     /* the records in each file */
+    FileID              rowFid, paxFid;         /* the files */
+    ObjectID            rowCatalog, paxCatalog; /* catalog entries of the files */
+    EduOM_ScanCursor    cursor;
+    EduOM_PaxCursor     paxCursor;
+    ObjectID            oid;
+    ObjectHdr           objHdr;
+    char                *data;                  /* object data returned by the cursor */
+    char                *buf;                   /* record read back */
+    char                *values[1];             /* minipage of the first column */
+    Two                 widths[PAX_MAX_COLUMNS];
+    Two                 column;
+    Four                rowPages, paxPages;
+    Four                i, n, nRow, nPax;
+    double              rowSum, paxSum;         /* sums of the first column */
+    double              t, rowLoadTime, paxLoadTime, rowScanTime, paxScanTime;
+
+
+    if (config->paxColumns == 0) return(eNOERROR);
+
+    recordLength = config->paxColumns * BENCH_PAX_WIDTH;
+    records = (Four*)malloc(recordLength * config->nObjects);
+    rowOids = (ObjectID*)malloc(sizeof(ObjectID) * config->nObjects);
+    paxOids = (ObjectID*)malloc(sizeof(ObjectID) * config->nObjects);
+    buf = (char*)malloc(recordLength);
+    if (records == NULL || rowOids == NULL || paxOids == NULL || buf == NULL) {
+        free(records); free(rowOids); free(paxOids); free(buf);
+        ERR(eMEMORYALLOCERR_EDUOM);
+    }
+
+    for (i = 0; i < config->nObjects * config->paxColumns; i++) records[i] = i;
+    for (i = 0; i < config->paxColumns; i++) widths[i] = BENCH_PAX_WIDTH;
+
+    e = SM_CreateFile(db->volId, &rowFid, FALSE, NULL);
+    if (e >= eNOERROR) e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &rowFid, &rowCatalog);
+    if (e >= eNOERROR) e = SM_CreateFile(db->volId, &paxFid, FALSE, NULL);
+    if (e >= eNOERROR) e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &paxFid, &paxCatalog);
+
+    t = bench_Now();
+    for (i = 0; i < config->nObjects && e >= eNOERROR; i++)
+        e = config->impl->createObject(&rowCatalog, NULL, NULL, recordLength,
+                                       (char*)&records[i * config->paxColumns], &rowOids[i]);
+    rowLoadTime = bench_Now() - t;
+
+    t = bench_Now();
+    if (e >= eNOERROR)
+        e = EduOM_CreatePaxObjects(&paxCatalog, config->paxColumns, widths, config->nObjects, records, paxOids);
+    paxLoadTime = bench_Now() - t;
+
+    nRow = 0; rowSum = 0;
+    t = bench_Now();
+    if (e >= eNOERROR) e = EduOM_OpenScan(&rowCatalog, config->readAhead, &cursor);
+    if (e >= eNOERROR) {
+        while ((e = EduOM_ScanNext(&cursor, &oid, &objHdr, &data)) == eNOERROR) {
+            rowSum += *(Four*)data;
+            nRow++;
+        }
+        if (e == EOS) e = EduOM_CloseScan(&cursor);
+    }
+    rowScanTime = bench_Now() - t;
+
+    nPax = 0; paxSum = 0;
+    column = 0;
+    t = bench_Now();
+    if (e >= eNOERROR) e = EduOM_PaxOpenScan(&paxCatalog, 1, &column, &paxCursor);
+    if (e >= eNOERROR) {
+        while ((e = EduOM_PaxScanNext(&paxCursor, &oid, &n, values)) == eNOERROR) {
+            for (i = 0; i < n; i++) paxSum += ((Four*)values[0])[i];
+            nPax += n;
+        }
+        if (e == EOS) e = EduOM_PaxCloseScan(&paxCursor);
+    }
+    paxScanTime = bench_Now() - t;
+
+    if (e >= eNOERROR && (nRow != config->nObjects || nPax != nRow || paxSum != rowSum)) {
+        fprintf(stderr, "om_pax: the scans do not agree (%ld, %ld records)\n", (long)nRow, (long)nPax);
+        e = eBADPARAMETER_OM;
+    }
+
+    /* a record read back from the PAX pages is the record loaded */
+    for (i = 0; i < config->nObjects && e >= eNOERROR; i += config->nObjects / 100 + 1) {
+        e = EduOM_ReadObject(&paxOids[i], 0, REMAINDER, buf);
+        if (e >= eNOERROR && (e != recordLength || memcmp(buf, &records[i * config->paxColumns], recordLength) != 0)) {
+            fprintf(stderr, "om_pax: record %ld differs\n", (long)i);
+            e = eBADPARAMETER_OM;
+        }
+    }
+
+    if (e >= eNOERROR) e = bench_CountPages(&rowCatalog, &rowPages);
+    if (e >= eNOERROR) e = bench_CountPages(&paxCatalog, &paxPages);
+
+    free(records); free(rowOids); free(paxOids); free(buf);
+    if (e < eNOERROR) ERR(e);
+
+    printf("om_pax impl=%s objects=%ld pax_columns=%ld row_pages=%ld pax_pages=%ld row_load_seconds=%.3f pax_load_seconds=%.3f row_scan_ns_per_obj=%.1f pax_scan_ns_per_obj=%.1f\n",
+           config->impl->name, (long)config->nObjects, (long)config->paxColumns, (long)rowPages, (long)paxPages,
+           rowLoadTime, paxLoadTime, rowScanTime * 1e9 / nRow, paxScanTime * 1e9 / nPax);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Pax() */
+
+
+
+/*@================================
+ * bench_Fixed()
+ *================================*/
+/*
+ * Function: static Four bench_Fixed(BenchDB *)
+ *
+ * Description:
+ *  Load the records into a new file of slotted pages, as objects, and into
+ *  a new file of fixed-length record pages; scan both files by the scan
+ *  cursor and check that the sums of the keys agree. Then destroy every
+ *  other record of both files and create as many again near the records
+ *  kept, check the records read back and that the ObjectID of a destroyed
+ *  record is rejected, and print the # of pages and the times.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Fixed(
+    BenchDB             *db)                    /* IN the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    char                *record;                /* record loaded */
+    char                *buf;                   /* record read back */
+    ObjectID            *rowOids, *fixedOids;   /* the records in each file */
+    FileID              rowFid, fixedFid;       /* the files */
+    ObjectID            rowCatalog, fixedCatalog; /* catalog entries of the files */
+    EduOM_ScanCursor    cursor;
+    ObjectID            oid;
+    ObjectID            staleOid;               /* a record destroyed */
+    ObjectHdr           objHdr;
+    char                *data;                  /* object data returned by the cursor */
+    Four                key;
+    Four                rowPages, fixedPages, rowRefillPages, fixedRefillPages;
+    Four                i, nRow, nFixed;
+    double              rowSum, fixedSum;       /* sums of the keys */
+    double              t, rowLoadTime, fixedLoadTime, rowScanTime, fixedScanTime;
+
+
+    if (!config->fixed) return(eNOERROR);
+
+    record = (char*)malloc(config->objectSize);
+    buf = (char*)malloc(config->objectSize);
+    rowOids = (ObjectID*)malloc(sizeof(ObjectID) * config->nObjects);
+    fixedOids = (ObjectID*)malloc(sizeof(ObjectID) * config->nObjects);
+    if (record == NULL || buf == NULL || rowOids == NULL || fixedOids == NULL) {
+        free(record); free(buf); free(rowOids); free(fixedOids);
+        ERR(eMEMORYALLOCERR_EDUOM);
+    }
+    memset(record, 'f', config->objectSize);
+
+    e = SM_CreateFile(db->volId, &rowFid, FALSE, NULL);
+    if (e >= eNOERROR) e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &rowFid, &rowCatalog);
+    if (e >= eNOERROR) e = SM_CreateFile(db->volId, &fixedFid, FALSE, NULL);
+    if (e >= eNOERROR) e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fixedFid, &fixedCatalog);
+
+    t = bench_Now();
+    for (i = 0; i < config->nObjects && e >= eNOERROR; i++) {
+        key = i;
+        memcpy(record, &key, sizeof(Four));
+        e = config->impl->createObject(&rowCatalog, NULL, NULL, config->objectSize, record, &rowOids[i]);
+    }
+    rowLoadTime = bench_Now() - t;
+
+    t = bench_Now();
+    for (i = 0; i < config->nObjects && e >= eNOERROR; i++) {
+        key = i;
+        memcpy(record, &key, sizeof(Four));
+        e = EduOM_CreateFixedObject(&fixedCatalog, NULL, config->objectSize, record, &fixedOids[i]);
+    }
+    fixedLoadTime = bench_Now() - t;
+
+    nRow = 0; rowSum = 0;
+    t = bench_Now();
+    if (e >= eNOERROR) e = EduOM_OpenScan(&rowCatalog, config->readAhead, &cursor);
+    if (e >= eNOERROR) {
+        while ((e = EduOM_ScanNext(&cursor, &oid, &objHdr, &data)) == eNOERROR) {
+            memcpy(&key, data, sizeof(Four));
+            rowSum += key;
+            nRow++;
+        }
+        if (e == EOS) e = EduOM_CloseScan(&cursor);
+    }
+    rowScanTime = bench_Now() - t;
+
+    nFixed = 0; fixedSum = 0;
+    t = bench_Now();
+    if (e >= eNOERROR) e = EduOM_OpenScan(&fixedCatalog, config->readAhead, &cursor);
+    if (e >= eNOERROR) {
+        while ((e = EduOM_ScanNext(&cursor, &oid, &objHdr, &data)) == eNOERROR) {
+            memcpy(&key, data, sizeof(Four));
+            fixedSum += key;
+            nFixed++;
+        }
+        if (e == EOS) e = EduOM_CloseScan(&cursor);
+    }
+    fixedScanTime = bench_Now() - t;
+
+    if (e >= eNOERROR && (nRow != config->nObjects || nFixed != nRow || fixedSum != rowSum)) {
+        fprintf(stderr, "om_fixed: the scans do not agree (%ld, %ld records)\n", (long)nRow, (long)nFixed);
+        e = eBADPARAMETER_OM;
+    }
+
+    if (e >= eNOERROR) e = bench_CountPages(&rowCatalog, &rowPages);
+    if (e >= eNOERROR) e = bench_CountPages(&fixedCatalog, &fixedPages);
+
+    /* every other record is replaced by a record created near the previous one */
+    if (config->nObjects > 1) staleOid = fixedOids[1];
+    for (i = 1; i < config->nObjects && e >= eNOERROR; i += 2) {
+        e = config->impl->destroyObject(&rowCatalog, &rowOids[i], &dlPool, &dlHead);
+        if (e >= eNOERROR) e = EduOM_DestroyObject(&fixedCatalog, &fixedOids[i], &dlPool, &dlHead);
+    }
+    for (i = 1; i < config->nObjects && e >= eNOERROR; i += 2) {
+        key = i;
+        memcpy(record, &key, sizeof(Four));
+        e = config->impl->createObject(&rowCatalog, &rowOids[i-1], NULL, config->objectSize, record, &rowOids[i]);
+        if (e >= eNOERROR) e = EduOM_CreateFixedObject(&fixedCatalog, &fixedOids[i-1], config->objectSize, record, &fixedOids[i]);
+    }
+
+    /* the record put in the place of a destroyed one is not reached by its ObjectID */
+    if (e >= eNOERROR && config->nObjects > 1 &&
+        (EduOM_ReadObject(&staleOid, 0, REMAINDER, buf) != eBADOBJECTID_OM ||
+         EduOM_WriteObject(&staleOid, 0, config->objectSize, record) != eBADOBJECTID_OM ||
+         EduOM_DestroyObject(&fixedCatalog, &staleOid, &dlPool, &dlHead) != eBADOBJECTID_OM)) {
+        fprintf(stderr, "om_fixed: the ObjectID of a destroyed record is accepted\n");
+        e = eBADPARAMETER_OM;
+    }
+
+    /* a record read back from the fixed-length record pages is the record loaded */
+    for (i = 0; i < config->nObjects && e >= eNOERROR; i += config->nObjects / 100 + 1) {
+        key = i;
+        memcpy(record, &key, sizeof(Four));
+        e = EduOM_ReadObject(&fixedOids[i], 0, REMAINDER, buf);
+        if (e >= eNOERROR && (e != config->objectSize || memcmp(buf, record, config->objectSize) != 0)) {
+            fprintf(stderr, "om_fixed: record %ld differs\n", (long)i);
+            e = eBADPARAMETER_OM;
+        }
+    }
+
+    if (e >= eNOERROR) e = bench_CountPages(&rowCatalog, &rowRefillPages);
+    if (e >= eNOERROR) e = bench_CountPages(&fixedCatalog, &fixedRefillPages);
+
+    free(record); free(buf); free(rowOids); free(fixedOids);
+    if (e < eNOERROR) ERR(e);
+
+    printf("om_fixed impl=%s objects=%ld object_bytes=%ld row_pages=%ld fixed_pages=%ld row_load_seconds=%.3f fixed_load_seconds=%.3f row_scan_ns_per_obj=%.1f fixed_scan_ns_per_obj=%.1f row_refill_pages=%ld fixed_refill_pages=%ld\n",
+           config->impl->name, (long)config->nObjects, (long)config->objectSize, (long)rowPages, (long)fixedPages,
+           rowLoadTime, fixedLoadTime, rowScanTime * 1e9 / nRow, fixedScanTime * 1e9 / nFixed,
+           (long)rowRefillPages, (long)fixedRefillPages);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Fixed() */
+
+
+/*@================================
+ * bench_Truncate()
+ *================================*/
+/*
+ * Function: static Four bench_Truncate(BenchDB *)
+ *
+ * Description:
+ *  Load the objects into a new file and destroy them one by one; load them
+ *  again and destroy them by a single EduOM_DestroyObjects() call; load
+ *  them again and truncate the file. After each, check that the file is
+ *  empty, then load the objects once more, check that the scan returns all
+ *  of them, and print the times.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Truncate(
+    BenchDB             *db)                    /* IN the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    char                *record;                /* object loaded */
+    ObjectID            *oids;                  /* the objects in the file */
+    FileID              fid;                    /* the file */
+    ObjectID            catalog;                /* catalog entry of the file */
+    ObjectID            oid;
+    Four                key;
+    Four                i, round, n;
+    double              t, times[3];            /* destroy, destroy in bulk, truncate */
+
+
+    if (!config->truncate) return(eNOERROR);
+
+    record = (char*)malloc(config->objectSize);
+    oids = (ObjectID*)malloc(sizeof(ObjectID) * config->nObjects);
+    if (record == NULL || oids == NULL) {
+        free(record); free(oids);
+        ERR(eMEMORYALLOCERR_EDUOM);
+    }
+    memset(record, 't', config->objectSize);
+
+    e = SM_CreateFile(db->volId, &fid, FALSE, NULL);
+    if (e >= eNOERROR) e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fid, &catalog);
+
+    for (round = 0; round < 4 && e >= eNOERROR; round++) {
+        for (i = 0; i < config->nObjects && e >= eNOERROR; i++) {
+            key = i;
+            memcpy(record, &key, MIN(sizeof(Four), config->objectSize));
+            e = EduOM_CreateObject(&catalog, NULL, NULL, config->objectSize, record, &oids[i]);
+        }
+        if (round == 3 || e < eNOERROR) break;
+
+        t = bench_Now();
+        if (round == 0) {
+            for (i = 0; i < config->nObjects && e >= eNOERROR; i++)
+                e = EduOM_DestroyObject(&catalog, &oids[i], &dlPool, &dlHead);
+        }
+        else if (round == 1)
+            e = EduOM_DestroyObjects(&catalog, config->nObjects, oids, &dlPool, &dlHead);
+        else
+            e = EduOM_TruncateFile(&catalog, &dlPool, &dlHead);
+        times[round] = bench_Now() - t;
+
+        if (e >= eNOERROR) {
+            e = EduOM_NextObject(&catalog, NULL, &oid, NULL);
+            if (e == EOS) e = eNOERROR;
+            else if (e >= eNOERROR) {
+                fprintf(stderr, "om_truncate: the file is not empty after round %ld\n", (long)round);
+                e = eBADPARAMETER_OM;
+            }
+        }
+    }
+
+    /* the file truncated takes the objects again */
+    n = 0;
+    if (e >= eNOERROR) {
+        e = EduOM_NextObject(&catalog, NULL, &oid, NULL);
+        while (e == eNOERROR) {
+            n++;
+            e = EduOM_NextObject(&catalog, &oid, &oid, NULL);
+        }
+        if (e == EOS) e = eNOERROR;
+    }
+    if (e >= eNOERROR && n != config->nObjects) {
+        fprintf(stderr, "om_truncate: %ld objects are found instead of %ld\n", (long)n, (long)config->nObjects);
+        e = eBADPARAMETER_OM;
+    }
+
+    free(record); free(oids);
+    if (e < eNOERROR) ERR(e);
+
+    printf("om_truncate objects=%ld object_bytes=%ld destroy_seconds=%.4f destroy_objects_seconds=%.4f truncate_seconds=%.4f\n",
+           (long)config->nObjects, (long)config->objectSize, times[0], times[1], times[2]);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Truncate() */
+
+
+
+/*@================================
+ * bench_ParseArgs()
+ *================================*/
+/*
+ * Function: static Four bench_ParseArgs(BenchConfig *, int, char **)
+ *
+ * Description:
+ *  Set the parameters of the run from the "key=value" arguments.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_OM
+ */
+static Four bench_ParseArgs(
+    BenchConfig         *config,                /* OUT parameters of the run */
+    int                 argc,                   /* IN # of arguments */
+    char                **argv)                 /* IN arguments */
+{
+    Four                i;
+    char                *value;
+
+
+    config->impl = &benchImpls[0];
+    config->nObjects = BENCH_DEFAULT_OBJECTS;
+    config->objectSize = BENCH_DEFAULT_OBJECTSIZE;
+    config->nRounds = BENCH_DEFAULT_ROUNDS;
+    config->churn = BENCH_DEFAULT_CHURN;
+    config->seed = 1;
+    config->batchSize = 1;
+    config->readAhead = BENCH_DEFAULT_READAHEAD;
+    config->selectivity = BENCH_DEFAULT_SELECTIVITY;
+    config->nWorkers = BENCH_DEFAULT_WORKERS;
+    config->nUpdates = BENCH_DEFAULT_UPDATES;
+    config->largeSize = 0;
+    config->nLarge = BENCH_DEFAULT_LARGEOBJECTS;
+    config->paxColumns = 0;
+    config->fixed = FALSE;
+    config->truncate = FALSE;
+
+    for (i = 1; i < argc; i++) {
+        value = strchr(argv[i], '=');
+        if (value == NULL) ERR(eBADPARAMETER_OM);
+        *value++ = '\0';
+
+        if (strcmp(argv[i], "impl") == 0) {
+            if (strcmp(value, "edu") == 0) config->impl = &benchImpls[0];
+            else if (strcmp(value, "base") == 0) config->impl = &benchImpls[1];
+            else ERR(eBADPARAMETER_OM);
+        }
+        else if (strcmp(argv[i], "objects") == 0) config->nObjects = atol(value);
+        else if (strcmp(argv[i], "object_bytes") == 0) config->objectSize = atol(value);
+        else if (strcmp(argv[i], "rounds") == 0) config->nRounds = atol(value);
+        else if (strcmp(argv[i], "churn") == 0) config->churn = atol(value);
+        else if (strcmp(argv[i], "seed") == 0) config->seed = atol(value);
+        else if (strcmp(argv[i], "batch") == 0) config->batchSize = atol(value);
+        else if (strcmp(argv[i], "readahead") == 0) config->readAhead = atol(value);
+        else if (strcmp(argv[i], "selectivity") == 0) config->selectivity = atol(value);
+        else if (strcmp(argv[i], "workers") == 0) config->nWorkers = atol(value);
+        else if (strcmp(argv[i], "updates") == 0) config->nUpdates = atol(value);
+        else if (strcmp(argv[i], "large_bytes") == 0) config->largeSize = atol(value);
+        else if (strcmp(argv[i], "large_objects") == 0) config->nLarge = atol(value);
+        else if (strcmp(argv[i], "pax_columns") == 0) config->paxColumns = atol(value);
+        else if (strcmp(argv[i], "fixed") == 0) config->fixed = (atol(value) != 0);
+        else if (strcmp(argv[i], "truncate") == 0) config->truncate = (atol(value) != 0);
+        else ERR(eBADPARAMETER_OM);
+    }
+
+    if (config->nObjects < 2 || config->objectSize < 1 ||
+        ALIGNED_LENGTH(config->objectSize) > LRGOBJ_THRESHOLD ||
+        config->nRounds < 0 || config->churn < 1 || config->churn > 100 ||
+        config->batchSize < 1 || config->readAhead < 0 ||
+        config->selectivity < 0 || config->selectivity > 100 ||
+        config->nWorkers < 1 || config->nWorkers > EDUOM_MAX_SCAN_WORKERS || (config->batchSize > 1 && config->impl != &benchImpls[0]) ||
+        config->nUpdates < 0 || config->largeSize < 0 || (config->largeSize > 0 && ALIGNED_LENGTH(config->largeSize) <= LRGOBJ_THRESHOLD) ||
+        config->nLarge < 1 || config->paxColumns < 0 || config->paxColumns > PAX_MAX_COLUMNS ||
+        (config->fixed && (config->objectSize < sizeof(Four) || config->objectSize > FIXED_MAX_LENGTH)))
+        ERR(eBADPARAMETER_OM);
+
+    return(eNOERROR);
+
+}  /* bench_ParseArgs() */
+
+
+
+/*@================================
+ * main()
+ *================================*/
+int main(int argc, char *argv[])
+{
+    Four                e;                      /* for errors */
+    BenchConfig         config;
+    BenchDB             db;
+
+
+    e = bench_ParseArgs(&config, argc, argv);
+    if (e < eNOERROR) {
+        fprintf(stderr, "Usage: %s [impl=edu|base] [objects=N] [object_bytes=N] [rounds=N] [churn=%%] [seed=N] [batch=N] [readahead=N] [selectivity=%%] [workers=N] [updates=N] [large_bytes=N] [large_objects=N] [pax_columns=N] [fixed=N] [truncate=N]\n", argv[0]);
+        exit(1);
+    }
+
+    e = bench_Open(&db, &config);
+    if (e >= eNOERROR) e = bench_Load(&db);
+    if (e >= eNOERROR) e = bench_Scan(&db);
+    if (e >= eNOERROR) e = bench_Filter(&db);
+    if (e >= eNOERROR) e = bench_ParallelScan(&db);
+    if (e >= eNOERROR) e = bench_Churn(&db);
+    if (e >= eNOERROR) e = bench_Update(&db);
+    if (e >= eNOERROR) e = bench_Large(&db);
+    if (e >= eNOERROR) e = bench_Pax(&db);
+    if (e >= eNOERROR) e = bench_Fixed(&db);
+    if (e >= eNOERROR) e = bench_Truncate(&db);
+
+    bench_Close(&db);
+
+    return((e < eNOERROR) ? 1 : 0);
+
+}  /* main() */
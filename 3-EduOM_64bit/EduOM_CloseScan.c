@@ -0,0 +1,87 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduOM_CloseScan.c
+ *
+ * Description:
+ *  Close a sequential scan cursor.
+ *
+ * Export:
+ *  Four EduOM_CloseScan(EduOM_ScanCursor*)
+ */
+
+
+#include "EduOM_common.h"
+#include "BfM.h"
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+/*@================================
+ * EduOM_CloseScan()
+ *================================*/
+/*
+ * Function: Four EduOM_CloseScan(EduOM_ScanCursor*)
+ *
+ * Description:
+ *  Close the scan cursor; unfix the current page and the page of the
+ *  forwarded record returned last if they are fixed.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_OM
+ *    some errors caused by function calls
+ */
+Four EduOM_CloseScan(
+    EduOM_ScanCursor *cursor)	/* INOUT the scan cursor */
+{
+    Four e;					/* error */
+
+
+
+    /*@
+     * parameter checking
+     */
+    if (cursor == NULL) ERR(eBADPARAMETER_OM);
+
+	if (cursor->fwdPid.pageNo != NIL) {
+		SCAN_LATCH(cursor);
+		e = BfM_FreeTrain(&cursor->fwdPid, PAGE_BUF);
+		SCAN_UNLATCH(cursor);
+		if (e<0) ERR(e);
+		cursor->fwdPid.pageNo = NIL;
+	}
+
+	if (cursor->apage != NULL) {
+		SCAN_LATCH(cursor);
+		e = BfM_FreeTrain(&cursor->pid, PAGE_BUF);
+		SCAN_UNLATCH(cursor);
+		if (e<0) ERR(e);
+		cursor->apage = NULL;
+	}
+	cursor->pid.pageNo = NIL;
+
+    return(eNOERROR);
+    
+} /* EduOM_CloseScan() */
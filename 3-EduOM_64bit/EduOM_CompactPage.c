@@ -41,6 +41,11 @@
 #include "EduOM_Internal.h"
 
 
+/* # of bits and words of the bitmap of the object offsets */
+#define COMPACT_NUM_BITS    ((PAGESIZE - SP_FIXED) / ALIGN)
+#define COMPACT_NUM_WORDS   ((COMPACT_NUM_BITS + 31) / 32)
+
+
 
 /*@================================
  * EduOM_CompactPage()
@@ -59,15 +64,23 @@
  *  the beginning of the page.
  *
  *  (2) How to do?
- *  a. Save the given page into the temporary page
- *  b. FOR each nonempty slot DO
- *	Fill the original page by copying the object from the saved page
- *          to the data area of original page pointed by 'apageDataOffset'
+ *  a. Mark the offsets of the objects of the nonempty slots in a bitmap
+ *  b. Save the object of 'slotNo' if it is given
+ *  c. FOR each marked offset in increasing order DO
+ *	Slide the object down to 'apageDataOffset' in place, together
+ *          with the objects adjacent to it
  *	Update the slot offset
  *	Get 'apageDataOffet' to point the next moved position
  *     ENDFOR
- *   c. Update the 'freeStart' and 'unused' field of the page
- *   d. Return
+ *  d. Put the saved object at 'apageDataOffset'
+ *  e. Update the 'freeStart' and 'unused' field of the page
+ *  f. Return
+ *
+ *  Since the objects are visited in the order of the offset, an object
+ *  never moves over an object not yet moved; only the bytes of the objects
+ *  which move are copied, with a single memmove() per run of adjacent
+ *  objects. The offsets are aligned, so the bitmap has a bit
+ *  per ALIGN bytes and orders the objects without sorting the slots.
  *	
  * Returns:
  *  error code
@@ -80,31 +93,63 @@ Four EduOM_CompactPage(
     SlottedPage	*apage,		/* IN slotted page to compact */
     Two         slotNo)		/* IN slotNo to go to the end */
 {
-    SlottedPage	tpage;		/* temporay page used to save the given page */
+    UFour  live[COMPACT_NUM_WORDS];	/* bitmap of the offsets of the objects to move */
+    Two    slotOf[COMPACT_NUM_BITS];	/* slot of each marked offset */
+    char   saved[PAGESIZE];	/* object of 'slotNo' */
     Object *obj;			/* pointer to the object in the data area */
     Two    apageDataOffset;	/* where the next object is to be moved */
     Four   len;				/* length of object + length of ObjectHdr */
-    Two    lastSlot;		/* last non empty slot */
-    Two    i;				/* index variable */
+    Four   savedLen;		/* length of the saved object */
+    Two    offset;			/* offset of the object to move */
+    Two    runStart, runEnd;	/* the run of adjacent objects being moved */
+    UFour  word;			/* remaining bits of a bitmap word */
+    Two    i, k;			/* index variables */
+    Four   w, bit;			/* bitmap position */
 
-	tpage = *apage;
-	apageDataOffset = 0;
-    
+	memset(live, 0, sizeof(live));
 	for(i=0; i<apage->header.nSlots; i++) {
-		if (i != slotNo && tpage.slot[-1*i].offset != EMPTYSLOT) {
-			obj = tpage.data + tpage.slot[-1*i].offset;
-			len = sizeof(ObjectHdr) + ALIGNED_LENGTH(obj->header.length);
-			memcpy(apage->data + apageDataOffset, obj, len);
-			apage->slot[-1*i].offset = apageDataOffset;
-			apageDataOffset += len;
+		if (i == slotNo || apage->slot[-1*i].offset == EMPTYSLOT) continue;
+
+		bit = apage->slot[-1*i].offset / ALIGN;
+		live[bit / 32] |= (UFour)1 << (bit % 32);
+		slotOf[bit] = i;
+	}
+
+	if (slotNo != NIL) {
+		obj = (Object*)(apage->data + apage->slot[-1*slotNo].offset);
+		savedLen = sizeof(ObjectHdr) + ALIGNED_LENGTH(OBJ_LENGTH_IN_PAGE(obj));
+		memcpy(saved, obj, savedLen);
+	}
+
+	/* the objects adjacent to each other are moved together as a run */
+	apageDataOffset = 0;
+	runStart = runEnd = 0;
+	for (w=0; w<COMPACT_NUM_WORDS; w++) {
+		for (word = live[w]; word != 0; word &= word - 1) {
+			bit = w * 32 + __builtin_ctz(word);
+			k = slotOf[bit];
+			offset = apage->slot[-1*k].offset;
+			obj = (Object*)(apage->data + offset);
+			len = sizeof(ObjectHdr) + ALIGNED_LENGTH(OBJ_LENGTH_IN_PAGE(obj));
+
+			if (offset != runEnd) {
+				if (runStart != apageDataOffset)
+					memmove(apage->data + apageDataOffset, apage->data + runStart, runEnd - runStart);
+				apageDataOffset += runEnd - runStart;
+				runStart = offset;
+			}
+			runEnd = offset + len;
+			apage->slot[-1*k].offset = apageDataOffset + (offset - runStart);
 		}
 	}
+	if (runStart != apageDataOffset)
+		memmove(apage->data + apageDataOffset, apage->data + runStart, runEnd - runStart);
+	apageDataOffset += runEnd - runStart;
+
 	if (slotNo != NIL) {
-		obj = tpage.data + tpage.slot[-1*slotNo].offset;
-		len = sizeof(ObjectHdr) + ALIGNED_LENGTH(obj->header.length);
-		memcpy(apage->data + apageDataOffset, obj, len);
+		memcpy(apage->data + apageDataOffset, saved, savedLen);
 		apage->slot[-1*slotNo].offset = apageDataOffset;
-		apageDataOffset += len;
+		apageDataOffset += savedLen;
 	}
 
 	apage->header.free = apageDataOffset;
@@ -0,0 +1,248 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : EduOM_CreateFixedObject.c
+ * 
+ * Description :
+ *  EduOM_CreateFixedObject() creates a fixed-length record in the
+ *  fixed-length record pages of a data file.
+ *
+ * Exports:
+ *  Four EduOM_CreateFixedObject(ObjectID*, ObjectID*, Two, void*, ObjectID*)
+ */
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "RDsM.h"		/* for the raw disk manager call */
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+
+
+static Four eduom_FixedFixPage(PageID*, FileID*, Two, FixedPage**, PageNo*);
+
+
+
+/*@================================
+ * EduOM_CreateFixedObject()
+ *================================*/
+/*
+ * Function: Four EduOM_CreateFixedObject(ObjectID*, ObjectID*, Two, void*, ObjectID*)
+ * 
+ * Description :
+ *  (1) What to do?
+ *  EduOM_CreateFixedObject() creates a record of 'length' bytes in a
+ *  fixed-length record page (see FixedPage in EduOM_Internal.h) of records
+ *  of the same length. The record is created in the page of the near
+ *  object 'nearObj' if it is such a page having room, or else in the page
+ *  following it if it is, or else in the last page of the file if it is,
+ *  or else in a page which was added or had a record destroyed lately if
+ *  it is (see eduom_FixedRoomGet()), or else in a new page added after the
+ *  page of the near object, or after the last page if 'nearObj' is NULL.
+ *  The first absent record of the page is used; it gets a new unique
+ *  number, so the ObjectID of a record destroyed there is not valid for it.
+ *  The record is an object with no tag: it is read, written, destroyed and
+ *  scanned by the functions for the objects of the slotted pages, but its
+ *  length is not changed and it is not pinned.
+ *
+ *  (2) How to do?
+ *  a. Check the parameters
+ *  b. Get the catalog entry of the file from the catalog cache
+ *  c. IF the near page, the page following it, the last page or a page
+ *        remembered with eduom_FixedRoomAdd() is a fixed-length record
+ *        page of the file and of the length having room THEN
+ *	   Use the page
+ *     ELSE
+ *	   Allocate a new page following the near page or the last page and
+ *	   lay it out
+ *     ENDIF
+ *  d. Mark the first absent record present with a new unique number and
+ *     copy the data into it
+ *  e. Set the page dirty, free it and return
+ *
+ * Returns:
+ *  error code
+ *    eBADCATALOGOBJECT_OM
+ *    eBADOBJECTID_OM
+ *    eBADLENGTH_OM
+ *    eBADUSERBUF_OM
+ *    some errors caused by function calls
+ *
+ * Side Effects :
+ *  1) parameter oid
+ *     'oid' is set to the ObjectID of the new record.
+ */
+Four EduOM_CreateFixedObject(
+    ObjectID  *catObjForFile,	/* IN file in which the record is to be placed */
+    ObjectID  *nearObj,			/* IN create the new record near this object */
+    Two       length,			/* IN length of the record */
+    void      *data,			/* IN the data of the record */
+    ObjectID  *oid)				/* OUT the record's ObjectID */
+{
+    Four        e;			/* error number */
+    Two         i;			/* record created */
+    FixedPage   *apage;		/* pointer to the buffer of the page */
+    PageID      pid;		/* page in which the record is created */
+    PageID      nearPid;	/* page the new page follows */
+    Four        extNo;		/* extent of the near page */
+    Unique      unique;		/* unique number of the record */
+    Four        found;		/* is a page having room found? */
+    PageNo      nextPage;	/* page following a page tried */
+    sm_CatOverlayForData *catEntry; /* pointer to data file catalog information */
+
+
+    /*@ parameter checking */
+    
+    if (catObjForFile == NULL) ERR(eBADCATALOGOBJECT_OM);
+
+    if (oid == NULL) ERR(eBADOBJECTID_OM);
+
+    if (length < 1 || length > FIXED_MAX_LENGTH) ERR(eBADLENGTH_OM);
+
+    if (data == NULL) ERR(eBADUSERBUF_OM);
+
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+	if (e<0) ERR(e);
+
+	found = FALSE;
+
+	if (nearObj != NULL) {
+		MAKE_PAGEID(pid, nearObj->volNo, nearObj->pageNo);
+		found = eduom_FixedFixPage(&pid, &catEntry->fid, length, &apage, &nextPage);
+		if (found<0) ERR(found);
+
+		/* the room left by the records following the near object may be on the next page */
+		if (!found && pid.pageNo != catEntry->lastPage) {
+			pid.pageNo = nextPage;
+			found = eduom_FixedFixPage(&pid, &catEntry->fid, length, &apage, &nextPage);
+			if (found<0) ERR(found);
+		}
+	}
+
+	/* 'pid' is the last page tried */
+	if (!found && (nearObj == NULL || pid.pageNo != catEntry->lastPage)) {
+		MAKE_PAGEID(pid, catEntry->fid.volNo, catEntry->lastPage);
+		found = eduom_FixedFixPage(&pid, &catEntry->fid, length, &apage, &nextPage);
+		if (found<0) ERR(found);
+	}
+
+	/* the pages which were added or had a record destroyed last */
+	while (!found && (pid.pageNo = eduom_FixedRoomGet(catObjForFile, length)) != NIL) {
+		pid.volNo = catEntry->fid.volNo;
+		found = eduom_FixedFixPage(&pid, &catEntry->fid, length, &apage, &nextPage);
+		if (found<0) ERR(found);
+		if (!found) eduom_FixedRoomRemove(catObjForFile, pid.pageNo);
+	}
+
+	if (!found) {
+		if (nearObj != NULL)
+			MAKE_PAGEID(nearPid, nearObj->volNo, nearObj->pageNo);
+		else
+			MAKE_PAGEID(nearPid, catEntry->fid.volNo, catEntry->lastPage);
+
+		e = RDsM_PageIdToExtNo(&nearPid, &extNo);
+		if (e<0) ERR(e);
+		e = RDsM_AllocTrains(nearPid.volNo, extNo, &nearPid, catEntry->eff, 1, 1, &pid);
+		if (e<0) ERR(e);
+		e = BfM_GetTrain(&pid, (char **)&apage, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		eduom_FixedInitPage(apage, catEntry->fid, pid, length);
+
+		e = eduom_FileMapAddPage(catObjForFile, &nearPid, &pid);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+		/* the page may have been a slotted page of the file */
+		eduom_FsmUpdatePage(catObjForFile, &pid, (SlottedPage*)apage);
+
+		eduom_FixedRoomAdd(catObjForFile, pid.pageNo, length);
+	}
+
+	e = eduom_GetUnique(&pid, (SlottedPage*)apage, &unique);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+	i = eduom_FixedAllocRecord(apage, unique);
+	memcpy(FIXED_RECORD(apage, i), data, length);
+
+	MAKE_OBJECTID(*oid, pid.volNo, pid.pageNo, i, unique);
+
+	e = BfM_SetDirty(&pid, PAGE_BUF);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduOM_CreateFixedObject() */
+
+
+
+/*@================================
+ * eduom_FixedFixPage()
+ *================================*/
+/*
+ * Function: static Four eduom_FixedFixPage(PageID*, FileID*, Two, FixedPage**, PageNo*)
+ *
+ * Description :
+ *  Fix the page and keep it fixed if it is a fixed-length record page of
+ *  the file, of records of 'length' bytes, having an absent record;
+ *  otherwise free it.
+ *
+ * Returns:
+ *  1) TRUE if the page is kept fixed, FALSE otherwise
+ *  2) error code
+ *    some errors caused by function calls
+ *
+ * Side Effects :
+ *  1) parameter apage
+ *     'apage' points to the buffer of the page if it is kept fixed.
+ *  2) parameter nextPage
+ *     'nextPage' is set to the page following the page if it is freed.
+ */
+static Four eduom_FixedFixPage(
+    PageID	*pid,		/* IN page to try */
+    FileID	*fid,		/* IN file of the record */
+    Two		length,		/* IN length of a record */
+    FixedPage	**apage,	/* OUT pointer to the buffer of the page */
+    PageNo	*nextPage)	/* OUT page following the page */
+{
+    Four	e;		/* error number */
+
+
+	e = BfM_GetTrain(pid, (char **)apage, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	if (IS_FIXED_PAGE(*apage) && EQUAL_FILEID((*apage)->header.fid, *fid) && (*apage)->fixed.length == length &&
+	    (*apage)->fixed.nRecords < (*apage)->fixed.maxRecords)
+		return(TRUE);
+
+	*nextPage = (*apage)->header.nextPage;
+
+	e = BfM_FreeTrain(pid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	return(FALSE);
+
+} /* eduom_FixedFixPage() */
@@ -30,6 +30,7 @@
  *
  * Exports:
  *  Four EduOM_CreateObject(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*)
+ *  Four eduom_GetUnique(PageID*, SlottedPage*, Unique*)
  */
 
 #include <string.h>
@@ -38,7 +39,6 @@
 #include "BfM.h"		/* for the buffer manager call */
 #include "EduOM_Internal.h"
 
-void eduom_InitPageHeader(SlottedPage *apage, FileID fid, PageID pid);
 /*@================================
  * EduOM_CreateObject()
  *================================*/
@@ -54,6 +54,8 @@ void eduom_InitPageHeader(SlottedPage *apage, FileID fid, PageID pid);
  * If there is no room in the page holding the specified object,
  * it trys to insert into the page in the available space list. If fail, then
  * the new object will be put into the newly allocated page.
+ * An object longer than LRGOBJ_THRESHOLD is created as a large object: the
+ * slotted page holds the root of a tree of trains keeping the data.
  *
  * (2) How to do?
  *	a. Read in the near slotted page
@@ -102,9 +104,6 @@ Four EduOM_CreateObject(
 
     if (length > 0 && data == NULL) return(eBADUSERBUF_OM);
 
-	/* Error check whether using not supported functionality by EduOM */
-	if (ALIGNED_LENGTH(length) > LRGOBJ_THRESHOLD) ERR(eNOTSUPPORTED_EDUOM);
-
 	objectHdr.properties = 0x0;
 	objectHdr.length = 0;
 	if (objHdr != NULL)
@@ -112,7 +111,10 @@ Four EduOM_CreateObject(
 	else
 		objectHdr.tag = 0;
 
-	e = eduom_CreateObject(catObjForFile, nearObj, &objectHdr, length, data, oid);
+	if (ALIGNED_LENGTH(length) <= LRGOBJ_THRESHOLD)
+		e = eduom_CreateObject(catObjForFile, nearObj, &objectHdr, length, data, oid);
+	else
+		e = eduom_LotCreate(catObjForFile, nearObj, &objectHdr, length, data, oid);
 	if (e<0) ERR(e);
 
     return(eNOERROR);
@@ -134,8 +136,8 @@ Four EduOM_CreateObject(
  *  NULL, a new page is allocated for object creation (In this case, the newly
  *  allocated page is inserted after the near page in the list of pages
  *  consiting in the file).
- *  If there is no room in the near page and the near object 'nearObj' is NULL,
- *  it trys to create a new object in the page in the available space list. If
+ *  If the near object 'nearObj' is NULL, it trys to create a new object in the
+ *  first page having enough room, found with the free space map of the file. If
  *  fail, then the new object will be put into the newly allocated page(In this
  *  case, the newly allocated page is appended at the tail of the list of pages
  *  cosisting in the file).
@@ -156,10 +158,10 @@ Four eduom_CreateObject(
 {
     Four        e;			/* error number */
     Four	neededSpace;	/* space needed to put new object [+ header] */
+    Four	oldFree;		/* free space of the page before the object is put; NIL for a new page */
     SlottedPage *apage;		/* pointer to the slotted page buffer */
 	SlottedPage	*npage;
     Four        alignedLen;	/* aligned length of initial data */
-    Boolean     needToAllocPage;/* Is there a need to alloc a new page? */
     PageID      pid;            /* PageID in which new object to be inserted */
     PageID      nearPid;
 	PageID		firstPid;
@@ -167,11 +169,9 @@ Four eduom_CreateObject(
     Object      *obj;		/* point to the newly created object */
     Two         i;			/* index variable */
     sm_CatOverlayForData *catEntry; /* pointer to data file catalog information */
-    SlottedPage *catPage;	/* pointer to buffer containing the catalog */
     FileID      fid;		/* ID of file where the new object is placed */
     Two         eff;		/* extent fill factor of file */
     Boolean     isFirst;
-    PhysicalFileID pFid;
 	Unique		unique;
 	Four		offset;
     
@@ -185,13 +185,11 @@ Four eduom_CreateObject(
     /* Error check whether using not supported functionality by EduOM */
     if(ALIGNED_LENGTH(length) > LRGOBJ_THRESHOLD) ERR(eNOTSUPPORTED_EDUOM);
     
-	alignedLen = ALIGNED_LENGTH(objHdr->length);
+	alignedLen = ALIGNED_LENGTH(DATA_LENGTH_IN_PAGE(length));
 	neededSpace = sizeof(ObjectHdr) + alignedLen + sizeof(SlottedPageSlot);	
 
-	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
-	e = BfM_GetTrain(&pFid, &catPage, PAGE_BUF);
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
 	if (e<0) ERR(e);
-	GET_PTR_TO_CATENTRY_FOR_DATA(catObjForFile, catPage, catEntry);
 	fid = catEntry->fid;
 	isFirst = 0;
 
@@ -203,8 +201,7 @@ Four eduom_CreateObject(
 		if (neededSpace <= SP_FREE(npage)) {
 			pid = nearPid;
 			apage = npage;
-			e = om_RemoveFromAvailSpaceList(catObjForFile, &pid, apage);
-			if (e<0) ERR(e);
+			oldFree = SP_FREE(apage);
 			if (neededSpace > SP_CFREE(apage)) {
 				e = EduOM_CompactPage(apage, NIL);
 				if (e<0) ERR(e);
@@ -221,36 +218,39 @@ Four eduom_CreateObject(
 			if (e<0) ERR(e);
 
 			eduom_InitPageHeader(apage, fid, pid);
+			oldFree = NIL;
 
-			e = om_FileMapAddPage(catObjForFile, &nearPid, &pid);
+			e = eduom_FileMapAddPage(catObjForFile, &nearPid, &pid);
 			if (e<0) ERR(e);
-			e = BfM_FreeTrain(&pid, PAGE_BUF);
+
+			e = BfM_FreeTrain(&nearPid, PAGE_BUF);
 			if (e<0) ERR(e);
 		}
-		BfM_FreeTrain(&nearPid, PAGE_BUF);
 	}
 	else {
-		pid.pageNo = NIL;
-		if (neededSpace <= SP_10SIZE)
-			pid.pageNo = catEntry->availSpaceList10;
-		if (pid.pageNo == NIL && neededSpace <= SP_20SIZE)
-			pid.pageNo = catEntry->availSpaceList20;
-		if (pid.pageNo == NIL && neededSpace <= SP_30SIZE)
-			pid.pageNo = catEntry->availSpaceList30;
-		if (pid.pageNo == NIL && neededSpace <= SP_40SIZE)
-			pid.pageNo = catEntry->availSpaceList40;
-		if (pid.pageNo == NIL && neededSpace <= SP_50SIZE)
-			pid.pageNo = catEntry->availSpaceList50;
-		
-		if (pid.pageNo == NIL)		needToAllocPage = 1;
-		else						needToAllocPage = 0;
-
-		pid.volNo = fid.volNo;
-		if (!needToAllocPage) {
+		/* the free space map gives the first page having enough free space */
+		for (;;) {
+			e = eduom_FsmFindPage(catObjForFile, catEntry, neededSpace, &pid);
+			if (e<0) ERR(e);
+			if (pid.pageNo == NIL) break;
+
 			e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
 			if (e<0) ERR(e);
-			e = om_RemoveFromAvailSpaceList(catObjForFile, &pid, apage);
+
+			/* the free space map is out of date; a page which is not a slotted
+			   page of the file is forgotten */
+			if (!EQUAL_FILEID(apage->header.fid, catEntry->fid) || !IS_SLOTTED_PAGE(apage))
+				eduom_FsmRemovePage(catObjForFile, &pid);
+			else if (neededSpace <= SP_FREE(apage))
+				break;
+			else
+				eduom_FsmUpdatePage(catObjForFile, &pid, apage);
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
 			if (e<0) ERR(e);
+		}
+
+		if (pid.pageNo != NIL) {
+			oldFree = SP_FREE(apage);
 			
 			if (neededSpace > SP_CFREE(apage)) {
 				e = EduOM_CompactPage(apage, NIL);
@@ -258,67 +258,46 @@ Four eduom_CreateObject(
 			}
 		}
 		else {
-			pid.pageNo = catEntry->lastPage;
+			MAKE_PAGEID(nearPid, fid.volNo, catEntry->lastPage);
+			e = RDsM_PageIdToExtNo(&nearPid, &firstExt);
+			if (e<0) ERR(e);
+			eff = catEntry->eff;
+			e = RDsM_AllocTrains(fid.volNo, firstExt, &nearPid, eff, 1, 1, &pid);
+			if (e<0) ERR(e);
 			e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
 			if (e<0) ERR(e);
 
-			if (neededSpace <= SP_FREE(apage)) {
-				e = om_RemoveFromAvailSpaceList(catObjForFile, &pid, apage);
-				if (e<0) ERR(e);
-				if (neededSpace > SP_CFREE(apage)) {
-					e = EduOM_CompactPage(apage, NIL);
-					if (e<0) ERR(e);
-				}
-			}
-			else {
-				e = BfM_FreeTrain(&pid, PAGE_BUF);
-				if (e<0) ERR(e);
-
-				MAKE_PAGEID(nearPid, fid.volNo, catEntry->lastPage);
-				e = RDsM_PageIdToExtNo(&nearPid, &firstExt);
-				if (e<0) ERR(e);
-				eff = catEntry->eff;
-				e = RDsM_AllocTrains(fid.volNo, firstExt, &nearPid, eff, 1, 1, &pid);
-				if (e<0) ERR(e);
-				e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
-				if (e<0) ERR(e);
-
-				eduom_InitPageHeader(apage, fid, pid);
+			eduom_InitPageHeader(apage, fid, pid);
+			oldFree = NIL;
 
-				e = om_FileMapAddPage(catObjForFile, &nearPid, &pid);
-				if (e<0) ERR(e);
-				e = BfM_FreeTrain(&nearPid, PAGE_BUF);
-				if (e<0) ERR(e);
-			}
+			e = eduom_FileMapAddPage(catObjForFile, &nearPid, &pid);
+			if (e<0) ERR(e);
 		}
-		e = BfM_FreeTrain(&pid, PAGE_BUF);
-		if (e<0) ERR(e);
 	}
 
-	objHdr->length = length;
+	/* the root of a large object is in the data area; its length is set by appending */
+	objHdr->length = (objHdr->properties & P_LRGOBJ) ? 0 : length;
 	memcpy(apage->data + apage->header.free, objHdr, sizeof(ObjectHdr));	
 	memcpy(apage->data + apage->header.free + sizeof(ObjectHdr), data, length);
 	
-	e = om_GetUnique(&apage->header.pid, &apage->header.unique);
-	if (e<0) ERR(e);
+	e = eduom_GetUnique(&pid, apage, &unique);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
 
-	for (i=0; i<apage->header.nSlots; i++) {
-		if (apage->slot[-1*i].offset == EMPTYSLOT)
-			break;
-	}
-	if (i == apage->header.nSlots)
-		apage->header.nSlots++;
+	i = eduom_AllocSlot(apage);
 
-	MAKE_OBJECTID(*oid, pid.volNo, pid.pageNo, i, apage->header.unique);
+	MAKE_OBJECTID(*oid, pid.volNo, pid.pageNo, i, unique);
 	
-	apage->slot[-1*i].unique = apage->header.unique;
+	apage->slot[-1*i].unique = unique;
 	apage->slot[-1*i].offset = apage->header.free;
-	apage->header.free += sizeof(ObjectHdr) +  ALIGNED_LENGTH(length);
+	apage->header.free += sizeof(ObjectHdr) + alignedLen;
 
-	e = om_PutInAvailSpaceList(catObjForFile, &pid, apage);
-	if (e<0) ERR(e);
+	e = BfM_SetDirty(&pid, PAGE_BUF);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+	e = eduom_PutInAvailSpaceList(catObjForFile, &pid, apage, oldFree);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
 
-	e = BfM_FreeTrain(&pFid, PAGE_BUF); 
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
 	if (e<0) ERR(e);
  
     return(eNOERROR);
@@ -328,7 +307,8 @@ Four eduom_CreateObject(
 void eduom_InitPageHeader(SlottedPage *apage, FileID fid, PageID pid) {
 	MAKE_PAGEID(apage->header.pid, pid.volNo, pid.pageNo);
 	SET_PAGE_TYPE(apage, SLOTTED_PAGE_TYPE); 
-	apage->header.reserved = 0;
+	apage->header.flags |= SP_FREESLOTLIST;
+	apage->header.freeSlot = NIL;
 	apage->header.nSlots = 0;
 	apage->header.free = 0;
 	apage->header.unused = 0;
@@ -340,3 +320,45 @@ void eduom_InitPageHeader(SlottedPage *apage, FileID fid, PageID pid) {
 	apage->header.spaceListPrev = NIL;
 	apage->header.spaceListNext = NIL;
 } /* eduom_InitPageHeader() */
+
+
+
+/*@================================
+ * eduom_GetUnique()
+ *================================*/
+/*
+ * Function: Four eduom_GetUnique(PageID*, SlottedPage*, Unique*)
+ *
+ * Description :
+ *  Give a unique number for a new object of the page, which the caller has
+ *  fixed. The numbers up to 'uniqueLimit' are reserved for the page from the
+ *  volume and 'unique' is the last number given, as om_GetUnique() keeps
+ *  them, so a number is usually given by incrementing 'unique' in place; the
+ *  volume is asked for a new range only when it runs out. The caller sets
+ *  the page dirty.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_GetUnique(
+    PageID	*pid,		/* IN page of the new object */
+    SlottedPage	*apage,		/* INOUT pointer to the buffer of the page */
+    Unique	*unique)	/* OUT unique number of the new object */
+{
+    Four	e;			/* error number */
+    Four	num;		/* # of unique numbers reserved */
+
+
+	if (apage->header.unique >= apage->header.uniqueLimit) {
+		e = RDsM_GetUnique(pid, &apage->header.unique, &num);
+		if (e<0) ERR(e);
+
+		apage->header.uniqueLimit = apage->header.unique + num;
+	}
+
+	*unique = ++apage->header.unique;
+
+	return(eNOERROR);
+
+} /* eduom_GetUnique() */
@@ -0,0 +1,323 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : EduOM_CreateObjects.c
+ * 
+ * Description :
+ *  EduOM_CreateObjects() creates a batch of new objects near the specified
+ *  object.
+ *
+ * Exports:
+ *  Four EduOM_CreateObjects(ObjectID*, ObjectID*, Four, ObjectHdr*, Four*, void**, ObjectID*)
+ */
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "RDsM.h"		/* for the raw disk manager call */
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+
+
+/* space needed to put a new object of 'length' bytes [+ header + slot] */
+#define NEEDED_SPACE(length) \
+	(sizeof(ObjectHdr) + ALIGNED_LENGTH(DATA_LENGTH_IN_PAGE(length)) + sizeof(SlottedPageSlot))
+
+
+static Four eduom_GetPageForObjects(ObjectID*, sm_CatOverlayForData*, PageID*, Four, PageID*, SlottedPage**, Four*);
+
+
+
+/*@================================
+ * EduOM_CreateObjects()
+ *================================*/
+/*
+ * Function: Four EduOM_CreateObjects(ObjectID*, ObjectID*, Four, ObjectHdr*, Four*, void**, ObjectID*)
+ * 
+ * Description :
+ *  (1) What to do?
+ *  EduOM_CreateObjects() creates 'nObjects' new objects near the specified
+ *  object, in the order given. It is equivalent to calling
+ *  EduOM_CreateObject() for each object, the i-th call being near the
+ *  object created by the (i-1)-th one, but the catalog entry is gotten once
+ *  for the batch and each target page is filled with as many objects as
+ *  fit before moving on; the page is moved between the available space
+ *  lists at most once, not once per object.
+ *  An object longer than LRGOBJ_THRESHOLD is created as a large object,
+ *  as EduOM_CreateObject() does; the page being filled is put away first.
+ *
+ *  (2) How to do?
+ *  a. Check the parameters of all the objects
+ *  b. Get the catalog entry of the file from the catalog cache
+ *  c. WHILE there is an object to create DO
+ *	   IF the next object is a large object THEN
+ *	       Create it with eduom_LotCreate() near the previous object
+ *	       CONTINUE
+ *	   ENDIF
+ *	   Get a page having room for the next object (see eduom_CreateObject())
+ *	   WHILE there is a small object to create and it fits in the page DO
+ *	       Compact the page if the contiguous free area is too small
+ *	       Put the object into the page
+ *	   ENDWHILE
+ *	   Put the page into the proper 'availSpaceList' if it is changed, update
+ *	   the free space map and free the page
+ *	   Make the next page follow this page if 'nearObj' is given
+ *     ENDWHILE
+ *  d. Return
+ *
+ * Returns:
+ *  error code
+ *    eBADCATALOGOBJECT_OM
+ *    eBADPARAMETER_OM
+ *    eBADLENGTH_OM
+ *    eBADUSERBUF_OM
+ *    some error codes from the lower level
+ *
+ * Side Effects :
+ *  0) 'nObjects' new objects are created.
+ *  1) parameter oids
+ *     'oids[i]' is set to the ObjectID of the i-th object.
+ */
+Four EduOM_CreateObjects(
+    ObjectID  *catObjForFile,	/* IN file in which objects are to be placed */
+    ObjectID  *nearObj,			/* IN create the new objects near this object */
+    Four      nObjects,			/* IN # of objects to create */
+    ObjectHdr *objHdrs,			/* IN from which tags are to be set; NULL for 0 tags */
+    Four      *lengths,			/* IN amount of data of each object */
+    void      **datas,			/* IN the initial data of each object */
+    ObjectID  *oids)			/* OUT the objects' ObjectIDs */
+{
+    Four        e;			/* error number */
+    Four        i;			/* index of the next object to create */
+    Four        neededSpace;	/* space needed to put the next object */
+    Four        oldFree;	/* free space of the page before the objects are put; NIL for a new page */
+    SlottedPage *apage;		/* pointer to the slotted page buffer */
+    PageID      pid;		/* page in which new objects are inserted */
+    PageID      nearPid;	/* page which the next page follows */
+    ObjectID    nearOid;	/* object which the next large object follows */
+    Boolean     hasNear;	/* is 'nearPid' given? */
+    ObjectHdr   lrgHdr;		/* header of a large object */
+    Object      *obj;		/* point to the newly created object */
+    Two         slotNo;		/* slot of the newly created object */
+    Unique      unique;		/* unique number of the newly created object */
+    sm_CatOverlayForData *catEntry; /* pointer to data file catalog information */
+
+
+    /*@ parameter checking */
+    
+    if (catObjForFile == NULL) ERR(eBADCATALOGOBJECT_OM);
+
+    if (nObjects < 0) ERR(eBADPARAMETER_OM);
+
+    if (nObjects > 0 && (lengths == NULL || datas == NULL || oids == NULL)) ERR(eBADPARAMETER_OM);
+
+    for (i = 0; i < nObjects; i++) {
+		if (lengths[i] < 0) ERR(eBADLENGTH_OM);
+
+		if (lengths[i] > 0 && datas[i] == NULL) ERR(eBADUSERBUF_OM);
+	}
+
+	if (nObjects == 0) return(eNOERROR);
+
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+	if (e<0) ERR(e);
+
+	hasNear = (nearObj != NULL);
+	if (hasNear) {
+		nearOid = *nearObj;
+		MAKE_PAGEID(nearPid, nearObj->volNo, nearObj->pageNo);
+	}
+
+	i = 0;
+	while (i < nObjects) {
+		if (ALIGNED_LENGTH(lengths[i]) > LRGOBJ_THRESHOLD) {
+			lrgHdr.properties = 0x0;
+			lrgHdr.length = 0;
+			lrgHdr.tag = (objHdrs != NULL) ? objHdrs[i].tag : 0;
+
+			e = eduom_LotCreate(catObjForFile, hasNear ? &nearOid : NULL, &lrgHdr, lengths[i], datas[i], &oids[i]);
+			if (e<0) ERR(e);
+
+			/* the file may have grown */
+			e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+			if (e<0) ERR(e);
+
+			if (hasNear) {
+				nearOid = oids[i];
+				MAKE_PAGEID(nearPid, oids[i].volNo, oids[i].pageNo);
+			}
+			i++;
+			continue;
+		}
+
+		neededSpace = NEEDED_SPACE(lengths[i]);
+		e = eduom_GetPageForObjects(catObjForFile, catEntry, hasNear ? &nearPid : NULL, neededSpace, &pid, &apage, &oldFree);
+		if (e<0) ERR(e);
+
+		do {
+			if (neededSpace > SP_CFREE(apage)) {
+				e = EduOM_CompactPage(apage, NIL);
+				if (e<0) ERR(e);
+			}
+
+			obj = (Object*)(apage->data + apage->header.free);
+			obj->header.properties = 0x0;
+			obj->header.tag = (objHdrs != NULL) ? objHdrs[i].tag : 0;
+			obj->header.length = lengths[i];
+			memcpy(obj->data, datas[i], lengths[i]);
+
+			e = eduom_GetUnique(&pid, apage, &unique);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+			slotNo = eduom_AllocSlot(apage);
+			apage->slot[-1*slotNo].unique = unique;
+			apage->slot[-1*slotNo].offset = apage->header.free;
+			apage->header.free += sizeof(ObjectHdr) + ALIGNED_LENGTH(DATA_LENGTH_IN_PAGE(lengths[i]));
+
+			MAKE_OBJECTID(oids[i], pid.volNo, pid.pageNo, slotNo, unique);
+
+			i++;
+			if (i < nObjects) neededSpace = NEEDED_SPACE(lengths[i]);
+		} while (i < nObjects && ALIGNED_LENGTH(lengths[i]) <= LRGOBJ_THRESHOLD && neededSpace <= SP_FREE(apage));
+
+		e = BfM_SetDirty(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		e = eduom_PutInAvailSpaceList(catObjForFile, &pid, apage, oldFree);
+		if (e<0) ERR(e);
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		/* the objects are clustered in the order given */
+		if (hasNear) {
+			nearOid = oids[i-1];
+			nearPid = pid;
+		}
+	}
+
+    return(eNOERROR);
+
+} /* EduOM_CreateObjects() */
+
+
+
+/*@================================
+ * eduom_GetPageForObjects()
+ *================================*/
+/*
+ * Function: static Four eduom_GetPageForObjects(ObjectID*, sm_CatOverlayForData*, PageID*, Four, PageID*, SlottedPage**, Four*)
+ *
+ * Description :
+ *  Get the page into which the next objects are put; the page is chosen as
+ *  eduom_CreateObject() does for an object needing 'neededSpace' bytes.
+ *  If 'nearPid' is not NULL, it is the near page if it has room, or else
+ *  a new page inserted after the near page. Otherwise, it is the first page
+ *  having room found with the free space map of the file, or else a new page
+ *  appended at the tail of the file.
+ *  The page returned is fixed; its free space is returned for
+ *  eduom_PutInAvailSpaceList(), NIL for a new page.
+ *
+ * Returns:
+ *  error Code
+ *    some errors caused by fuction calls
+ */
+static Four eduom_GetPageForObjects(
+    ObjectID	*catObjForFile,	/* IN file in which objects are to be placed */
+    sm_CatOverlayForData *catEntry, /* IN data file catalog information */
+    PageID		*nearPid,	/* IN near page; NULL if not given */
+    Four		neededSpace,	/* IN space needed to put the next object */
+    PageID		*pid,		/* OUT page into which the objects are put */
+    SlottedPage	**apage,	/* OUT pointer to the buffer holding the page */
+    Four		*oldFree)	/* OUT free space of the page; NIL for a new page */
+{
+    Four        e;			/* error number */
+    PageID      prevPid;	/* page which the new page follows */
+    Four        extNo;		/* extent of 'prevPid' */
+    FileID      fid;		/* ID of file where the objects are placed */
+
+
+	fid = catEntry->fid;
+	pid->volNo = fid.volNo;
+
+	if (nearPid != NULL) {
+		prevPid = *nearPid;
+	}
+	else {
+		for (;;) {
+			e = eduom_FsmFindPage(catObjForFile, catEntry, neededSpace, pid);
+			if (e<0) ERR(e);
+			if (pid->pageNo == NIL) break;
+
+			e = BfM_GetTrain(pid, apage, PAGE_BUF);
+			if (e<0) ERR(e);
+
+			/* the free space map is out of date; a page which is not a slotted
+			   page of the file is forgotten */
+			if (!EQUAL_FILEID((*apage)->header.fid, catEntry->fid) || !IS_SLOTTED_PAGE(*apage))
+				eduom_FsmRemovePage(catObjForFile, pid);
+			else if (neededSpace <= SP_FREE(*apage)) {
+				*oldFree = SP_FREE(*apage);
+				return(eNOERROR);
+			}
+			else
+				eduom_FsmUpdatePage(catObjForFile, pid, *apage);
+			e = BfM_FreeTrain(pid, PAGE_BUF);
+			if (e<0) ERR(e);
+		}
+
+		MAKE_PAGEID(prevPid, fid.volNo, catEntry->lastPage);
+	}
+
+	/* the near page or the last page, if it has room */
+	e = BfM_GetTrain(&prevPid, apage, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	if (neededSpace <= SP_FREE(*apage)) {
+		*pid = prevPid;
+		*oldFree = SP_FREE(*apage);
+
+		return(eNOERROR);
+	}
+
+	e = BfM_FreeTrain(&prevPid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	/* a new page following 'prevPid' */
+	e = RDsM_PageIdToExtNo(&prevPid, &extNo);
+	if (e<0) ERR(e);
+	e = RDsM_AllocTrains(fid.volNo, extNo, &prevPid, catEntry->eff, 1, 1, pid);
+	if (e<0) ERR(e);
+	e = BfM_GetTrain(pid, apage, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	eduom_InitPageHeader(*apage, fid, *pid);
+	*oldFree = NIL;
+
+	e = eduom_FileMapAddPage(catObjForFile, &prevPid, pid);
+	if (e<0) ERR(e);
+
+    return(eNOERROR);
+
+} /* eduom_GetPageForObjects() */
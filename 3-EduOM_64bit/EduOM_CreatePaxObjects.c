@@ -0,0 +1,216 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : EduOM_CreatePaxObjects.c
+ * 
+ * Description :
+ *  EduOM_CreatePaxObjects() creates a batch of fixed-length records in the
+ *  PAX pages of a data file.
+ *
+ * Exports:
+ *  Four EduOM_CreatePaxObjects(ObjectID*, Two, Two*, Four, void*, ObjectID*)
+ */
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "RDsM.h"		/* for the raw disk manager call */
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+
+
+static Boolean eduom_PaxSameColumns(PaxPage*, Two, Two*);
+
+
+
+/*@================================
+ * EduOM_CreatePaxObjects()
+ *================================*/
+/*
+ * Function: Four EduOM_CreatePaxObjects(ObjectID*, Two, Two*, Four, void*, ObjectID*)
+ * 
+ * Description :
+ *  (1) What to do?
+ *  EduOM_CreatePaxObjects() creates 'nObjects' records of 'nColumns'
+ *  columns in PAX pages (see PaxPage in EduOM_Internal.h), in the order
+ *  given. 'data' holds the records one after another, a record being the
+ *  values of its columns in order; the value of the column 'c' is
+ *  'widths[c]' bytes long. The records are appended to the last page of the
+ *  file while it is a PAX page of the same columns having room, and then
+ *  to new PAX pages added at the end of the file.
+ *  A record is read by EduOM_ReadObject() like an object of the same
+ *  length, and the columns of the records are scanned by
+ *  EduOM_PaxOpenScan(); the records cannot be updated or destroyed.
+ *
+ *  (2) How to do?
+ *  a. Check the parameters
+ *  b. Get the catalog entry of the file from the catalog cache
+ *  c. WHILE there is a record to create DO
+ *	   IF the last page is a PAX page of the columns having room THEN
+ *	       Use the last page
+ *	   ELSE
+ *	       Allocate a new page following the last page and lay it out
+ *	   ENDIF
+ *	   WHILE there is a record to create and the page has room DO
+ *	       Copy the value of each column into the minipage of the column
+ *	   ENDWHILE
+ *	   Set the page dirty and free it
+ *     ENDWHILE
+ *  d. Return
+ *
+ * Returns:
+ *  error code
+ *    eBADCATALOGOBJECT_OM
+ *    eBADPARAMETER_OM
+ *    eBADLENGTH_OM
+ *    some errors caused by function calls
+ *
+ * Side Effects :
+ *  1) parameter oids
+ *     'oids[i]' is set to the ObjectID of the i-th record.
+ */
+Four EduOM_CreatePaxObjects(
+    ObjectID  *catObjForFile,	/* IN file in which the records are to be placed */
+    Two       nColumns,			/* IN # of columns of a record */
+    Two       *widths,			/* IN length of a value of each column */
+    Four      nObjects,			/* IN # of records to create */
+    void      *data,			/* IN the records */
+    ObjectID  *oids)			/* OUT the records' ObjectIDs */
+{
+    Four        e;			/* error number */
+    Four        i;			/* index of the next record to create */
+    Four        recordLength;	/* sum of the widths */
+    Four        colStart;	/* offset of a column in the record */
+    Two         c;			/* column */
+    char        *record;	/* next record to create */
+    PaxPage     *apage;		/* pointer to the buffer of the page */
+    PageID      pid;		/* page in which the records are created */
+    PageID      lastPid;	/* last page of the file */
+    Four        extNo;		/* extent of the last page */
+    Unique      unique;		/* unique number of the records of a new page */
+    sm_CatOverlayForData *catEntry; /* pointer to data file catalog information */
+
+
+    /*@ parameter checking */
+    
+    if (catObjForFile == NULL) ERR(eBADCATALOGOBJECT_OM);
+
+    if (nColumns < 1 || nColumns > PAX_MAX_COLUMNS || widths == NULL) ERR(eBADPARAMETER_OM);
+
+    if (nObjects < 0) ERR(eBADPARAMETER_OM);
+
+    if (nObjects > 0 && (data == NULL || oids == NULL)) ERR(eBADPARAMETER_OM);
+
+    for (recordLength = 0, c = 0; c < nColumns; c++) {
+		if (widths[c] < 1) ERR(eBADLENGTH_OM);
+		recordLength += widths[c];
+	}
+
+	if (PAX_MAX_RECORDS(nColumns, recordLength) < 1) ERR(eBADLENGTH_OM);
+
+	if (nObjects == 0) return(eNOERROR);
+
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+	if (e<0) ERR(e);
+
+	i = 0;
+	while (i < nObjects) {
+		MAKE_PAGEID(lastPid, catEntry->fid.volNo, catEntry->lastPage);
+		e = BfM_GetTrain(&lastPid, (char **)&apage, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		if (eduom_PaxSameColumns(apage, nColumns, widths) && apage->pax.nRecords < apage->pax.maxRecords) {
+			pid = lastPid;
+		}
+		else {
+			e = BfM_FreeTrain(&lastPid, PAGE_BUF);
+			if (e<0) ERR(e);
+
+			e = RDsM_PageIdToExtNo(&lastPid, &extNo);
+			if (e<0) ERR(e);
+			e = RDsM_AllocTrains(lastPid.volNo, extNo, &lastPid, catEntry->eff, 1, 1, &pid);
+			if (e<0) ERR(e);
+			e = BfM_GetTrain(&pid, (char **)&apage, PAGE_BUF);
+			if (e<0) ERR(e);
+
+			eduom_PaxInitPage(apage, catEntry->fid, pid, nColumns, widths);
+
+			e = eduom_GetUnique(&pid, (SlottedPage*)apage, &unique);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+			e = eduom_FileMapAddPage(catObjForFile, &lastPid, &pid);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+			/* the page may have been a slotted page of the file */
+			eduom_FsmUpdatePage(catObjForFile, &pid, (SlottedPage*)apage);
+		}
+
+		do {
+			record = (char*)data + i * recordLength;
+			for (colStart = 0, c = 0; c < nColumns; colStart += widths[c], c++)
+				memcpy(apage->data + apage->pax.minipage[c] + apage->pax.nRecords * widths[c], record + colStart, widths[c]);
+
+			MAKE_OBJECTID(oids[i], pid.volNo, pid.pageNo, apage->pax.nRecords, apage->header.unique);
+			apage->pax.nRecords++;
+			i++;
+		} while (i < nObjects && apage->pax.nRecords < apage->pax.maxRecords);
+
+		e = BfM_SetDirty(&pid, PAGE_BUF);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+	}
+
+    return(eNOERROR);
+
+} /* EduOM_CreatePaxObjects() */
+
+
+
+/*@================================
+ * eduom_PaxSameColumns()
+ *================================*/
+/*
+ * Function: static Boolean eduom_PaxSameColumns(PaxPage*, Two, Two*)
+ *
+ * Description :
+ *  Return TRUE if the page is a PAX page of the given columns.
+ */
+static Boolean eduom_PaxSameColumns(
+    PaxPage	*apage,		/* IN pointer to the buffer of the page */
+    Two		nColumns,	/* IN # of columns of a record */
+    Two		*widths)	/* IN length of a value of each column */
+{
+    Two		c;		/* column */
+
+
+	if (!IS_PAX_PAGE(apage) || apage->pax.nColumns != nColumns) return(FALSE);
+
+	for (c = 0; c < nColumns; c++)
+		if (apage->pax.width[c] != widths[c]) return(FALSE);
+
+	return(TRUE);
+
+} /* eduom_PaxSameColumns() */
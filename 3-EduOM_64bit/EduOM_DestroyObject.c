@@ -32,11 +32,11 @@
  *  Four EduOM_DestroyObject(ObjectID*, ObjectID*, Pool*, DeallocListElem*)
  */
 
+#include <string.h>
 #include "EduOM_common.h"
 #include "Util.h"		/* to get Pool */
 #include "RDsM.h"
 #include "BfM.h"		/* for the buffer manager call */
-#include "LOT.h"		/* for the large object manager call */
 #include "EduOM_Internal.h"
 
 /*@================================
@@ -59,14 +59,22 @@
  *
  *  (2) How to do?
  *  a. Read in the slotted page
- *  b. Remove this page from the 'availSpaceList'
- *  c. Delete the object from the page
- *  d. Update the control information: 'unused', 'freeStart', 'slot offset'
+ *     IF fixed-length record page THEN
+ *	   Mark the record absent; deallocate the page if it is left empty,
+ *	   otherwise remember that it has room with eduom_FixedRoomAdd()
+ *     ENDIF
+ *  b. IF moved object THEN destroy the forwarded record
+ *     Remember the free space of the page
+ *  c. Delete the object from the page; the trains of a large object are put
+ *     into the dealloc list
+ *  d. Update the control information: 'unused', 'freeStart', 'slot offset',
+ *     and the free slot list
  *  e. IF no more object in this page THEN
- *	   Remove this page from the filemap List
+ *	   Remove this page from the 'availSpaceList' and the filemap List
  *	   Dealloate this page
  *    ELSE
- *	   Put this page into the proper 'availSpaceList'
+ *	   Put this page into the proper 'availSpaceList' if it is changed and
+ *	   update the free space map
  *    ENDIF
  * f. Return
  *
@@ -75,6 +83,7 @@
  *    eBADCATALOGOBJECT_OM
  *    eBADOBJECTID_OM
  *    eBADFILEID_OM
+ *    eNOTSUPPORTED_EDUOM
  *    some errors caused by function calls
  */
 Four EduOM_DestroyObject(
@@ -84,18 +93,18 @@ Four EduOM_DestroyObject(
     DeallocListElem *dlHead)	/* INOUT head of dealloc list */
 {
     Four        e;			/* error number */
-    Two         i;			/* temporary variable */
     FileID      fid;		/* ID of file where the object was placed */
     PageID		pid;		/* page on which the object resides */
     SlottedPage *apage;		/* pointer to the buffer holding the page */
+    FixedPage   *fpage;		/* the page if it is a fixed-length record page */
     Four        offset;		/* start offset of object in data area */
     Object      *obj;		/* points to the object in data area */
     Four        alignedLen;	/* aligned length of object */
     Boolean     last;		/* indicates the object is the last one */
-    SlottedPage *catPage;	/* buffer page containing the catalog object */
     sm_CatOverlayForData *catEntry; /* overlay structure for catalog object access */
     DeallocListElem *dlElem;/* pointer to element of dealloc list */
-    PhysicalFileID pFid;	/* physical ID of file */
+    ObjectID    fwdOid;		/* forwarded record of a moved object */
+    Four        oldFree;	/* free space of the page before the object is deleted */
     
     
 
@@ -107,54 +116,96 @@ Four EduOM_DestroyObject(
 	MAKE_PAGEID(pid, oid->volNo, oid->pageNo);
 	e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
 	if (e<0) ERR(e);
-	e = om_RemoveFromAvailSpaceList(catObjForFile, &pid, apage);
-	if (e<0) ERR(e);
+
+	/* the records of a PAX page are not destroyed one by one */
+	if (IS_PAX_PAGE(apage)) ERRB1(eNOTSUPPORTED_EDUOM, &pid, PAGE_BUF);
+
+	if (IS_FIXED_PAGE(apage)) {
+		fpage = (FixedPage*)apage;
+		if (!FIXED_IS_VALID_OBJECTID(oid, fpage)) ERRB1(eBADOBJECTID_OM, &pid, PAGE_BUF);
+
+		eduom_FixedFreeRecord(fpage, oid->slotNo);
+
+		e = BfM_SetDirty(&pid, PAGE_BUF);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+		e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+		/* the page is in no available space list */
+		if (fpage->fixed.nRecords == 0 && pid.pageNo != catEntry->firstPage) {
+			e = eduom_FileMapDeletePage(catObjForFile, &pid);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+			eduom_FsmRemovePage(catObjForFile, &pid);
+			e = Util_getElementFromPool(dlPool, &dlElem);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+			dlElem->type = DL_PAGE;
+			dlElem->elem.pid = pid;
+			dlElem->next = dlHead->next;
+			dlHead->next = dlElem;
+			eduom_FixedRoomRemove(catObjForFile, pid.pageNo);
+		}
+		else
+			eduom_FixedRoomAdd(catObjForFile, pid.pageNo, fpage->fixed.length);
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		return(eNOERROR);
+	}
 
 	offset = apage->slot[-1*oid->slotNo].offset;
 	obj = apage->data + offset;
-	alignedLen = sizeof(ObjectHdr) + ALIGNED_LENGTH(obj->header.length);
-	apage->slot[-1*oid->slotNo].offset = EMPTYSLOT;
 
-	if (oid->slotNo+1 == apage->header.nSlots)
-		apage->header.nSlots--;
+	if (obj->header.properties & P_MOVED) {
+		memcpy(&fwdOid, obj->data, sizeof(ObjectID));
+		e = EduOM_DestroyObject(catObjForFile, &fwdOid, dlPool, dlHead);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+	}
+
+	oldFree = SP_FREE(apage);
+
+	alignedLen = sizeof(ObjectHdr) + ALIGNED_LENGTH(OBJ_LENGTH_IN_PAGE(obj));
+
+	if (obj->header.properties & P_LRGOBJ) {
+		e = eduom_LotDestroy(obj, pid.volNo, dlPool, dlHead);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+	}
+
+	eduom_FreeSlot(apage, oid->slotNo);
 
 	if (offset + alignedLen == apage->header.free)
 		apage->header.free -= alignedLen;
 	else
 		apage->header.unused += alignedLen;
+
+	e = BfM_SetDirty(&pid, PAGE_BUF);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
 		
-	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
-	e = BfM_GetTrain(&pFid, &catPage, PAGE_BUF);
-	if (e<0) ERR(e);
-	GET_PTR_TO_CATENTRY_FOR_DATA(catObjForFile, catPage, catEntry);
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
 	fid = catEntry->fid;
 	
-	last = 0;
-	for (i=0; i<apage->header.nSlots; i++) {
-		if (apage->slot[-1*i].offset != EMPTYSLOT)
-			break;
-	}
-	if (i == apage->header.nSlots)
-		last = 1;
+	last = (apage->header.nSlots == 0);
 	
 	if (last && pid.pageNo != catEntry->firstPage) {
-		e = om_FileMapDeletePage(catObjForFile, &pid);
+		e = eduom_RemoveFromAvailSpaceList(catObjForFile, &pid, apage, oldFree);
 		if (e<0) ERR(e);
-		dlElem = dlHead;
-		e = Util_getElementFromPool(dlPool, dlElem);
+		e = eduom_FileMapDeletePage(catObjForFile, &pid);
+		if (e<0) ERR(e);
+		eduom_FsmRemovePage(catObjForFile, &pid);
+		e = Util_getElementFromPool(dlPool, &dlElem);
 		if (e<0) ERR(e);
 		dlElem->type = DL_PAGE;
 		dlElem->elem.pid = pid;
-		dlElem->next = dlHead;
-		dlHead = dlElem;
+		dlElem->next = dlHead->next;
+		dlHead->next = dlElem;
 	}
 	else {
-		e = om_PutInAvailSpaceList(catObjForFile, &pid, apage);
+		e = eduom_PutInAvailSpaceList(catObjForFile, &pid, apage, oldFree);
 		if (e<0) ERR(e);
 	}
     
-	e = BfM_FreeTrain(&pFid, PAGE_BUF);
-	if (e<0) ERR(e);
 	e = BfM_FreeTrain(&pid, PAGE_BUF);
 	if (e<0) ERR(e);
 
@@ -0,0 +1,249 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : EduOM_DestroyObjects.c
+ * 
+ * Description : 
+ *  EduOM_DestroyObjects() destroys a set of objects of a file.
+ *
+ * Exports:
+ *  Four EduOM_DestroyObjects(ObjectID*, Four, ObjectID*, Pool*, DeallocListElem*)
+ */
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "Util.h"		/* to get Pool */
+#include "RDsM.h"
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+
+/*@================================
+ * EduOM_DestroyObjects()
+ *================================*/
+/*
+ * Function: Four EduOM_DestroyObjects(ObjectID*, Four, ObjectID*, Pool*, DeallocListElem*)
+ * 
+ * Description : 
+ *  (1) What to do?
+ *  EduOM_DestroyObjects() destroys 'nObjects' objects of the file. The
+ *  objects which lie on the same page next to each other in 'oids' are
+ *  destroyed under a single fix of the page, and the available space list,
+ *  the free space map and the file map are updated once for them; a page
+ *  left empty is deallocated at once. The objects are best given in the
+ *  order of their pages, e.g. as a scan returns them.
+ *  Unlike EduOM_DestroyObject(), the object IDs are checked, so an object
+ *  given twice is reported instead of being destroyed twice.
+ *
+ *  (2) How to do?
+ *  a. FOR each run of objects on the same page
+ *	   Read in the page
+ *	   IF fixed-length record page THEN
+ *	       Mark the records absent
+ *	       Deallocate the page if it is left empty, otherwise remember that
+ *	       it has room with eduom_FixedRoomAdd()
+ *	   ELSE
+ *	       FOR each object of the run
+ *	           IF moved object THEN destroy the forwarded record
+ *	           Delete the object from the page; the trains of a large
+ *	           object are put into the dealloc list
+ *	       ENDFOR
+ *	       IF no more object in this page THEN
+ *	           Remove this page from the 'availSpaceList' and the filemap List
+ *	           Dealloate this page
+ *	       ELSE
+ *	           Put this page into the proper 'availSpaceList' if it is
+ *	           changed and update the free space map
+ *	       ENDIF
+ *	   ENDIF
+ *     ENDFOR
+ *  b. Return
+ *
+ * Returns:
+ *  error code
+ *    eBADCATALOGOBJECT_OM
+ *    eBADOBJECTID_OM
+ *    eBADLENGTH_OM
+ *    eNOTSUPPORTED_EDUOM
+ *    some errors caused by function calls
+ *
+ * Note:
+ *  On an error, the objects given before the object in error have been
+ *  destroyed and the others have not.
+ */
+Four EduOM_DestroyObjects(
+    ObjectID *catObjForFile,	/* IN file containing the objects */
+    Four     nObjects,			/* IN # of objects to destroy */
+    ObjectID *oids,				/* IN objects to destroy */
+    Pool     *dlPool,			/* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)	/* INOUT head of dealloc list */
+{
+    Four        e;			/* error number */
+    Four        eObj;		/* error of the object in error, if any */
+    PageID		pid;		/* page of the current run */
+    SlottedPage *apage;		/* pointer to the buffer holding the page */
+    FixedPage   *fpage;		/* the page if it is a fixed-length record page */
+    Four        first, end;	/* the run is oids[first .. end-1] */
+    Four        k;			/* index of 'oids' */
+    ObjectID    *oid;		/* object being destroyed */
+    Four        offset;		/* start offset of object in data area */
+    Object      *obj;		/* points to the object in data area */
+    Four        alignedLen;	/* aligned length of object */
+    sm_CatOverlayForData *catEntry; /* overlay structure for catalog object access */
+    DeallocListElem *dlElem;/* pointer to element of dealloc list */
+    ObjectID    fwdOid;		/* forwarded record of a moved object */
+    Four        oldFree;	/* free space of the page before the objects are deleted */
+
+
+
+    /*@ Check parameters. */
+    if (catObjForFile == NULL) ERR(eBADCATALOGOBJECT_OM);
+
+    if (nObjects < 0) ERR(eBADLENGTH_OM);
+
+    if (nObjects > 0 && oids == NULL) ERR(eBADOBJECTID_OM);
+
+	for (first = 0; first < nObjects; first = end) {
+
+		for (end = first + 1; end < nObjects &&
+			 oids[end].volNo == oids[first].volNo && oids[end].pageNo == oids[first].pageNo; end++);
+
+		MAKE_PAGEID(pid, oids[first].volNo, oids[first].pageNo);
+		e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		/* the records of a PAX page are not destroyed one by one */
+		if (IS_PAX_PAGE(apage)) ERRB1(eNOTSUPPORTED_EDUOM, &pid, PAGE_BUF);
+
+		eObj = eNOERROR;
+
+		if (IS_FIXED_PAGE(apage)) {
+			fpage = (FixedPage*)apage;
+
+			for (k = first; k < end; k++) {
+				if (!FIXED_IS_VALID_OBJECTID(&oids[k], fpage)) {
+					eObj = eBADOBJECTID_OM;
+					break;
+				}
+				eduom_FixedFreeRecord(fpage, oids[k].slotNo);
+			}
+
+			e = BfM_SetDirty(&pid, PAGE_BUF);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+			e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+			/* the page is in no available space list */
+			if (fpage->fixed.nRecords == 0 && pid.pageNo != catEntry->firstPage) {
+				e = eduom_FileMapDeletePage(catObjForFile, &pid);
+				if (e<0) ERRB1(e, &pid, PAGE_BUF);
+				eduom_FsmRemovePage(catObjForFile, &pid);
+				e = Util_getElementFromPool(dlPool, &dlElem);
+				if (e<0) ERRB1(e, &pid, PAGE_BUF);
+				dlElem->type = DL_PAGE;
+				dlElem->elem.pid = pid;
+				dlElem->next = dlHead->next;
+				dlHead->next = dlElem;
+				eduom_FixedRoomRemove(catObjForFile, pid.pageNo);
+			}
+			else
+				eduom_FixedRoomAdd(catObjForFile, pid.pageNo, fpage->fixed.length);
+
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+			if (e<0) ERR(e);
+
+			if (eObj<0) ERR(eObj);
+
+			continue;
+		}
+
+		oldFree = SP_FREE(apage);
+
+		for (k = first; k < end; k++) {
+			oid = &oids[k];
+			if (oid->slotNo < 0 || oid->slotNo >= apage->header.nSlots || !IS_VALID_OBJECTID(oid, apage)) {
+				eObj = eBADOBJECTID_OM;
+				break;
+			}
+
+			offset = apage->slot[-1*oid->slotNo].offset;
+			obj = apage->data + offset;
+
+			if (obj->header.properties & P_MOVED) {
+				memcpy(&fwdOid, obj->data, sizeof(ObjectID));
+				eObj = EduOM_DestroyObject(catObjForFile, &fwdOid, dlPool, dlHead);
+				if (eObj<0) break;
+				/* the forwarded record was on this page: the lists are up to date now */
+				if (fwdOid.volNo == pid.volNo && fwdOid.pageNo == pid.pageNo) oldFree = SP_FREE(apage);
+			}
+
+			alignedLen = sizeof(ObjectHdr) + ALIGNED_LENGTH(OBJ_LENGTH_IN_PAGE(obj));
+
+			if (obj->header.properties & P_LRGOBJ) {
+				eObj = eduom_LotDestroy(obj, pid.volNo, dlPool, dlHead);
+				if (eObj<0) break;
+			}
+
+			eduom_FreeSlot(apage, oid->slotNo);
+
+			if (offset + alignedLen == apage->header.free)
+				apage->header.free -= alignedLen;
+			else
+				apage->header.unused += alignedLen;
+		}
+
+		e = BfM_SetDirty(&pid, PAGE_BUF);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+		e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+		if (apage->header.nSlots == 0 && pid.pageNo != catEntry->firstPage) {
+			e = eduom_RemoveFromAvailSpaceList(catObjForFile, &pid, apage, oldFree);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+			e = eduom_FileMapDeletePage(catObjForFile, &pid);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+			eduom_FsmRemovePage(catObjForFile, &pid);
+			e = Util_getElementFromPool(dlPool, &dlElem);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+			dlElem->type = DL_PAGE;
+			dlElem->elem.pid = pid;
+			dlElem->next = dlHead->next;
+			dlHead->next = dlElem;
+		}
+		else {
+			e = eduom_PutInAvailSpaceList(catObjForFile, &pid, apage, oldFree);
+			if (e<0) ERRB1(e, &pid, PAGE_BUF);
+		}
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		if (eObj<0) ERR(eObj);
+	}
+
+    return(eNOERROR);
+    
+} /* EduOM_DestroyObjects() */
@@ -51,6 +51,13 @@
  *  same page which has the current Object and  if there  is no next Object in
  *  the same page, find it from the next page. If the Current Object is NULL,
  *  return the first Object of the file.
+ *  The forwarded records are skipped since they are reached through the
+ *  stubs of the moved objects; the header returned for a moved object is
+ *  the header of its forwarded record.
+ *  The present records of a fixed-length record page are found in its
+ *  bitmap; their header has no property and no tag.
+ *  The records of a PAX page are not returned; the page has no slot, so it
+ *  is passed over. They are read by a PAX scan (EduOM_PaxOpenScan()).
  *
  * Returns:
  *  error code
@@ -78,8 +85,6 @@ Four EduOM_NextObject(
 	VolNo volNo;
     SlottedPage *apage;		/* a pointer to the data page */
     Object *obj;			/* a pointer to the Object */
-    PhysicalFileID pFid;	/* file in which the objects are located */
-    SlottedPage *catPage;	/* buffer page containing the catalog object */
     sm_CatOverlayForData *catEntry; /* data structure for catalog object access */
 
 
@@ -91,10 +96,8 @@ Four EduOM_NextObject(
     
     if (nextOID == NULL) ERR(eBADOBJECTID_OM);
 
-	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
-	e = BfM_GetTrain(&pFid, &catPage, PAGE_BUF);
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
 	if (e<0) ERR(e);
-	GET_PTR_TO_CATENTRY_FOR_DATA(catObjForFile, catPage, catEntry);
 	
 	if (curOID == NULL) {
 		volNo = catEntry->fid.volNo;
@@ -115,41 +118,58 @@ Four EduOM_NextObject(
 		i = curOID->slotNo+1;
 	}
 	while (1) {
-		for (; i<apage->header.nSlots; i++) {
-			if (apage->slot[-1*i].offset != EMPTYSLOT)
+		if (IS_FIXED_PAGE(apage)) {
+			i = eduom_FixedNextRecord((FixedPage*)apage, i);
+			if (i != NIL) {
+				MAKE_OBJECTID(*nextOID, volNo, pageNo, i, FIXED_UNIQUE((FixedPage*)apage, i));
 				break;
-		}
-		if (i >= 0) {
-			MAKE_OBJECTID(*nextOID, volNo, pageNo, i, apage->slot[-1*i].unique);
-			break;
+			}
 		}
 		else {
-			e = BfM_FreeTrain(&pid, PAGE_BUF);
-			if (e<0) ERR(e);
-			if (pageNo == catEntry->lastPage) {
-				e = BfM_FreeTrain(&pFid, PAGE_BUF);
-				if (e<0) ERR(e);
-				return(EOS);
+			for (; i<apage->header.nSlots; i++) {
+				if (apage->slot[-1*i].offset != EMPTYSLOT && !SP_IS_FORWARDED(apage, i))
+					break;
 			}
-			else {
-				pageNo = apage->header.nextPage;
-				MAKE_PAGEID(pid, volNo, pageNo);
-		        e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
-				if (e<0) ERR(e);
-				i = 0;
+			if (i < apage->header.nSlots) {
+				MAKE_OBJECTID(*nextOID, volNo, pageNo, i, apage->slot[-1*i].unique);
+				break;
 			}
-		}	
+		}
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+		if (pageNo == catEntry->lastPage) {
+			return(EOS);
+		}
+		else {
+			pageNo = apage->header.nextPage;
+			MAKE_PAGEID(pid, volNo, pageNo);
+			e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+			if (e<0) ERR(e);
+			i = 0;
+		}
 	}
 	
-	offset = apage->slot[-1*i].offset;
-	obj = apage->data + offset;
-	objHdr = &obj->header;
+	if (IS_FIXED_PAGE(apage)) {
+		if (objHdr != NULL) {
+			objHdr->properties = 0;
+			objHdr->tag = 0;
+			objHdr->length = ((FixedPage*)apage)->fixed.length;
+		}
+	}
+	else if (objHdr != NULL) {
+		offset = apage->slot[-1*i].offset;
+		obj = apage->data + offset;
+		/* the header of a moved object is in the forwarded record */
+		e = eduom_FollowForward(&pid, &apage, &obj);
+		if (e<0) ERR(e);
+		*objHdr = obj->header;
+		objHdr->properties &= ~P_FORWARDED;
+	}
 
 	e = BfM_FreeTrain(&pid, PAGE_BUF);
 	if (e<0) ERR(e);
-	e = BfM_FreeTrain(&pFid, PAGE_BUF);
-	if (e<0) ERR(e);
 
-    return(EOS);		/* end of scan */
+    return(eNOERROR);
     
 } /* EduOM_NextObject() */
@@ -0,0 +1,104 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduOM_OpenScan.c
+ *
+ * Description:
+ *  Open a sequential scan cursor of a data file.
+ *
+ * Export:
+ *  Four EduOM_OpenScan(ObjectID*, Four, EduOM_ScanCursor*)
+ */
+
+
+#include "EduOM_common.h"
+#include "BfM.h"
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+/*@================================
+ * EduOM_OpenScan()
+ *================================*/
+/*
+ * Function: Four EduOM_OpenScan(ObjectID*, Four, EduOM_ScanCursor*)
+ *
+ * Description:
+ *  Open a cursor which scans the objects of the data file in the order of
+ *  EduOM_NextObject(). The objects are returned by EduOM_ScanNext(); the
+ *  cursor keeps the current page fixed while its slots are returned, so a
+ *  page is fixed once per scan instead of once per object. 'readAhead'
+ *  pages following the current page are read into the buffer pool ahead
+ *  of the scan. The objects returned may be restricted by
+ *  EduOM_SetScanPredicate() and EduOM_SetScanFilter(), which are evaluated
+ *  in place. The cursor is closed by EduOM_CloseScan().
+ *  The file should not be updated while it is scanned by the cursor.
+ *
+ * Returns:
+ *  error code
+ *    eBADCATALOGOBJECT_OM
+ *    eBADPARAMETER_OM
+ *    some errors caused by function calls
+ *
+ * Side effect:
+ *  1) parameter cursor
+ *     cursor is positioned before the first object of the file
+ */
+Four EduOM_OpenScan(
+    ObjectID  *catObjForFile,	/* IN informations about a data file */
+    Four      readAhead,		/* IN # of pages to read ahead */
+    EduOM_ScanCursor *cursor)	/* OUT the scan cursor */
+{
+    Four e;					/* error */
+    sm_CatOverlayForData *catEntry; /* data structure for catalog object access */
+
+
+
+    /*@
+     * parameter checking
+     */
+    if (catObjForFile == NULL) ERR(eBADCATALOGOBJECT_OM);
+
+    if (readAhead < 0 || cursor == NULL) ERR(eBADPARAMETER_OM);
+
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+	if (e<0) ERR(e);
+
+	MAKE_PAGEID(cursor->pid, catEntry->fid.volNo, catEntry->firstPage);
+	cursor->apage = NULL;
+	cursor->slotNo = -1;
+	cursor->lastPage = catEntry->lastPage;
+	cursor->readAhead = readAhead;
+	cursor->nAhead = 0;
+	cursor->aheadNext = NIL;
+	cursor->predLen = 0;
+	cursor->filter = NULL;
+	cursor->filterArg = NULL;
+	cursor->latch = NULL;
+	cursor->fwdPid.volNo = catEntry->fid.volNo;
+	cursor->fwdPid.pageNo = NIL;
+
+    return(eNOERROR);
+    
+} /* EduOM_OpenScan() */
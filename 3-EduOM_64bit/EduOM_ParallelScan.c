@@ -0,0 +1,311 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduOM_ParallelScan.c
+ *
+ * Description:
+ *  Scan a data file by a pool of worker threads.
+ *
+ * Export:
+ *  Four EduOM_ParallelScan(ObjectID*, Four, EduOM_ScanPredicate*, EduOM_ScanFilter, void*, Four, ObjectID*, Four*)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduOM_common.h"
+#include "BfM.h"
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+
+/*@
+ * Type Definitions
+ */
+/* state shared by the workers; the fields are accessed with 'latch' held */
+typedef struct {
+    pthread_mutex_t latch;	/* also serializes the buffer manager calls */
+    VolNo       volNo;		/* volume of the file */
+    PageNo      next;		/* next page to scan; NIL if none */
+    PageNo      lastPage;	/* last page of the file */
+    Four        nextSeq;	/* sequence # of the next page in the file */
+    Four        e;			/* first error of the workers */
+    EduOM_ScanCursor *proto; /* cursor holding the predicate and the filter */
+} eduom_PScanState;
+
+/* a worker and the objects it selected, in the order of the file */
+typedef struct {
+    pthread_t   thread;
+    eduom_PScanState *state;
+    Four        nOids;		/* # of objects selected */
+    Four        size;		/* # of entries allocated */
+    Four        *seqs;		/* sequence # of the page of each object */
+    ObjectID    *oids;		/* the objects selected */
+} eduom_PScanWorker;
+
+
+static void *eduom_PScanWorkerMain(void*);
+
+
+
+/*@================================
+ * EduOM_ParallelScan()
+ *================================*/
+/*
+ * Function: Four EduOM_ParallelScan(ObjectID*, Four, EduOM_ScanPredicate*, EduOM_ScanFilter, void*, Four, ObjectID*, Four*)
+ *
+ * Description:
+ *  (1) What to do?
+ *  EduOM_ParallelScan() scans the data file by 'nWorkers' threads and
+ *  returns the objects satisfying 'pred' and 'filter' (see
+ *  EduOM_SetScanPredicate() and EduOM_SetScanFilter()) in the order of
+ *  EduOM_NextObject(). Either of them may be NULL. The filter is called
+ *  concurrently by the workers and must be safe to do so.
+ *
+ *  (2) How to do?
+ *  The page chain of a file can be followed only page by page, so the pages
+ *  are handed out to the workers one at a time in the order of the chain:
+ *  a worker fixes the next page, advances the chain with its 'nextPage',
+ *  and scans the page with its own scan cursor. The buffer manager is not
+ *  reentrant; its calls are serialized by a latch, which is held only to
+ *  fix and unfix a page, while the objects are evaluated in parallel.
+ *  Each worker keeps the objects it selects with the sequence # of their
+ *  page, and the lists of the workers are merged by the sequence #.
+ *
+ * Returns:
+ *  error code
+ *    eBADCATALOGOBJECT_OM
+ *    eBADPARAMETER_OM
+ *    eMEMORYALLOCERR_EDUOM
+ *    some errors caused by function calls
+ *
+ * Side effect:
+ *  1) parameter oids
+ *     the first 'maxOids' objects selected are returned in oids
+ *  2) parameter nOids
+ *     nOids is set to the # of objects selected, which may exceed 'maxOids'
+ */
+Four EduOM_ParallelScan(
+    ObjectID  *catObjForFile,	/* IN informations about a data file */
+    Four      nWorkers,			/* IN # of worker threads */
+    EduOM_ScanPredicate *pred,	/* IN predicate of the objects, or NULL */
+    EduOM_ScanFilter filter,	/* IN filter of the objects, or NULL */
+    void      *filterArg,		/* IN argument passed to the filter */
+    Four      maxOids,			/* IN # of entries of 'oids' */
+    ObjectID  *oids,			/* OUT the objects selected */
+    Four      *nOids)			/* OUT # of objects selected */
+{
+    Four e;					/* error */
+    Four i, w;				/* index variables */
+    Four nStarted;			/* # of workers started */
+    Four minW;				/* worker having the page of the smallest sequence # */
+    Four seq;				/* sequence # of the page being merged */
+    Four *next;				/* next entry of each worker to merge */
+    eduom_PScanState state;	/* state shared by the workers */
+    eduom_PScanWorker *workers; /* the workers */
+    EduOM_ScanCursor proto;	/* cursor holding the predicate and the filter */
+    sm_CatOverlayForData *catEntry; /* data structure for catalog object access */
+
+
+
+    /*@
+     * parameter checking
+     */
+    if (catObjForFile == NULL) ERR(eBADCATALOGOBJECT_OM);
+
+    if (nWorkers < 1 || nWorkers > EDUOM_MAX_SCAN_WORKERS) ERR(eBADPARAMETER_OM);
+
+    if (maxOids < 0 || (maxOids > 0 && oids == NULL) || nOids == NULL) ERR(eBADPARAMETER_OM);
+
+	/* the predicate is checked and compiled once for the workers */
+	proto.predLen = 0;
+	e = EduOM_SetScanPredicate(&proto, pred);
+	if (e<0) ERR(e);
+	e = EduOM_SetScanFilter(&proto, filter, filterArg);
+	if (e<0) ERR(e);
+
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+	if (e<0) ERR(e);
+
+	state.volNo = catEntry->fid.volNo;
+	state.next = catEntry->firstPage;
+	state.lastPage = catEntry->lastPage;
+	state.nextSeq = 0;
+	state.e = eNOERROR;
+	state.proto = &proto;
+
+	workers = (eduom_PScanWorker*)calloc(nWorkers, sizeof(eduom_PScanWorker));
+	next = (Four*)calloc(nWorkers, sizeof(Four));
+	if (workers == NULL || next == NULL) {
+		free(workers); free(next);
+		ERR(eMEMORYALLOCERR_EDUOM);
+	}
+
+	pthread_mutex_init(&state.latch, NULL);
+
+	for (nStarted = 0; nStarted < nWorkers; nStarted++) {
+		workers[nStarted].state = &state;
+		if (pthread_create(&workers[nStarted].thread, NULL, eduom_PScanWorkerMain, &workers[nStarted]) != 0)
+			break;
+	}
+	/* the workers started scan the whole file */
+	if (nStarted == 0) eduom_PScanWorkerMain(&workers[0]);
+
+	for (w = 0; w < nStarted; w++)
+		pthread_join(workers[w].thread, NULL);
+
+	pthread_mutex_destroy(&state.latch);
+
+	/* merge the objects selected by the workers in the order of the pages */
+	*nOids = 0;
+	if (state.e >= eNOERROR) {
+		while (1) {
+			minW = NIL;
+			for (w = 0; w < nWorkers; w++) {
+				if (next[w] < workers[w].nOids &&
+					(minW == NIL || workers[w].seqs[next[w]] < workers[minW].seqs[next[minW]]))
+					minW = w;
+			}
+			if (minW == NIL) break;
+
+			seq = workers[minW].seqs[next[minW]];
+			for (i = next[minW]; i < workers[minW].nOids && workers[minW].seqs[i] == seq; i++) {
+				if (*nOids < maxOids) oids[*nOids] = workers[minW].oids[i];
+				(*nOids)++;
+			}
+			next[minW] = i;
+		}
+	}
+
+	for (w = 0; w < nWorkers; w++) {
+		free(workers[w].seqs);
+		free(workers[w].oids);
+	}
+	free(workers);
+	free(next);
+
+	if (state.e < eNOERROR) ERR(state.e);
+
+    return(eNOERROR);
+    
+} /* EduOM_ParallelScan() */
+
+
+
+/*@================================
+ * eduom_PScanWorkerMain()
+ *================================*/
+/*
+ * Function: static void *eduom_PScanWorkerMain(void*)
+ *
+ * Description:
+ *  Body of a worker of EduOM_ParallelScan(). Take the next page of the file,
+ *  scan it with the cursor of the worker and keep the objects selected,
+ *  until there is no more page or a worker fails; the error is kept in the
+ *  shared state. The cursor is closed on every exit, so that no page stays
+ *  fixed after an error.
+ *
+ * Returns:
+ *  NULL
+ */
+static void *eduom_PScanWorkerMain(
+    void      *arg)				/* INOUT the worker */
+{
+    Four e;					/* error */
+    Four seq;				/* sequence # of the page */
+    eduom_PScanWorker *worker = (eduom_PScanWorker*)arg;
+    eduom_PScanState *state = worker->state;
+    EduOM_ScanCursor cursor;	/* cursor of the worker */
+    ObjectID oid;			/* object selected */
+    Four *seqs;				/* reallocated entries */
+    ObjectID *oids;
+
+
+	cursor = *state->proto;
+	cursor.latch = &state->latch;
+	cursor.readAhead = 0;
+	cursor.nAhead = 0;
+	cursor.aheadNext = NIL;
+	cursor.fwdPid.pageNo = NIL;
+	cursor.apage = NULL;
+
+	while (1) {
+		pthread_mutex_lock(&state->latch);
+		if (state->next == NIL || state->e < eNOERROR) {
+			pthread_mutex_unlock(&state->latch);
+			break;
+		}
+		MAKE_PAGEID(cursor.pid, state->volNo, state->next);
+		e = BfM_GetTrain(&cursor.pid, &cursor.apage, PAGE_BUF);
+		if (e < eNOERROR) {
+			cursor.apage = NULL;
+			state->e = e;
+			pthread_mutex_unlock(&state->latch);
+			break;
+		}
+		state->next = (cursor.pid.pageNo == state->lastPage) ? NIL : cursor.apage->header.nextPage;
+		seq = state->nextSeq++;
+		pthread_mutex_unlock(&state->latch);
+
+		/* the cursor scans the fixed page only and unfixes it at its end */
+		cursor.slotNo = -1;
+		cursor.lastPage = cursor.pid.pageNo;
+
+		while ((e = EduOM_ScanNext(&cursor, &oid, NULL, NULL)) == eNOERROR) {
+			if (worker->nOids == worker->size) {
+				worker->size = (worker->size == 0) ? 256 : worker->size * 2;
+				seqs = (Four*)realloc(worker->seqs, sizeof(Four) * worker->size);
+				if (seqs != NULL) worker->seqs = seqs;
+				oids = (ObjectID*)realloc(worker->oids, sizeof(ObjectID) * worker->size);
+				if (oids != NULL) worker->oids = oids;
+				if (seqs == NULL || oids == NULL) {
+					e = eMEMORYALLOCERR_EDUOM;
+					break;
+				}
+			}
+			worker->seqs[worker->nOids] = seq;
+			worker->oids[worker->nOids] = oid;
+			worker->nOids++;
+		}
+
+		if (e < eNOERROR) {
+			pthread_mutex_lock(&state->latch);
+			if (state->e >= eNOERROR) state->e = e;
+			pthread_mutex_unlock(&state->latch);
+			break;
+		}
+	}
+
+	/* after an error, the cursor may still hold the page and a forwarded one */
+	e = EduOM_CloseScan(&cursor);
+	if (e < eNOERROR) {
+		pthread_mutex_lock(&state->latch);
+		if (state->e >= eNOERROR) state->e = e;
+		pthread_mutex_unlock(&state->latch);
+	}
+
+	return(NULL);
+
+} /* eduom_PScanWorkerMain() */
@@ -0,0 +1,99 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduOM_PaxOpenScan.c
+ *
+ * Description:
+ *  Open a projection scan cursor of the PAX pages of a data file.
+ *
+ * Export:
+ *  Four EduOM_PaxOpenScan(ObjectID*, Two, Two*, EduOM_PaxCursor*)
+ */
+
+
+#include "EduOM_common.h"
+#include "BfM.h"
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+/*@================================
+ * EduOM_PaxOpenScan()
+ *================================*/
+/*
+ * Function: Four EduOM_PaxOpenScan(ObjectID*, Two, Two*, EduOM_PaxCursor*)
+ *
+ * Description:
+ *  Open a cursor which scans the given columns of the records of the PAX
+ *  pages of the data file, in the order of the pages; the slotted pages of
+ *  the file are skipped. EduOM_PaxScanNext() returns the records of a page
+ *  at a time as a vector per column, in place in the minipages of the
+ *  columns, so the minipages of the other columns are not touched. The
+ *  cursor is closed by EduOM_PaxCloseScan().
+ *  The file should not be updated while it is scanned by the cursor.
+ *
+ * Returns:
+ *  error code
+ *    eBADCATALOGOBJECT_OM
+ *    eBADPARAMETER_OM
+ *    some errors caused by function calls
+ *
+ * Side effect:
+ *  1) parameter cursor
+ *     cursor is positioned before the first PAX page of the file
+ */
+Four EduOM_PaxOpenScan(
+    ObjectID  *catObjForFile,	/* IN informations about a data file */
+    Two       nColumns,			/* IN # of columns to return */
+    Two       *columns,			/* IN columns to return, in the order returned */
+    EduOM_PaxCursor *cursor)	/* OUT the scan cursor */
+{
+    Four e;					/* error */
+    Two  k;					/* index of 'columns' */
+    sm_CatOverlayForData *catEntry; /* data structure for catalog object access */
+
+
+
+    /*@
+     * parameter checking
+     */
+    if (catObjForFile == NULL) ERR(eBADCATALOGOBJECT_OM);
+
+    if (nColumns < 1 || nColumns > PAX_MAX_COLUMNS || columns == NULL || cursor == NULL) ERR(eBADPARAMETER_OM);
+
+    for (k = 0; k < nColumns; k++)
+		if (columns[k] < 0 || columns[k] >= PAX_MAX_COLUMNS) ERR(eBADPARAMETER_OM);
+
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+	if (e<0) ERR(e);
+
+	MAKE_PAGEID(cursor->pid, catEntry->fid.volNo, catEntry->firstPage);
+	cursor->apage = NULL;
+	cursor->lastPage = catEntry->lastPage;
+	cursor->nColumns = nColumns;
+	for (k = 0; k < nColumns; k++) cursor->columns[k] = columns[k];
+
+    return(eNOERROR);
+    
+} /* EduOM_PaxOpenScan() */
@@ -0,0 +1,123 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduOM_PaxScanNext.c
+ *
+ * Description:
+ *  Return the records of the next PAX page of a projection scan cursor.
+ *
+ * Export:
+ *  Four EduOM_PaxScanNext(EduOM_PaxCursor*, ObjectID*, Four*, char**)
+ */
+
+
+#include "EduOM_common.h"
+#include "BfM.h"
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+/*@================================
+ * EduOM_PaxScanNext()
+ *================================*/
+/*
+ * Function: Four EduOM_PaxScanNext(EduOM_PaxCursor*, ObjectID*, Four*, char**)
+ *
+ * Description:
+ *  Unfix the current page and fix the next PAX page of the file having
+ *  records; return the # of its records and, for the k-th column of the
+ *  cursor, the minipage of the column in 'values[k]': the value of the
+ *  i-th record of the page is at 'values[k] + i * width' where 'width' is
+ *  the length of a value of the column. The values are returned in place;
+ *  they are valid until the next call on the cursor and must not be
+ *  modified. The i-th record of the page is the object whose slot number is
+ *  that of 'firstOid' plus i.
+ *
+ * Returns:
+ *  1) eNOERROR
+ *  2) EOS if there is no more PAX page
+ *  3) error code
+ *    eBADPARAMETER_OM
+ *    some errors caused by function calls
+ *
+ * Side effect:
+ *  1) parameter firstOid
+ *     firstOid is filled with the identifier of the first record of the
+ *     page if it is not NULL
+ */
+Four EduOM_PaxScanNext(
+    EduOM_PaxCursor *cursor,	/* INOUT the scan cursor */
+    ObjectID  *firstOid,		/* OUT first record of the page */
+    Four      *nObjects,		/* OUT # of records of the page */
+    char      **values)			/* OUT minipage of each column of the cursor */
+{
+    Four e;					/* error */
+    Two  k;					/* index of the columns of the cursor */
+    PaxPage *apage;			/* pointer to the buffer of the page */
+    PageNo nextPage;		/* page following the current page */
+
+
+
+    /*@
+     * parameter checking
+     */
+    if (cursor == NULL || nObjects == NULL || values == NULL) ERR(eBADPARAMETER_OM);
+
+	if (cursor->apage != NULL) {
+		nextPage = (cursor->pid.pageNo == cursor->lastPage) ? NIL : cursor->apage->header.nextPage;
+		e = BfM_FreeTrain(&cursor->pid, PAGE_BUF);
+		if (e<0) ERR(e);
+		cursor->apage = NULL;
+		cursor->pid.pageNo = nextPage;
+	}
+
+	/* the slotted pages and the empty PAX pages are skipped */
+	while (cursor->pid.pageNo != NIL) {
+		e = BfM_GetTrain(&cursor->pid, (char **)&apage, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		if (IS_PAX_PAGE(apage) && apage->pax.nRecords > 0) break;
+
+		nextPage = (cursor->pid.pageNo == cursor->lastPage) ? NIL : apage->header.nextPage;
+		e = BfM_FreeTrain(&cursor->pid, PAGE_BUF);
+		if (e<0) ERR(e);
+		cursor->pid.pageNo = nextPage;
+	}
+
+	if (cursor->pid.pageNo == NIL) return(EOS);
+
+	cursor->apage = apage;
+
+	for (k = 0; k < cursor->nColumns; k++) {
+		if (cursor->columns[k] >= apage->pax.nColumns) ERR(eBADPARAMETER_OM);
+		values[k] = apage->data + apage->pax.minipage[cursor->columns[k]];
+	}
+
+	*nObjects = apage->pax.nRecords;
+	if (firstOid != NULL)
+		MAKE_OBJECTID(*firstOid, cursor->pid.volNo, cursor->pid.pageNo, 0, apage->header.unique);
+
+    return(eNOERROR);
+    
+} /* EduOM_PaxScanNext() */
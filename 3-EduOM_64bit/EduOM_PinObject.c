@@ -0,0 +1,126 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : EduOM_PinObject.c
+ * 
+ * Description : 
+ *  EduOM_PinObject() returns a pointer to the object identified by 'oid'
+ *  in the buffer pool, without copying it.
+ *
+ * Exports:
+ *  Four EduOM_PinObject(ObjectID*, char**, Four*, EduOM_PinHandle*)
+ */
+
+
+#include "EduOM_common.h"
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+
+
+/*@================================
+ * EduOM_PinObject()
+ *================================*/
+/*
+ * Function: Four EduOM_PinObject(ObjectID*, char**, Four*, EduOM_PinHandle*)
+ * 
+ * Description : 
+ *  (1) What to do?
+ *  EduOM_PinObject() keeps the page holding the object identified by 'oid'
+ *  fixed in the buffer pool and returns a pointer to the data of the object
+ *  in the buffer and its length. Unlike EduOM_ReadObject(), the data is
+ *  not copied; the caller reads it in place through 'ptr'.
+ *  The pointer is valid until the object is unpinned by EduOM_UnpinObject()
+ *  with 'handle', and while no object on the same page is created,
+ *  destroyed or appended to, since those may compact the page. The data must not be
+ *  modified through 'ptr'. A large object cannot be pinned since its data
+ *  is not in the page.
+ *
+ *  (2) How to do?
+ *  a. Read in the slotted page
+ *  b. Check the object identifier
+ *  c. IF moved object THEN fix the page of the forwarded record instead
+ *  d. Return the pointer to the data and the length of the object
+ *  e. Keep the page fixed and remember it in the handle
+ *
+ * Returns:
+ *  error code
+ *    eBADOBJECTID_OM
+ *    eBADPARAMETER_OM
+ *    eNOTSUPPORTED_EDUOM
+ *    some errors caused by function calls
+ *
+ * Side Effects :
+ *  The page holding the object remains fixed until EduOM_UnpinObject().
+ */
+Four EduOM_PinObject(
+    ObjectID 	*oid,		/* IN object to pin */
+    char     	**ptr,		/* OUT pointer to the data of the object */
+    Four     	*len,		/* OUT length of the object */
+    EduOM_PinHandle *handle)	/* OUT handle to unpin the object */
+{
+    Four     	e;          /* error code */
+    PageID 	pid;			/* page containing object specified by 'oid' */
+    SlottedPage	*apage;		/* pointer to the buffer of the page  */
+    Object	*obj;			/* pointer to the object in the slotted page */
+
+    
+    
+    /*@ check parameters */
+
+    if (oid == NULL) ERR(eBADOBJECTID_OM);
+
+    if (ptr == NULL || len == NULL || handle == NULL) ERR(eBADPARAMETER_OM);
+
+    MAKE_PAGEID(pid, oid->volNo, oid->pageNo);
+	e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	if (oid->slotNo < 0 || oid->slotNo >= apage->header.nSlots || !IS_VALID_OBJECTID(oid, apage)) {
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+		ERR(eBADOBJECTID_OM);
+	}
+
+	obj = (Object*)(apage->data + apage->slot[-1*oid->slotNo].offset);
+
+	e = eduom_FollowForward(&pid, &apage, &obj);
+	if (e<0) ERR(e);
+
+	/* the data of a large object is not in the page */
+	if (obj->header.properties & P_LRGOBJ) {
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+		ERR(eNOTSUPPORTED_EDUOM);
+	}
+
+	*ptr = obj->data;
+	*len = obj->header.length;
+	handle->pid = pid;
+
+    return(eNOERROR);
+    
+} /* EduOM_PinObject() */
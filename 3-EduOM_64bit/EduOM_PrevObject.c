@@ -51,6 +51,8 @@
  *  the same page which has the current object and  if there  is no previous
  *  object in the same page, find it from the previous page.
  *  If the current object is NULL, return the last object of the file.
+ *  The forwarded records and the records of a PAX page are skipped, and the
+ *  records of a fixed-length record page are found as in EduOM_NextObject().
  *
  * Returns:
  *  error code
@@ -78,9 +80,7 @@ Four EduOM_PrevObject(
 	VolNo  volNo;
     SlottedPage *apage;		/* a pointer to the data page */
     Object *obj;			/* a pointer to the Object */
-    SlottedPage *catPage;	/* buffer page containing the catalog object */
     sm_CatOverlayForData *catEntry; /* overlay structure for catalog object access */
-	PageID pFid;
 
 
     /*@ parameter checking */
@@ -88,10 +88,8 @@ Four EduOM_PrevObject(
     
     if (prevOID == NULL) ERR(eBADOBJECTID_OM);
 	
-	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
-	e = BfM_GetTrain(&pFid, &catPage, PAGE_BUF);
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
 	if (e<0) ERR(e);
-	GET_PTR_TO_CATENTRY_FOR_DATA(catObjForFile, catPage, catEntry);
 	
 	if (curOID == NULL) {
 		volNo = catEntry->fid.volNo;
@@ -100,7 +98,7 @@ Four EduOM_PrevObject(
 		e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
 		if (e<0) ERR(e);
 
-		i = apage->header.nSlots-1;
+		i = IS_FIXED_PAGE(apage) ? ((FixedPage*)apage)->fixed.maxRecords-1 : apage->header.nSlots-1;
 	}
 	else {
 		volNo = curOID->volNo;
@@ -112,41 +110,58 @@ Four EduOM_PrevObject(
 		i = curOID->slotNo-1;
 	}
 	while (1) {
-		for (; i>=0; i--) {
-			if (apage->slot[-1*i].offset != EMPTYSLOT)
+		if (IS_FIXED_PAGE(apage)) {
+			i = eduom_FixedPrevRecord((FixedPage*)apage, i);
+			if (i != NIL) {
+				MAKE_OBJECTID(*prevOID, volNo, pageNo, i, FIXED_UNIQUE((FixedPage*)apage, i));
 				break;
-		}
-		if (i >= 0) {
-			MAKE_OBJECTID(*prevOID, volNo, pageNo, i, apage->slot[-1*i].unique);
-			break;
+			}
 		}
 		else {
-			e = BfM_FreeTrain(&pid, PAGE_BUF);
-			if (e<0) ERR(e);
-			if (pageNo == catEntry->firstPage) {
-				e = BfM_FreeTrain(&pFid, PAGE_BUF);
-				if (e<0) ERR(e);
-				return(EOS);
+			for (; i>=0; i--) {
+				if (apage->slot[-1*i].offset != EMPTYSLOT && !SP_IS_FORWARDED(apage, i))
+					break;
 			}
-			else {
-				pageNo = apage->header.prevPage;
-				MAKE_PAGEID(pid, volNo, pageNo);
-		        e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
-				if (e<0) ERR(e);
-				i = apage->header.nSlots-1;
+			if (i >= 0) {
+				MAKE_OBJECTID(*prevOID, volNo, pageNo, i, apage->slot[-1*i].unique);
+				break;
 			}
-		}	
+		}
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+		if (pageNo == catEntry->firstPage) {
+			return(EOS);
+		}
+		else {
+			pageNo = apage->header.prevPage;
+			MAKE_PAGEID(pid, volNo, pageNo);
+			e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+			if (e<0) ERR(e);
+			i = IS_FIXED_PAGE(apage) ? ((FixedPage*)apage)->fixed.maxRecords-1 : apage->header.nSlots-1;
+		}
 	}
 	
-	offset = apage->slot[-1*i].offset;
-	obj = apage->data + offset;
-	objHdr = &obj->header;
+	if (IS_FIXED_PAGE(apage)) {
+		if (objHdr != NULL) {
+			objHdr->properties = 0;
+			objHdr->tag = 0;
+			objHdr->length = ((FixedPage*)apage)->fixed.length;
+		}
+	}
+	else if (objHdr != NULL) {
+		offset = apage->slot[-1*i].offset;
+		obj = apage->data + offset;
+		/* the header of a moved object is in the forwarded record */
+		e = eduom_FollowForward(&pid, &apage, &obj);
+		if (e<0) ERR(e);
+		*objHdr = obj->header;
+		objHdr->properties &= ~P_FORWARDED;
+	}
 
 	e = BfM_FreeTrain(&pid, PAGE_BUF);
 	if (e<0) ERR(e);
-	e = BfM_FreeTrain(&pFid, PAGE_BUF);
-	if (e<0) ERR(e);
 
-    return(EOS);
+    return(eNOERROR);
     
 } /* EduOM_PrevObject() */
@@ -37,7 +37,6 @@
 #include <string.h>
 #include "EduOM_common.h"
 #include "BfM.h"		/* for the buffer manager call */
-#include "LOT.h"		/* for the large object manager call */
 #include "EduOM_Internal.h"
 
 
@@ -64,12 +63,17 @@
  *
  *  (2) How to do?
  *  a. Read in the slotted page
+ *     IF PAX page THEN gather the record from the minipages of its columns
+ *     IF fixed-length record page THEN
+ *	   check the unique number of the record and copy from the record
+ *	   with eduom_FixedRead()
+ *     ENDIF
  *  b. See the object header
  *  c. IF moved object THEN
- *	   call this routine recursively with the forwarded object's identifier
+ *	   read the forwarded record instead, with eduom_FollowForward()
  *     ELSE 
  *	   IF large object THEN 
- *             call the large object manager's LOT_ReadObject()
+ *             read the leaves holding the range with eduom_LotRead()
  *	   ELSE 
  *	       copy the data into the user buffer 'buf'
  *	   ENDIF
@@ -111,13 +115,44 @@ Four EduOM_ReadObject(
     MAKE_PAGEID(pid, oid->volNo, oid->pageNo);
 	e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
 	if (e<0) ERR(e);
+
+	if (IS_PAX_PAGE(apage)) {
+		length = eduom_PaxRead((PaxPage*)apage, oid->slotNo, start, length, buf);
+		if (length<0) ERRB1(length, &pid, PAGE_BUF);
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		return(length);
+	}
+
+	if (IS_FIXED_PAGE(apage)) {
+		if (!FIXED_IS_VALID_OBJECTID(oid, (FixedPage*)apage)) ERRB1(eBADOBJECTID_OM, &pid, PAGE_BUF);
+
+		length = eduom_FixedRead((FixedPage*)apage, oid->slotNo, start, length, buf);
+		if (length<0) ERRB1(length, &pid, PAGE_BUF);
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		return(length);
+	}
+
 	offset = apage->slot[-1*oid->slotNo].offset;
 	obj = apage->data + offset; 
 
+	e = eduom_FollowForward(&pid, &apage, &obj);
+	if (e<0) ERR(e);
+
 	if (length == REMAINDER)
 		length = obj->header.length - start;
-	
-	memcpy(buf, apage->data + offset + sizeof(obj->header) + start, length);
+
+	if (obj->header.properties & P_LRGOBJ) {
+		e = eduom_LotRead(obj, pid.volNo, start, length, buf);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+	}
+	else
+		memcpy(buf, obj->data + start, length);
 
 	e = BfM_FreeTrain(&pid, PAGE_BUF);
 	if (e<0) ERR(e);
@@ -0,0 +1,395 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduOM_ScanNext.c
+ *
+ * Description:
+ *  Return the next object of a sequential scan cursor.
+ *
+ * Export:
+ *  Four EduOM_ScanNext(EduOM_ScanCursor*, ObjectID*, ObjectHdr*, char**)
+ */
+
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "BfM.h"
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+
+static Boolean eduom_EvalPredicate(EduOM_ScanCursor*, ObjectHdr*, char*);
+static Four eduom_FixForwarded(EduOM_ScanCursor*, Object**);
+static Four eduom_ReadAhead(EduOM_ScanCursor*);
+static Four eduom_UnfixForwarded(EduOM_ScanCursor*);
+
+
+
+/*@================================
+ * EduOM_ScanNext()
+ *================================*/
+/*
+ * Function: Four EduOM_ScanNext(EduOM_ScanCursor*, ObjectID*, ObjectHdr*, char**)
+ *
+ * Description:
+ *  Return the next object of the scan. Find the object in the current page
+ *  after the current object and if there is no next object in the page,
+ *  unfix the page and find it from the next page, which is fixed until its
+ *  objects are all returned.
+ *  If a predicate or a filter is set on the cursor, the objects not
+ *  satisfying them are skipped while the page is fixed; they are not copied.
+ *  The data of the object is returned in place; the pointer is valid until
+ *  the next call on the cursor and the data must not be modified through it.
+ *  The data of a large object is not in the page; it is read by
+ *  EduOM_ReadObject() and no predicate is satisfied by a large object.
+ *  The forwarded records are skipped; a moved object is returned with the
+ *  header and the data of its forwarded record, whose page is kept fixed
+ *  until the next call.
+ *  The present records of a fixed-length record page are found in its
+ *  bitmap and returned with a header having no property and no tag.
+ *  The records of a PAX page are not returned; the page has no slot, so it
+ *  is passed over. They are read by a PAX scan (EduOM_PaxOpenScan()).
+ *
+ * Returns:
+ *  1) eNOERROR
+ *  2) EOS if there is no more object
+ *  3) error code
+ *    eBADPARAMETER_OM
+ *    some errors caused by function calls
+ *
+ * Side effect:
+ *  1) parameter oid
+ *     oid is filled with the next object's identifier if it is not NULL
+ *  2) parameter objHdr
+ *     objHdr is filled with the next object's header if it is not NULL
+ *  3) parameter data
+ *     data points to the next object's data if it is not NULL;
+ *     NULL for a large object
+ */
+Four EduOM_ScanNext(
+    EduOM_ScanCursor *cursor,	/* INOUT the scan cursor */
+    ObjectID  *oid,				/* OUT the next object */
+    ObjectHdr *objHdr,			/* OUT the object header of next object */
+    char      **data)			/* OUT the data of next object */
+{
+    Four e;					/* error */
+    Two  i;					/* index */
+    PageNo nextPage;		/* page following the current page */
+    SlottedPage *apage;		/* a pointer to the data page */
+    FixedPage *fpage;		/* the page if it is a fixed-length record page */
+    Object *obj;			/* a pointer to the Object */
+    ObjectHdr fixedHdr;		/* header of the records of a fixed-length record page */
+    ObjectHdr *hdr;			/* header of the next object */
+    char *objData;			/* data of the next object; NULL for a large object */
+    ObjectID curOID;		/* identifier of the object given to the filter */
+    Boolean match;			/* does the object satisfy the predicate and the filter? */
+
+
+
+    /*@
+     * parameter checking
+     */
+    if (cursor == NULL) ERR(eBADPARAMETER_OM);
+
+	e = eduom_UnfixForwarded(cursor);
+	if (e<0) ERR(e);
+
+	if (cursor->pid.pageNo == NIL) return(EOS);
+
+	while (1) {
+		if (cursor->apage == NULL) {
+			SCAN_LATCH(cursor);
+			e = BfM_GetTrain(&cursor->pid, &cursor->apage, PAGE_BUF);
+			SCAN_UNLATCH(cursor);
+			if (e<0) { cursor->apage = NULL; ERR(e); }
+			cursor->slotNo = -1;
+
+			if (cursor->nAhead > 0)
+				cursor->nAhead--;
+			else
+				cursor->aheadNext = (cursor->pid.pageNo == cursor->lastPage) ? NIL : cursor->apage->header.nextPage;
+
+			e = eduom_ReadAhead(cursor);
+			if (e<0) ERR(e);
+		}
+		apage = cursor->apage;
+
+		if (IS_FIXED_PAGE(apage)) {
+			fpage = (FixedPage*)apage;
+			fixedHdr.properties = 0;
+			fixedHdr.tag = 0;
+			fixedHdr.length = fpage->fixed.length;
+			hdr = &fixedHdr;
+
+			for (i = cursor->slotNo+1; ; i++) {
+				/* the bitmap is searched only if the next record is absent */
+				if (!FIXED_IS_SET(fpage, i)) {
+					i = eduom_FixedNextRecord(fpage, i);
+					if (i == NIL) break;
+				}
+				objData = FIXED_RECORD(fpage, i);
+
+				match = (cursor->predLen == 0 || eduom_EvalPredicate(cursor, hdr, objData));
+				if (match && cursor->filter != NULL) {
+					MAKE_OBJECTID(curOID, cursor->pid.volNo, cursor->pid.pageNo, i, FIXED_UNIQUE(fpage, i));
+					match = cursor->filter(&curOID, hdr, objData, cursor->filterArg);
+				}
+				if (match) break;
+			}
+			if (i != NIL) break;
+		}
+		else {
+			for (i = cursor->slotNo+1; i<apage->header.nSlots; i++) {
+				if (apage->slot[-1*i].offset == EMPTYSLOT || SP_IS_FORWARDED(apage, i)) continue;
+
+				obj = (Object*)(apage->data + apage->slot[-1*i].offset);
+				if (obj->header.properties & P_MOVED) {
+					e = eduom_FixForwarded(cursor, &obj);
+					if (e<0) ERR(e);
+				}
+				hdr = &obj->header;
+				objData = (obj->header.properties & P_LRGOBJ) ? NULL : obj->data;
+
+				match = (cursor->predLen == 0 || eduom_EvalPredicate(cursor, hdr, objData));
+				if (match && cursor->filter != NULL) {
+					MAKE_OBJECTID(curOID, cursor->pid.volNo, cursor->pid.pageNo, i, apage->slot[-1*i].unique);
+					match = cursor->filter(&curOID, hdr, objData, cursor->filterArg);
+				}
+				if (match) break;
+
+				e = eduom_UnfixForwarded(cursor);
+				if (e<0) ERR(e);
+			}
+			if (i < apage->header.nSlots) break;
+		}
+
+		nextPage = (cursor->pid.pageNo == cursor->lastPage) ? NIL : apage->header.nextPage;
+
+		SCAN_LATCH(cursor);
+		e = BfM_FreeTrain(&cursor->pid, PAGE_BUF);
+		SCAN_UNLATCH(cursor);
+		if (e<0) ERR(e);
+		cursor->apage = NULL;
+		cursor->pid.pageNo = nextPage;
+
+		if (nextPage == NIL) return(EOS);
+	}
+
+	cursor->slotNo = i;
+
+	if (oid != NULL)
+		MAKE_OBJECTID(*oid, cursor->pid.volNo, cursor->pid.pageNo, i,
+					  IS_FIXED_PAGE(apage) ? FIXED_UNIQUE((FixedPage*)apage, i) : apage->slot[-1*i].unique);
+	if (objHdr != NULL) {
+		*objHdr = *hdr;
+		objHdr->properties &= ~P_FORWARDED;
+	}
+	if (data != NULL) *data = objData;
+
+    return(eNOERROR);
+    
+} /* EduOM_ScanNext() */
+
+
+
+/*@================================
+ * eduom_EvalPredicate()
+ *================================*/
+/*
+ * Function: static Boolean eduom_EvalPredicate(EduOM_ScanCursor*, ObjectHdr*, char*)
+ *
+ * Description:
+ *  Evaluate the predicate of the cursor on the object in place. The field
+ *  is copied into a variable of its type since it may not be aligned.
+ *
+ * Returns:
+ *  TRUE if the object satisfies the predicate, otherwise FALSE
+ */
+static Boolean eduom_EvalPredicate(
+    EduOM_ScanCursor *cursor,	/* IN the scan cursor */
+    ObjectHdr *hdr,			/* IN header of the object to evaluate */
+    char *objData)			/* IN data of the object; NULL for a large object */
+{
+    EduOM_ScanPredicate *pred = &cursor->pred;
+    char *field;			/* the field in the object */
+    Four cmp;				/* <0, 0 or >0 as field <, = or > value */
+    Two_Invariable s;
+    Four_Invariable l;
+    float f;
+    double d;
+
+
+	if (objData == NULL) return(FALSE);
+	if (pred->offset + cursor->predLen > hdr->length) return(FALSE);
+	field = objData + pred->offset;
+
+	switch (pred->type) {
+	  case SM_SHORT:
+		memcpy(&s, field, sizeof(s));
+		cmp = (s < pred->value.s) ? -1 : (s > pred->value.s);
+		break;
+	  case SM_INT:
+	  case SM_LONG:
+		memcpy(&l, field, sizeof(l));
+		cmp = (l < pred->value.l) ? -1 : (l > pred->value.l);
+		break;
+	  case SM_FLOAT:
+		memcpy(&f, field, sizeof(f));
+		cmp = (f < pred->value.f) ? -1 : (f > pred->value.f);
+		break;
+	  case SM_DOUBLE:
+		memcpy(&d, field, sizeof(d));
+		cmp = (d < pred->value.d) ? -1 : (d > pred->value.d);
+		break;
+	  default:				/* SM_STRING */
+		cmp = memcmp(field, pred->value.str, cursor->predLen);
+		break;
+	}
+
+	switch (pred->op) {
+	  case SM_EQ: return(cmp == 0);
+	  case SM_LT: return(cmp < 0);
+	  case SM_LE: return(cmp <= 0);
+	  case SM_GT: return(cmp > 0);
+	  case SM_GE: return(cmp >= 0);
+	  default:    return(cmp != 0);	/* SM_NE */
+	}
+
+} /* eduom_EvalPredicate() */
+
+
+
+/*@================================
+ * eduom_FixForwarded()
+ *================================*/
+/*
+ * Function: static Four eduom_FixForwarded(EduOM_ScanCursor*, Object**)
+ *
+ * Description:
+ *  Fix the page of the forwarded record of a moved object and remember it
+ *  in the cursor; it is unfixed by eduom_UnfixForwarded().
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_FixForwarded(
+    EduOM_ScanCursor *cursor,	/* INOUT the scan cursor */
+    Object **obj)			/* INOUT the stub; the forwarded record on return */
+{
+    Four e;					/* error */
+    ObjectID fwdOid;		/* the forwarded record */
+    SlottedPage *apage;		/* a pointer to the page of the forwarded record */
+
+
+	memcpy(&fwdOid, (*obj)->data, sizeof(ObjectID));
+	MAKE_PAGEID(cursor->fwdPid, fwdOid.volNo, fwdOid.pageNo);
+
+	SCAN_LATCH(cursor);
+	e = BfM_GetTrain(&cursor->fwdPid, &apage, PAGE_BUF);
+	SCAN_UNLATCH(cursor);
+	if (e<0) { cursor->fwdPid.pageNo = NIL; ERR(e); }
+
+	*obj = (Object*)(apage->data + apage->slot[-1*fwdOid.slotNo].offset);
+
+    return(eNOERROR);
+
+} /* eduom_FixForwarded() */
+
+
+
+/*@================================
+ * eduom_UnfixForwarded()
+ *================================*/
+/*
+ * Function: static Four eduom_UnfixForwarded(EduOM_ScanCursor*)
+ *
+ * Description:
+ *  Unfix the page of the forwarded record fixed by the cursor, if any.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_UnfixForwarded(
+    EduOM_ScanCursor *cursor)	/* INOUT the scan cursor */
+{
+    Four e;					/* error */
+
+
+	if (cursor->fwdPid.pageNo == NIL) return(eNOERROR);
+
+	SCAN_LATCH(cursor);
+	e = BfM_FreeTrain(&cursor->fwdPid, PAGE_BUF);
+	SCAN_UNLATCH(cursor);
+	cursor->fwdPid.pageNo = NIL;
+	if (e<0) ERR(e);
+
+    return(eNOERROR);
+
+} /* eduom_UnfixForwarded() */
+
+
+
+/*@================================
+ * eduom_ReadAhead()
+ *================================*/
+/*
+ * Function: static Four eduom_ReadAhead(EduOM_ScanCursor*)
+ *
+ * Description:
+ *  Read the pages following the current page into the buffer pool until
+ *  'readAhead' pages are read ahead of the current page. The pages are
+ *  fixed only to be read in; they are unfixed right away.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_ReadAhead(
+    EduOM_ScanCursor *cursor)	/* INOUT the scan cursor */
+{
+    Four e;					/* error */
+    PageID pid;				/* page to read ahead */
+    SlottedPage *apage;		/* a pointer to the data page */
+
+
+	while (cursor->nAhead < cursor->readAhead && cursor->aheadNext != NIL) {
+		MAKE_PAGEID(pid, cursor->pid.volNo, cursor->aheadNext);
+		SCAN_LATCH(cursor);
+		e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e >= 0) {
+			cursor->aheadNext = (pid.pageNo == cursor->lastPage) ? NIL : apage->header.nextPage;
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+		}
+		SCAN_UNLATCH(cursor);
+		if (e<0) ERR(e);
+
+		cursor->nAhead++;
+	}
+
+    return(eNOERROR);
+
+} /* eduom_ReadAhead() */
@@ -0,0 +1,73 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduOM_SetScanFilter.c
+ *
+ * Description:
+ *  Set the filter of a sequential scan cursor.
+ *
+ * Export:
+ *  Four EduOM_SetScanFilter(EduOM_ScanCursor*, EduOM_ScanFilter, void*)
+ */
+
+
+#include "EduOM_common.h"
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+/*@================================
+ * EduOM_SetScanFilter()
+ *================================*/
+/*
+ * Function: Four EduOM_SetScanFilter(EduOM_ScanCursor*, EduOM_ScanFilter, void*)
+ *
+ * Description:
+ *  Set the filter of the scan cursor. EduOM_ScanNext() calls 'filter' with
+ *  the identifier, the header and the data of each object while its page is
+ *  fixed, and returns only the objects for which it returns TRUE. The data
+ *  is given in place and must not be modified by the filter.
+ *  If a predicate is also set, the filter is called only on the objects
+ *  satisfying the predicate. A NULL 'filter' removes the filter.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_OM
+ */
+Four EduOM_SetScanFilter(
+    EduOM_ScanCursor *cursor,	/* INOUT the scan cursor */
+    EduOM_ScanFilter filter,	/* IN the filter, or NULL */
+    void      *filterArg)		/* IN argument passed to the filter */
+{
+    /*@
+     * parameter checking
+     */
+    if (cursor == NULL) ERR(eBADPARAMETER_OM);
+
+	cursor->filter = filter;
+	cursor->filterArg = filterArg;
+
+    return(eNOERROR);
+    
+} /* EduOM_SetScanFilter() */
@@ -0,0 +1,110 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduOM_SetScanPredicate.c
+ *
+ * Description:
+ *  Set the predicate of a sequential scan cursor.
+ *
+ * Export:
+ *  Four EduOM_SetScanPredicate(EduOM_ScanCursor*, EduOM_ScanPredicate*)
+ */
+
+
+#include "EduOM_common.h"
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+/*@================================
+ * EduOM_SetScanPredicate()
+ *================================*/
+/*
+ * Function: Four EduOM_SetScanPredicate(EduOM_ScanCursor*, EduOM_ScanPredicate*)
+ *
+ * Description:
+ *  Set the predicate of the scan cursor. EduOM_ScanNext() compares the field
+ *  of 'pred->type' at 'pred->offset' of the data of each object with
+ *  'pred->value' while the page is fixed, and returns only the objects for
+ *  which "field <op> value" holds; an object too short to hold the field
+ *  does not satisfy the predicate.
+ *  The predicate is copied into the cursor with the length of its field, so
+ *  it is not interpreted again for each object. The string of a SM_STRING
+ *  predicate is not copied and must remain until the cursor is closed.
+ *  A NULL 'pred' removes the predicate.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_OM
+ */
+Four EduOM_SetScanPredicate(
+    EduOM_ScanCursor *cursor,	/* INOUT the scan cursor */
+    EduOM_ScanPredicate *pred)	/* IN the predicate, or NULL */
+{
+    Four len;				/* length of the field */
+
+
+
+    /*@
+     * parameter checking
+     */
+    if (cursor == NULL) ERR(eBADPARAMETER_OM);
+
+	if (pred == NULL) {
+		cursor->predLen = 0;
+		return(eNOERROR);
+	}
+
+	if (pred->offset < 0 || pred->op < SM_EQ || pred->op > SM_NE) ERR(eBADPARAMETER_OM);
+
+	switch (pred->type) {
+	  case SM_SHORT:
+		len = SM_SHORT_SIZE;
+		break;
+	  case SM_INT:
+		len = SM_INT_SIZE;
+		break;
+	  case SM_LONG:
+		len = SM_LONG_SIZE;
+		break;
+	  case SM_FLOAT:
+		len = SM_FLOAT_SIZE;
+		break;
+	  case SM_DOUBLE:
+		len = SM_DOUBLE_SIZE;
+		break;
+	  case SM_STRING:
+		if (pred->length <= 0 || pred->value.str == NULL) ERR(eBADPARAMETER_OM);
+		len = pred->length;
+		break;
+	  default:
+		ERR(eBADPARAMETER_OM);
+	}
+
+	cursor->pred = *pred;
+	cursor->predLen = len;
+
+    return(eNOERROR);
+    
+} /* EduOM_SetScanPredicate() */
@@ -0,0 +1,235 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : EduOM_TruncateFile.c
+ * 
+ * Description : 
+ *  EduOM_TruncateFile() destroys all the objects of a file.
+ *
+ * Exports:
+ *  Four EduOM_TruncateFile(ObjectID*, Pool*, DeallocListElem*)
+ */
+
+#include "EduOM_common.h"
+#include "Util.h"		/* to get Pool */
+#include "RDsM.h"
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+
+
+
+/*@ Internal Function Prototypes */
+static void eduom_FreeDeallocChain(Pool*, DeallocListElem*);
+
+
+
+/*@================================
+ * EduOM_TruncateFile()
+ *================================*/
+/*
+ * Function: Four EduOM_TruncateFile(ObjectID*, Pool*, DeallocListElem*)
+ * 
+ * Description : 
+ *  (1) What to do?
+ *  EduOM_TruncateFile() destroys all the objects of the file at once, much
+ *  cheaper than EduOM_DestroyObject() per object: the pages are dropped as
+ *  a whole instead of being emptied object by object, and the file map,
+ *  the available space lists and the free space map are reset once.
+ *  The first page of the file is kept and emptied. Its unique number is
+ *  kept, so the object IDs of the destroyed objects are not given again.
+ *
+ *  (2) How to do?
+ *  a. FOR each page of the file
+ *	   Collect the trains of the large objects of the page
+ *	   IF not the first page THEN collect the page ENDIF
+ *     ENDFOR
+ *  b. IF an error occurred THEN
+ *	   Give the collected elements back to the pool; the file is not changed
+ *     ENDIF
+ *  c. Make the first page the only page of the file and empty the
+ *     available space lists in the catalog entry
+ *  d. Empty the first page and put it into the available space list
+ *  e. Put the collected trains and pages into the dealloc list
+ *  f. Return
+ *
+ * Returns:
+ *  error code
+ *    eBADCATALOGOBJECT_OM
+ *    some errors caused by function calls
+ *
+ * Note:
+ *  The catalog entry is changed only after all the pages of the file have
+ *  been walked, so that a failed walk leaves the file as it was; no scan
+ *  of the file may be open.
+ */
+Four EduOM_TruncateFile(
+    ObjectID *catObjForFile,	/* IN file to truncate */
+    Pool     *dlPool,			/* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)	/* INOUT head of dealloc list */
+{
+    Four        e;			/* error number */
+    PageID		pid;		/* page of the file */
+    SlottedPage *apage;		/* pointer to the buffer holding the page */
+    ShortPageID	firstPage;	/* first page of the file */
+    ShortPageID	nextPage;	/* next page of the file */
+    Object      *obj;		/* points to an object in data area */
+    Two         i;			/* slot number */
+    sm_CatOverlayForData *catEntry; /* overlay structure for catalog object access */
+    DeallocListElem lotHead;	/* head of the trains collected */
+    DeallocListElem *dlFirst;	/* pages collected, in the order of the file */
+    DeallocListElem *dlLast;	/* last element of the chain */
+    DeallocListElem *dlElem;	/* pointer to element of dealloc list */
+
+
+
+    /*@ Check parameters. */
+    if (catObjForFile == NULL) ERR(eBADCATALOGOBJECT_OM);
+
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+	if (e<0) ERR(e);
+
+	MAKE_PAGEID(pid, catEntry->fid.volNo, catEntry->firstPage);
+	firstPage = catEntry->firstPage;
+
+	lotHead.next = NULL;
+	dlFirst = dlLast = NULL;
+
+	while (pid.pageNo != NIL) {
+		e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e<0) break;
+
+		nextPage = apage->header.nextPage;
+
+		/* the records of PAX and fixed-length record pages are never large */
+		if (!IS_PAX_PAGE(apage) && !IS_FIXED_PAGE(apage)) {
+			for (i = 0; i < apage->header.nSlots; i++) {
+				if (apage->slot[-i].offset == EMPTYSLOT) continue;
+				obj = (Object*)(apage->data + apage->slot[-i].offset);
+
+				/* the trains of a moved object hang from its forwarded record */
+				if ((obj->header.properties & (P_LRGOBJ | P_MOVED)) == P_LRGOBJ) {
+					e = eduom_LotDestroy(obj, pid.volNo, dlPool, &lotHead);
+					if (e<0) break;
+				}
+			}
+			if (e<0) {
+				BfM_FreeTrain(&pid, PAGE_BUF);
+				break;
+			}
+		}
+
+		if (pid.pageNo != firstPage) {
+			e = Util_getElementFromPool(dlPool, &dlElem);
+			if (e<0) {
+				BfM_FreeTrain(&pid, PAGE_BUF);
+				break;
+			}
+			dlElem->type = DL_PAGE;
+			dlElem->elem.pid = pid;
+			dlElem->next = NULL;
+			if (dlLast == NULL) dlFirst = dlElem;
+			else dlLast->next = dlElem;
+			dlLast = dlElem;
+		}
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) break;
+
+		pid.pageNo = nextPage;
+	}
+
+	if (e>=0) {
+		MAKE_PAGEID(pid, catEntry->fid.volNo, firstPage);
+		e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+	}
+	if (e>=0) {
+		e = eduom_FileMapTruncate(catObjForFile);
+		if (e<0) BfM_FreeTrain(&pid, PAGE_BUF);
+	}
+	if (e<0) {
+		/* nothing has been changed; the elements collected are not needed */
+		eduom_FreeDeallocChain(dlPool, lotHead.next);
+		eduom_FreeDeallocChain(dlPool, dlFirst);
+		ERR(e);
+	}
+	eduom_FsmDropFile(catObjForFile);
+
+	/* the pages unlinked from the file are freed even if the first page is not kept */
+	if (lotHead.next != NULL) {
+		for (dlElem = lotHead.next; dlElem->next != NULL; dlElem = dlElem->next);
+		dlElem->next = dlHead->next;
+		dlHead->next = lotHead.next;
+	}
+	if (dlFirst != NULL) {
+		dlLast->next = dlHead->next;
+		dlHead->next = dlFirst;
+	}
+
+	apage->header.nSlots = 0;
+	apage->header.freeSlot = NIL;
+	apage->header.free = 0;
+	apage->header.unused = 0;
+	apage->header.nextPage = NIL;
+	apage->header.spaceListPrev = NIL;
+	apage->header.spaceListNext = NIL;
+
+	e = BfM_SetDirty(&pid, PAGE_BUF);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+	e = eduom_PutInAvailSpaceList(catObjForFile, &pid, apage, NIL);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+    return(eNOERROR);
+    
+} /* EduOM_TruncateFile() */
+
+
+
+/*@================================
+ * eduom_FreeDeallocChain()
+ *================================*/
+/*
+ * Function: static void eduom_FreeDeallocChain(Pool*, DeallocListElem*)
+ *
+ * Description :
+ *  Give the elements of a chain of dealloc list elements, which has not
+ *  been put into the dealloc list, back to the pool.
+ */
+static void eduom_FreeDeallocChain(
+    Pool     *dlPool,			/* INOUT pool of dealloc list elements */
+    DeallocListElem *dlElem)	/* IN first element of the chain */
+{
+    DeallocListElem *next;	/* element following 'dlElem' */
+
+
+	for (; dlElem != NULL; dlElem = next) {
+		next = dlElem->next;
+		Util_freeElementToPool(dlPool, dlElem);
+	}
+
+} /* eduom_FreeDeallocChain() */
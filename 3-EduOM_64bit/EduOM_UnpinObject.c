@@ -0,0 +1,74 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : EduOM_UnpinObject.c
+ * 
+ * Description : 
+ *  EduOM_UnpinObject() releases an object pinned by EduOM_PinObject().
+ *
+ * Exports:
+ *  Four EduOM_UnpinObject(EduOM_PinHandle*)
+ */
+
+
+#include "EduOM_common.h"
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+
+
+/*@================================
+ * EduOM_UnpinObject()
+ *================================*/
+/*
+ * Function: Four EduOM_UnpinObject(EduOM_PinHandle*)
+ * 
+ * Description : 
+ *  EduOM_UnpinObject() unfixes the page of the object pinned with 'handle'.
+ *  The pointer returned by EduOM_PinObject() must not be used afterwards.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_OM
+ *    some errors caused by function calls
+ */
+Four EduOM_UnpinObject(
+    EduOM_PinHandle *handle)	/* IN handle returned by EduOM_PinObject() */
+{
+    Four     	e;          /* error code */
+
+    
+    
+    /*@ check parameters */
+
+    if (handle == NULL) ERR(eBADPARAMETER_OM);
+
+	e = BfM_FreeTrain(&handle->pid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+    return(eNOERROR);
+    
+} /* EduOM_UnpinObject() */
@@ -0,0 +1,151 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : EduOM_WriteObject.c
+ * 
+ * Description : 
+ *  EduOM_WriteObject() overwrites a byte range of the object.
+ *
+ * Exports:
+ *  Four EduOM_WriteObject(ObjectID*, Four, Four, void*)
+ */
+
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+
+
+/*@================================
+ * EduOM_WriteObject()
+ *================================*/
+/*
+ * Function: Four EduOM_WriteObject(ObjectID*, Four, Four, void*)
+ * 
+ * Description : 
+ *  (1) What to do?
+ *  EduOM_WriteObject() overwrites the 'length' bytes from 'start' of the
+ *  object identified by 'oid' with 'data' in place; the object is neither
+ *  moved nor given a new ObjectID. The range must be within the object;
+ *  EduOM_AppendToObject() makes the object longer. Only the leaves of a
+ *  large object holding the range are written.
+ *
+ *  (2) How to do?
+ *  a. Read in the slotted page
+ *     IF fixed-length record page THEN copy the data into the record in place
+ *  b. Check the object identifier
+ *  c. IF moved object THEN fix the page of the forwarded record instead
+ *  d. Check the range
+ *  e. IF large object THEN
+ *	   write the leaves holding the range with eduom_LotWrite()
+ *     ELSE
+ *	   copy the data into the page and set the page dirty
+ *     ENDIF
+ *  f. Free the page
+ *
+ * Returns:
+ *  error code
+ *    eBADOBJECTID_OM
+ *    eBADSTART_OM
+ *    eBADLENGTH_OM
+ *    eBADUSERBUF_OM
+ *    some errors caused by function calls
+ */
+Four EduOM_WriteObject(
+    ObjectID	*oid,		/* IN object to write */
+    Four		start,		/* IN starting offset of write */
+    Four		length,		/* IN amount of data to write */
+    void		*data)		/* IN data to write */
+{
+    Four	e;				/* error number */
+    PageID	pid;			/* page containing the object */
+    SlottedPage	*apage;		/* pointer to the buffer of the page */
+    FixedPage	*fpage;		/* the page if it is a fixed-length record page */
+    Object	*obj;			/* pointer to the object in the slotted page */
+
+    
+    
+    /*@ check parameters */
+
+    if (oid == NULL) ERR(eBADOBJECTID_OM);
+
+    if (start < 0) ERR(eBADSTART_OM);
+
+    if (length < 0) ERR(eBADLENGTH_OM);
+
+    if (length > 0 && data == NULL) ERR(eBADUSERBUF_OM);
+
+    MAKE_PAGEID(pid, oid->volNo, oid->pageNo);
+	e = BfM_GetTrain(&pid, (char **)&apage, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	if (IS_FIXED_PAGE(apage)) {
+		fpage = (FixedPage*)apage;
+		if (!FIXED_IS_VALID_OBJECTID(oid, fpage))
+			ERRB1(eBADOBJECTID_OM, &pid, PAGE_BUF);
+
+		if (start > fpage->fixed.length) ERRB1(eBADSTART_OM, &pid, PAGE_BUF);
+		if (length > fpage->fixed.length - start) ERRB1(eBADLENGTH_OM, &pid, PAGE_BUF);
+
+		memcpy(FIXED_RECORD(fpage, oid->slotNo) + start, data, length);
+		e = BfM_SetDirty(&pid, PAGE_BUF);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) ERR(e);
+
+		return(eNOERROR);
+	}
+
+	if (oid->slotNo < 0 || oid->slotNo >= apage->header.nSlots || !IS_VALID_OBJECTID(oid, apage))
+		ERRB1(eBADOBJECTID_OM, &pid, PAGE_BUF);
+
+	obj = (Object*)(apage->data + apage->slot[-1*oid->slotNo].offset);
+
+	e = eduom_FollowForward(&pid, &apage, &obj);
+	if (e<0) ERR(e);
+
+	if (start > obj->header.length) ERRB1(eBADSTART_OM, &pid, PAGE_BUF);
+	if (length > obj->header.length - start) ERRB1(eBADLENGTH_OM, &pid, PAGE_BUF);
+
+	if (obj->header.properties & P_LRGOBJ) {
+		e = eduom_LotWrite(obj, pid.volNo, start, length, data);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+	}
+	else {
+		memcpy(obj->data + start, data, length);
+		e = BfM_SetDirty(&pid, PAGE_BUF);
+		if (e<0) ERRB1(e, &pid, PAGE_BUF);
+	}
+
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+    return(eNOERROR);
+    
+} /* EduOM_WriteObject() */
@@ -26,21 +26,117 @@
 #define _EDUOM_H_
 
 
+#include <pthread.h>
 #include "EduOM_Internal.h"
 #include "Util_pool.h"
 
 
 
+/*@
+ * Constant Definitions
+ */
+/* maximum # of workers of EduOM_ParallelScan() */
+#define EDUOM_MAX_SCAN_WORKERS  64
+
+
+
+/*@
+ * Type Definitions
+ */
+/* handle of an object pinned by EduOM_PinObject() */
+typedef struct {
+    PageID      pid;        /* page holding the object; fixed until unpinned */
+} EduOM_PinHandle;
+
+/* filter called by the scan cursor on each object; returns TRUE to return the object */
+typedef Boolean (*EduOM_ScanFilter)(ObjectID*, ObjectHdr*, char*, void*);
+
+/* predicate on a field of the object data, evaluated by the scan cursor */
+typedef struct {
+    Two         type;       /* SM_SHORT, SM_INT, SM_LONG, SM_FLOAT, SM_DOUBLE or SM_STRING */
+    CompOp      op;         /* SM_EQ, SM_LT, SM_LE, SM_GT, SM_GE or SM_NE */
+    Four        offset;     /* offset of the field in the object data */
+    Four        length;     /* length of the field if SM_STRING */
+    union {
+        Two_Invariable  s;
+        Four_Invariable l;  /* SM_INT or SM_LONG */
+        float           f;
+        double          d;
+        char            *str; /* SM_STRING; not copied */
+    } value;                /* field <op> value */
+} EduOM_ScanPredicate;
+
+/* sequential scan cursor of a data file (EduOM_OpenScan()) */
+typedef struct {
+    PageID      pid;        /* current page; NIL page number at the end of the scan */
+    SlottedPage *apage;     /* buffer of the current page if fixed, or NULL */
+    Two         slotNo;     /* slot of the current object */
+    PageNo      lastPage;   /* last page of the file */
+    Four        readAhead;  /* # of pages to read ahead of the current page */
+    Four        nAhead;     /* # of pages read ahead of the current page */
+    PageNo      aheadNext;  /* page following the pages read ahead; NIL if none */
+    Four        predLen;    /* length of the field of 'pred'; 0 if no predicate */
+    EduOM_ScanPredicate pred; /* predicate the objects returned satisfy */
+    EduOM_ScanFilter filter;  /* filter the objects returned pass, or NULL */
+    void        *filterArg; /* argument of 'filter' */
+    pthread_mutex_t *latch; /* serializes the buffer manager calls of the cursor, or NULL */
+    PageID      fwdPid;     /* page of the forwarded record of the current object, fixed
+                               until the next call; NIL page number if none */
+} EduOM_ScanCursor;
+
+/* projection scan cursor of the PAX pages of a data file (EduOM_PaxOpenScan()) */
+typedef struct {
+    PageID      pid;        /* current page; NIL page number at the end of the scan */
+    PaxPage     *apage;     /* buffer of the current page if fixed, or NULL */
+    PageNo      lastPage;   /* last page of the file */
+    Two         nColumns;   /* # of columns returned */
+    Two         columns[PAX_MAX_COLUMNS]; /* columns returned, in the order returned */
+} EduOM_PaxCursor;
+
+
+
+/*@
+ * Macro Function Definitions
+ */
+/* Macro: SCAN_LATCH(c), SCAN_UNLATCH(c)
+ * Description: acquire/release the latch of the scan cursor if it has one;
+ *              the buffer manager is called only while the latch is held
+ * Parameter:
+ *  EduOM_ScanCursor *c : pointer to the scan cursor
+ */
+#define SCAN_LATCH(c)   BEGIN_MACRO if ((c)->latch != NULL) pthread_mutex_lock((c)->latch); END_MACRO
+#define SCAN_UNLATCH(c) BEGIN_MACRO if ((c)->latch != NULL) pthread_mutex_unlock((c)->latch); END_MACRO
+
+
+
 /*@
  * Function Prototypes
  */
 /* Interface Function Prototypes */
+Four EduOM_AppendToObject(ObjectID*, ObjectID*, Four, void*, Pool*, DeallocListElem*);
+Four EduOM_CloseScan(EduOM_ScanCursor*);
 Four EduOM_CompactPage(SlottedPage*, Two);
+Four EduOM_CreateFixedObject(ObjectID*, ObjectID*, Two, void*, ObjectID*);
 Four EduOM_CreateObject(ObjectID*, ObjectID*, ObjectHdr*, Four, void*, ObjectID*);
+Four EduOM_CreateObjects(ObjectID*, ObjectID*, Four, ObjectHdr*, Four*, void**, ObjectID*);
+Four EduOM_CreatePaxObjects(ObjectID*, Two, Two*, Four, void*, ObjectID*);
 Four EduOM_DestroyObject(ObjectID*, ObjectID*, Pool*, DeallocListElem*);
+Four EduOM_DestroyObjects(ObjectID*, Four, ObjectID*, Pool*, DeallocListElem*);
 Four EduOM_NextObject(ObjectID*, ObjectID*, ObjectID*, ObjectHdr*);
+Four EduOM_OpenScan(ObjectID*, Four, EduOM_ScanCursor*);
+Four EduOM_ParallelScan(ObjectID*, Four, EduOM_ScanPredicate*, EduOM_ScanFilter, void*, Four, ObjectID*, Four*);
+Four EduOM_PaxCloseScan(EduOM_PaxCursor*);
+Four EduOM_PaxOpenScan(ObjectID*, Two, Two*, EduOM_PaxCursor*);
+Four EduOM_PaxScanNext(EduOM_PaxCursor*, ObjectID*, Four*, char**);
+Four EduOM_PinObject(ObjectID*, char**, Four*, EduOM_PinHandle*);
 Four EduOM_PrevObject(ObjectID*, ObjectID*, ObjectID*, ObjectHdr*);
 Four EduOM_ReadObject(ObjectID*, Four, Four, void*);
+Four EduOM_ScanNext(EduOM_ScanCursor*, ObjectID*, ObjectHdr*, char**);
+Four EduOM_SetScanFilter(EduOM_ScanCursor*, EduOM_ScanFilter, void*);
+Four EduOM_SetScanPredicate(EduOM_ScanCursor*, EduOM_ScanPredicate*);
+Four EduOM_TruncateFile(ObjectID*, Pool*, DeallocListElem*);
+Four EduOM_UnpinObject(EduOM_PinHandle*);
+Four EduOM_WriteObject(ObjectID*, Four, Four, void*);
 
 Four OM_DumpObject(ObjectID *);
 
@@ -25,6 +25,7 @@
 #ifndef _EDUOM_INTERNAL_H_
 #define _EDUOM_INTERNAL_H_
 
+#include "Util_pool.h"
 
 /*@
  * Type Definitions
@@ -49,10 +50,11 @@ typedef struct {
 typedef struct {
 	PageID pid;         /* page id of this page, should be located on the beginnig */
 	Four flags;         /* flag to store page information */
-	Four reserved;      /* reserved space to store page information */
+	Four reserved;      /* owned by the buffer manager: page checksum */
 	Two nSlots;         /* slots in use on the page */
 	Two free;           /* offset of contiguous free area on page */
 	Two unused;         /* number of unused bytes which are not part of the contiguous freespace */
+	Two freeSlot;       /* last empty slot of the free slot list, NIL if none (see SP_FREESLOTLIST) */
 	FileID fid;         /* fileID within its volume */
 	Unique unique;      /* unique number to allocate */
 	Unique uniqueLimit;     /* limit of valid unique numbers */
@@ -75,6 +77,191 @@ typedef struct {
 } SlottedPage;
 
 
+/*
+ *----------------- Typedefs for PAX Pages --------------------
+ */
+
+/*
+ * A PAX page holds fixed-length records partitioned by column: the values
+ * of a column are kept together in the minipage of the column, so that a
+ * scan of a few columns touches only their minipages. The record 'i' of the
+ * page is the object whose slot number is 'i'; all the records share the
+ * unique number of the page. A PAX page keeps the header of the slotted
+ * page, which links it into the file, but has no slot and no free space
+ * for the slotted page routines, so they skip it.
+ */
+#define PAX_PAGE_TYPE       0x7     /* unlike the types of the other pages, e.g. BTREE_PAGE_TYPE 0x5 */
+#define PAX_MAX_COLUMNS     16  /* # of columns of a record */
+
+/*
+ * Typedef for the header following the slotted page header
+ */
+typedef struct {
+	Two nColumns;       /* # of columns of a record */
+	Two nRecords;       /* # of records on the page */
+	Two maxRecords;     /* # of records the minipages have room for */
+	Two width[PAX_MAX_COLUMNS];     /* length of a value of each column */
+	Two minipage[PAX_MAX_COLUMNS];  /* offset of the minipage of each column in 'data' */
+} PaxPageHdr;
+
+#define PAX_FIXED (sizeof(SlottedPageHdr) + sizeof(PaxPageHdr))
+
+/* # of records of 'recordLength' bytes a page has room for, each minipage starting aligned */
+#define PAX_MAX_RECORDS(nColumns, recordLength) \
+	((Four)(PAGESIZE - ALIGNED_LENGTH((Four)PAX_FIXED) - (nColumns) * (Four)(ALIGN - 1)) / (recordLength))
+
+typedef struct {
+	SlottedPageHdr header;  /* header of the slotted page; 'nSlots' is 0 and 'free' covers the page */
+	PaxPageHdr pax;         /* columns and records of the page */
+	char data[PAGESIZE-PAX_FIXED];  /* the minipages */
+} PaxPage;
+
+
+/*
+ *----------------- Typedefs for Fixed-Length Record Pages --------------------
+ */
+
+/*
+ * A fixed-length record page holds records of one length without a slot or
+ * an object header per record: the record 'i' is at 'i' times the aligned
+ * length from the start of the records and is present if the bit 'i' of
+ * the bitmap is set. The record 'i' of the page is the object whose slot
+ * number is 'i'; its unique number is the entry 'i' of the array following
+ * the bitmap, so that a record put where a destroyed one was is not
+ * reached by the ObjectID of the destroyed record. Like
+ * a PAX page, the page keeps the header of the slotted page, which links it
+ * into the file, but has no slot and no free space for the slotted page
+ * routines, so they skip it.
+ */
+#define FIXED_PAGE_TYPE     0x6
+
+/*
+ * Typedef for the header following the slotted page header
+ */
+typedef struct {
+	Two length;         /* length of a record */
+	Two nRecords;       /* # of records present on the page */
+	Two maxRecords;     /* # of records the page has room for */
+	Two firstFree;      /* no record is absent before this record */
+	Two uniques;        /* offset of the unique numbers of the records in 'data'; the bitmap is at 0 */
+	Two records;        /* offset of the records in 'data' */
+} FixedPageHdr;
+
+#define FIXED_FIXED (sizeof(SlottedPageHdr) + sizeof(FixedPageHdr))
+
+typedef struct {
+	SlottedPageHdr header;  /* header of the slotted page; 'nSlots' is 0 and 'free' covers the page */
+	FixedPageHdr fixed;     /* length and records of the page */
+	char data[PAGESIZE-FIXED_FIXED];  /* the bitmap, the unique numbers and the records */
+} FixedPage;
+
+
+/*
+ *----------------- Typedefs for Large Object Trees --------------------
+ */
+
+/*
+ * A large object is an object in a slotted page whose data area holds the
+ * root of a tree; the data of the object is kept in the leaf nodes and the
+ * 'length' of the object header is the length of the data. The nodes are
+ * trains of the LOT_LEAF_BUF buffer pool. All the leaves but the last one
+ * are full, so the leaf holding a byte is found by its position; the tree
+ * grows at the root like a B+ tree as the object is appended.
+ */
+#define LOT_TRAINSIZE       4   /* # of pages of a train of LOT_LEAF_BUF */
+#define LOT_ROOT_FANOUT     30  /* # of children of the root */
+
+#define LOT_I_NODE_TYPE     0x3
+#define LOT_L_NODE_TYPE     0x4
+
+/*
+ * Typedef for the header of a node
+ */
+typedef struct {
+	PageID pid;         /* page id of the train, should be located on the beginnig */
+	Four flags;         /* flag to store page information */
+} LOT_NodeHdr;
+
+#define LOT_NODE_DATA_SIZE  (LOT_TRAINSIZE*PAGESIZE - sizeof(LOT_NodeHdr))
+#define LOT_I_NODE_FANOUT   ((CONSTANT_CASTING_TYPE)(LOT_NODE_DATA_SIZE / sizeof(ShortPageID)))
+#define LOT_L_NODE_SIZE     ((CONSTANT_CASTING_TYPE)LOT_NODE_DATA_SIZE)
+
+/*
+ * Typedef for the internal node
+ */
+typedef struct {
+	LOT_NodeHdr header;
+	ShortPageID child[LOT_NODE_DATA_SIZE / sizeof(ShortPageID)]; /* children in the order of the data */
+} LOT_INode;
+
+/*
+ * Typedef for the leaf node
+ */
+typedef struct {
+	LOT_NodeHdr header;
+	char data[LOT_NODE_DATA_SIZE];  /* data of the object */
+} LOT_LNode;
+
+/*
+ * Typedef for the root, kept in the data area of the object
+ */
+typedef struct {
+	Four height;        /* height of the tree; 0 if no leaf, 1 if the children are leaves */
+	ShortPageID child[LOT_ROOT_FANOUT]; /* children in the order of the data */
+} LOT_Root;
+
+
+/*
+ *----------------- Typedefs for Free Space Maps --------------------
+ */
+
+/*
+ * The free space map of a data file keeps one byte per page, the free space
+ * of the page in units of FSM_UNIT bytes rounded down, as the leaves of a
+ * max-tree, so that a page having enough free space is found in O(log n).
+ * The maps are kept in main memory and are built from the pages of the file
+ * when first searched; they are only a hint, and a page found is checked.
+ */
+#define FSM_UNIT            (PAGESIZE / 256)    /* bytes of a free space category */
+#define FSM_MAX_FILES       16                  /* # of maps kept in main memory */
+#define FSM_MIN_LEAVES      64                  /* initial # of leaves of a map */
+#define FSM_NUM_RECENT      32 /* # of pages tried before searching the tree */
+
+typedef struct {
+	ObjectID catObj;    /* catalog object of the file */
+	Four nLeaves;       /* # of leaves, a power of 2 greater than the page numbers */
+	UOne *tree;         /* tree[1] is the root and the leaf of page p is tree[nLeaves + p]; NULL if unused */
+	ShortPageID recent[FSM_NUM_RECENT]; /* pages whose free space grew last, most likely in the buffer; NIL if none */
+	Four nextRecent;    /* slot of 'recent' to be replaced next */
+	Four lastUsed;      /* time of the last use, for replacement */
+} FreeSpaceMap;
+
+
+/*
+ *----------------- Typedefs for the Catalog Cache --------------------
+ */
+
+/*
+ * Copies of the catalog entries of the data files kept in main memory; a
+ * copy is read again from the catalog page when the entry is changed.
+ * With the copy are kept the fixed-length record pages of the file which
+ * were added or had a record destroyed last, as a hint for the records
+ * created.
+ */
+#define CATCACHE_MAX_FILES  16                  /* # of copies kept in main memory */
+#define CATCACHE_NUM_FIXED  16                  /* # of fixed-length record pages kept */
+
+typedef struct {
+	ObjectID catObj;    /* catalog object of the file */
+	Boolean valid;      /* does 'entry' hold the catalog entry of 'catObj'? */
+	sm_CatOverlayForData entry; /* copy of the catalog entry */
+	Four lastUsed;      /* time of the last use, for replacement */
+	ShortPageID fixedRoom[CATCACHE_NUM_FIXED]; /* fixed-length record pages having room, latest last */
+	Two fixedRoomLength[CATCACHE_NUM_FIXED];   /* length of the records of each page */
+	Four nFixedRoom;    /* # of pages in 'fixedRoom' */
+} CatalogCacheEntry;
+
+
 /*@
  * Macro Function Definitions
  */
@@ -88,6 +275,16 @@ typedef struct {
  */
 #define SP_FREE(p)  ((p)->header.unused + SP_CFREE(p))
 
+/* Macro: SP_AVAILSPACELIST_NO(freeSpace)
+ * Description: return the available space list of a page as om_PutInAvailSpaceList() chooses it:
+ *              n for the list of the pages having n*10% or more of free space, 5 for 50% or
+ *              more, and 0 for no list
+ * Parameter:
+ *  Four freeSpace      : size of total free area of the page
+ * Returns: (Four) number of the list
+ */
+#define SP_AVAILSPACELIST_NO(freeSpace) MIN((freeSpace) * 10 / (Four)(PAGESIZE - SP_FIXED), 5)
+
 /* Macro: SP_CFREE(p)
  * Description: return the size of contiguous free area of the page given as a parameter
  * Parameter:
@@ -108,6 +305,46 @@ typedef struct {
 /* The empty slots have EMPTYSLOT with the 'offset' */
 #define EMPTYSLOT       -1
 
+/* Flag of the slotted page: the free slot list is maintained.
+ * The empty slots below 'nSlots' are linked through their 'unique' field
+ * into a doubly linked circular list; 'freeSlot' is the last slot of the list.
+ * The last slot of the slot array is never empty, so that a page without
+ * objects has no slot. 'freeSlot' takes the alignment gap before 'fid' and
+ * 'reserved' is left to the buffer manager, which stores the page checksum
+ * there. The list of a page initialized outside EduOM is built on its first
+ * use (eduom_CheckFreeSlotList()).
+ */
+#define SP_FREESLOTLIST 0x100
+
+/* Macro: SP_NEXTFREESLOT(p, s)
+ * Description: return the empty slot following the given one in the free slot list
+ * Parameters:
+ *  SlottedPage *p      : pointer to the page
+ *  Two s               : empty slot on the free slot list
+ * Returns: (Two) next empty slot; the first one if 's' is the last one
+ */
+#define SP_NEXTFREESLOT(p, s) ((Two)((p)->slot[-(s)].unique & 0xFFFF))
+
+/* Macro: SP_PREVFREESLOT(p, s)
+ * Description: return the empty slot preceding the given one in the free slot list
+ * Parameters:
+ *  SlottedPage *p      : pointer to the page
+ *  Two s               : empty slot on the free slot list
+ * Returns: (Two) previous empty slot; the last one if 's' is the first one
+ */
+#define SP_PREVFREESLOT(p, s) ((Two)(((p)->slot[-(s)].unique >> 16) & 0xFFFF))
+
+/* Macro: SP_SETFREESLOTLINKS(p, s, prev, next)
+ * Description: set the links of an empty slot on the free slot list
+ * Parameters:
+ *  SlottedPage *p      : pointer to the page
+ *  Two s               : empty slot on the free slot list
+ *  Two prev            : previous empty slot
+ *  Two next            : next empty slot
+ */
+#define SP_SETFREESLOTLINKS(p, s, prev, next) \
+((p)->slot[-(s)].unique = ((Unique)(UTwo)(prev) << 16) | (Unique)(UTwo)(next))
+
 /* Macro: IS_VALID_OBJECTID(oid, s_page)
  * Description: check whether the object ID given as a parameter is valid or not
  * Parameters:
@@ -121,6 +358,113 @@ typedef struct {
 
 #define LRGOBJ_THRESHOLD (PAGESIZE - SP_FIXED - sizeof(ObjectHdr))
 
+/* Macro: LOT_NUM_LEAVES(length)
+ * Description: return the # of leaves of a large object
+ * Parameter:
+ *  Four length         : length of the large object
+ * Returns: (Four) # of leaves
+ */
+#define LOT_NUM_LEAVES(length) (((length) + LOT_L_NODE_SIZE - 1) / LOT_L_NODE_SIZE)
+
+/* Macro: DATA_LENGTH_IN_PAGE(length)
+ * Description: return the length of the data area of a small object in the slotted page;
+ *              the area can hold an ObjectID, so that the object can be made a stub
+ * Parameter:
+ *  Four length         : length of the small object
+ * Returns: (Four) length of the data area
+ */
+#define DATA_LENGTH_IN_PAGE(length) MAX((length), (Four)MIN_OBJECT_DATA_SIZE)
+
+/* Macro: OBJ_LENGTH_IN_PAGE(obj)
+ * Description: return the length of the data area of the object in the slotted page;
+ *              it is the size of the root for a large object
+ * Parameter:
+ *  Object *obj         : pointer to the object
+ * Returns: (Four) length of the data area
+ */
+#define OBJ_LENGTH_IN_PAGE(obj) \
+	(((obj)->header.properties & P_LRGOBJ) ? (Four)sizeof(LOT_Root) : DATA_LENGTH_IN_PAGE((obj)->header.length))
+
+/* Macro: SP_IS_FORWARDED(p, i)
+ * Description: return TRUE if the nonempty slot holds a forwarded record, which
+ *              is reached only through the stub of the moved object
+ * Parameter:
+ *  SlottedPage *p      : pointer to the page
+ *  Two i               : slot number
+ * Returns: (Boolean) TRUE if the slot holds a forwarded record
+ */
+#define SP_IS_FORWARDED(p, i) \
+	((((Object *)((p)->data + (p)->slot[-1*(i)].offset))->header.properties & P_FORWARDED) != 0)
+
+/* Macro: IS_SLOTTED_PAGE(p)
+ * Description: return TRUE if the page of a data file is a slotted page
+ * Parameter:
+ *  SlottedPage *p      : pointer to the page
+ * Returns: (Boolean) TRUE if the page is a slotted page
+ */
+#define IS_SLOTTED_PAGE(p) ((((Page *)(p))->header.flags & PAGE_TYPE_VECTOR_MASK) == SLOTTED_PAGE_TYPE)
+
+/* Macro: IS_PAX_PAGE(p)
+ * Description: return TRUE if the page of a data file is a PAX page
+ * Parameter:
+ *  SlottedPage *p      : pointer to the page
+ * Returns: (Boolean) TRUE if the page is a PAX page
+ */
+#define IS_PAX_PAGE(p) ((((Page *)(p))->header.flags & PAGE_TYPE_VECTOR_MASK) == PAX_PAGE_TYPE)
+
+/* Macro: IS_FIXED_PAGE(p)
+ * Description: return TRUE if the page of a data file is a fixed-length record page
+ * Parameter:
+ *  SlottedPage *p      : pointer to the page
+ * Returns: (Boolean) TRUE if the page is a fixed-length record page
+ */
+#define IS_FIXED_PAGE(p) ((((Page *)(p))->header.flags & PAGE_TYPE_VECTOR_MASK) == FIXED_PAGE_TYPE)
+
+/* Macro: FIXED_IS_SET(p, i)
+ * Description: return TRUE if the record is present on the fixed-length record page
+ * Parameter:
+ *  FixedPage *p        : pointer to the page
+ *  Two i               : record number
+ * Returns: (Boolean) TRUE if the record is present
+ */
+#define FIXED_IS_SET(p, i) \
+	((i) >= 0 && (i) < (p)->fixed.maxRecords && ((UOne)(p)->data[(i) >> 3] & (1 << ((i) & 7))) != 0)
+
+/* Macro: FIXED_RECORD(p, i)
+ * Description: return a pointer to the record on the fixed-length record page
+ * Parameter:
+ *  FixedPage *p        : pointer to the page
+ *  Two i               : record number
+ * Returns: (char *) pointer to the record
+ */
+#define FIXED_RECORD(p, i) \
+	((p)->data + (p)->fixed.records + (Four)(i) * ALIGNED_LENGTH((Four)(p)->fixed.length))
+
+/* Macro: FIXED_UNIQUE(p, i)
+ * Description: return the unique number of the record on the fixed-length record page
+ * Parameter:
+ *  FixedPage *p        : pointer to the page
+ *  Two i               : record number
+ * Returns: (Unique) unique number of the record; an lvalue
+ */
+#define FIXED_UNIQUE(p, i) (((Unique *)((p)->data + (p)->fixed.uniques))[i])
+
+/* Macro: FIXED_IS_VALID_OBJECTID(oid, p)
+ * Description: return TRUE if the object is a present record of the fixed-length record page
+ * Parameter:
+ *  ObjectID *oid       : object identifier
+ *  FixedPage *p        : pointer to the page
+ * Returns: (Boolean) TRUE if the record is present and has the unique number of the object
+ */
+#define FIXED_IS_VALID_OBJECTID(oid, p) \
+	(FIXED_IS_SET(p, (oid)->slotNo) && FIXED_UNIQUE(p, (oid)->slotNo) == (oid)->unique)
+
+/* Macro: FIXED_MAX_LENGTH
+ * Description: the longest record of a fixed-length record page, which holds one such record
+ */
+#define FIXED_MAX_LENGTH \
+	((Four)(PAGESIZE - ALIGNED_LENGTH(ALIGNED_LENGTH((Four)FIXED_FIXED + 1) + (Four)sizeof(Unique))))
+
 /* Macro: GET_PTR_TO_CATENTRY_FOR_DATA(catObjForFile, catPage, catEntry)
  * Description: get the information about the data file(sm_CatOverlayForData) residing in the catalog object for data file
  * Parameters:
@@ -140,11 +484,44 @@ typedef struct {
  * Function Prototypes
  */
 /* internal function prototypes */
+Two eduom_AllocSlot(SlottedPage*);
+void eduom_CheckFreeSlotList(SlottedPage*);
 Four eduom_CreateObject(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*);
+Four eduom_FileMapAddPage(ObjectID*, PageID*, PageID*);
+Four eduom_FileMapDeletePage(ObjectID*, PageID*);
+Four eduom_FileMapTruncate(ObjectID*);
+Two eduom_FixedAllocRecord(FixedPage*, Unique);
+void eduom_FixedFreeRecord(FixedPage*, Two);
+void eduom_FixedInitPage(FixedPage*, FileID, PageID, Two);
+Two eduom_FixedNextRecord(FixedPage*, Two);
+Two eduom_FixedPrevRecord(FixedPage*, Two);
+Four eduom_FixedRead(FixedPage*, Two, Four, Four, char*);
+void eduom_FixedRoomAdd(ObjectID*, PageNo, Two);
+PageNo eduom_FixedRoomGet(ObjectID*, Two);
+void eduom_FixedRoomRemove(ObjectID*, PageNo);
+Four eduom_FollowForward(PageID*, SlottedPage**, Object**);
+void eduom_FreeSlot(SlottedPage*, Two);
+void eduom_FsmDropFile(ObjectID*);
+Four eduom_FsmFindPage(ObjectID*, sm_CatOverlayForData*, Four, PageID*);
+void eduom_FsmRemovePage(ObjectID*, PageID*);
+void eduom_FsmUpdatePage(ObjectID*, PageID*, SlottedPage*);
+Four eduom_GetCatalogEntry(ObjectID*, sm_CatOverlayForData**);
+Four eduom_GetUnique(PageID*, SlottedPage*, Unique*);
+Four eduom_PutInAvailSpaceList(ObjectID*, PageID*, SlottedPage*, Four);
+Four eduom_RefreshCatalogEntry(ObjectID*);
+Four eduom_RemoveFromAvailSpaceList(ObjectID*, PageID*, SlottedPage*, Four);
+void eduom_InitPageHeader(SlottedPage*, FileID, PageID);
+Four eduom_LotAppend(ObjectID*, PageID*, Object*, Four, char*);
+Four eduom_LotCreate(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*);
+Four eduom_LotDestroy(Object*, VolNo, Pool*, DeallocListElem*);
+Four eduom_LotRead(Object*, VolNo, Four, Four, char*);
+Four eduom_LotWrite(Object*, VolNo, Four, Four, char*);
+void eduom_PaxInitPage(PaxPage*, FileID, PageID, Two, Two*);
+Four eduom_PaxRead(PaxPage*, Two, Four, Four, char*);
+Boolean eduom_ResizeObject(SlottedPage*, Two, Four);
 
 Four om_FileMapAddPage(ObjectID*, PageID*, PageID*);
 Four om_FileMapDeletePage(ObjectID*, PageID*);
-Four om_GetUnique(PageID*, Unique*);
 Four om_IsTemporary(FileID*, Boolean*);
 Four om_PutInAvailSpaceList(ObjectID*, PageID*, SlottedPage*);
 Four om_RemoveFromAvailSpaceList(ObjectID*, PageID*, SlottedPage*);
@@ -53,6 +53,10 @@ typedef UFour                   UFour_Invariable;
 /* Boolean Type */
 typedef enum { FALSE, TRUE } Boolean;
 
+/* Comparison Operator */
+/* WARNING: DO NOT change the number. The numbers have some meanings; bit properties. */
+typedef enum {SM_EQ=0x1, SM_LT=0x2, SM_LE=0x3, SM_GT=0x4, SM_GE=0x5, SM_NE=0x6, SM_EOF=0x10, SM_BOF=0x20} CompOp;
+
 /* data & memory align type */
 typedef Four_Invariable         ALIGN_TYPE;
 
@@ -53,6 +53,22 @@
 #define REMAINDER -1
 
 
+/*
+ * Data Type Supported by the scan predicate
+ */
+#define SM_SHORT                0
+#define SM_INT                  1
+#define SM_LONG                 2
+#define SM_FLOAT                3
+#define SM_DOUBLE               4
+#define SM_STRING               5   /* fixed-length string */
+#define SM_SHORT_SIZE           sizeof(Two_Invariable)
+#define SM_INT_SIZE             sizeof(Four_Invariable)
+#define SM_LONG_SIZE            sizeof(Four_Invariable)
+#define SM_FLOAT_SIZE           sizeof(float)
+#define SM_DOUBLE_SIZE          sizeof(double)
+
+
 /*
 ** Type Definition of PageID
 */
@@ -124,6 +140,17 @@ typedef struct {        /* ObjectID is used accross the volumes */
 #define MAKE_OBJECTID(oid, v, p, s, u) \
 	(oid).volNo = (v), (oid).pageNo = (p), (oid).slotNo = (s), (oid).unique = (u)
 
+/* Macro: EQUAL_OBJECTID(x, y)
+ * Description: check whether the two object IDs are equal
+ * Parameters:
+ *  ObjectID x      : object ID
+ *  ObjectID y      : object ID
+ * returns: TRUE(1) if x is equal to y, otherwise FALSE(0)
+ */
+#define EQUAL_OBJECTID(x, y) \
+	(((x).volNo == (y).volNo && (x).pageNo == (y).pageNo && \
+	  (x).slotNo == (y).slotNo && (x).unique == (y).unique) ? TRUE:FALSE)
+
 
 /*
  * Definition for Logical ID
@@ -190,7 +217,7 @@ typedef struct Lsn_T_tag {
 typedef struct PageHdr_T_tag {
 	PageID pid;                 /* page id of this page */
 	Four flags;
-	Four reserved;
+	Four reserved;              /* owned by the buffer manager: page checksum */
 	PageID fidOrIid;            /* file id or index id containing this page */
 	Lsn_T lsn;                  /* page lsn */
 	Four logRecLen;             /* log record length */
@@ -334,6 +361,8 @@ typedef struct _DeallocListElem DeallocListElem;
  */
 #undef MAX
 #define MAX(a,b) (((a) >= (b)) ? (a):(b))
+#undef MIN
+#define MIN(a,b) (((a) <= (b)) ? (a):(b))
 
 
 /*
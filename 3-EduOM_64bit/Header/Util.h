@@ -29,6 +29,7 @@
 #include "Util_pool.h"      /* to get pool */
 
 
+Four Util_freeElementToPool(Pool*, void*);
 Four Util_getElementFromPool(Pool*, void*);
 
 
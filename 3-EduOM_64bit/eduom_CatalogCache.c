@@ -0,0 +1,467 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : eduom_CatalogCache.c
+ *
+ * Description :
+ *  Keep copies of the catalog entries of the data files in main memory, so
+ *  that an object operation does not fix the catalog page only to read the
+ *  first and last pages of the file. The catalog entry itself is still
+ *  changed by the file map and available space list routines; a copy is
+ *  read again from the catalog page whenever one of them has changed it.
+ *  When more than CATCACHE_MAX_FILES files are used, the least recently
+ *  used copy is replaced.
+ *  The fixed-length record pages of a file which were added or had a record
+ *  destroyed last are kept with the copy, so that new records are created
+ *  in them.
+ *
+ * Exports:
+ *  Four eduom_GetCatalogEntry(ObjectID*, sm_CatOverlayForData**)
+ *  Four eduom_RefreshCatalogEntry(ObjectID*)
+ *  Four eduom_FileMapAddPage(ObjectID*, PageID*, PageID*)
+ *  Four eduom_FileMapDeletePage(ObjectID*, PageID*)
+ *  Four eduom_FileMapTruncate(ObjectID*)
+ *  void eduom_FixedRoomAdd(ObjectID*, PageNo, Two)
+ *  PageNo eduom_FixedRoomGet(ObjectID*, Two)
+ *  void eduom_FixedRoomRemove(ObjectID*, PageNo)
+ */
+
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+
+
+
+/*@ Global Variables */
+static CatalogCacheEntry eduom_catCache[CATCACHE_MAX_FILES];	/* the copies in main memory */
+static Four eduom_catClock = 0;			/* time of the lookups */
+static CatalogCacheEntry *eduom_catLast = NULL;	/* copy used last */
+
+
+
+/*@ Internal Function Prototypes */
+static CatalogCacheEntry *eduom_CatLookup(ObjectID*);
+static Four eduom_CatRead(ObjectID*, CatalogCacheEntry*);
+
+
+
+/*@================================
+ * eduom_CatLookup()
+ *================================*/
+/*
+ * Function: static CatalogCacheEntry *eduom_CatLookup(ObjectID*)
+ *
+ * Description :
+ *  Return the copy of the catalog entry of the file, or NULL if there is
+ *  none.
+ */
+static CatalogCacheEntry *eduom_CatLookup(
+    ObjectID	*catObjForFile)	/* IN catalog object of the file */
+{
+    Four	i;
+
+
+	if (eduom_catLast == NULL || !eduom_catLast->valid ||
+		!EQUAL_OBJECTID(eduom_catLast->catObj, *catObjForFile)) {
+		for (i = 0; i < CATCACHE_MAX_FILES; i++)
+			if (eduom_catCache[i].valid && EQUAL_OBJECTID(eduom_catCache[i].catObj, *catObjForFile)) break;
+		if (i == CATCACHE_MAX_FILES) return(NULL);
+
+		eduom_catLast = &eduom_catCache[i];
+	}
+
+	eduom_catLast->lastUsed = ++eduom_catClock;
+
+	return(eduom_catLast);
+
+} /* eduom_CatLookup() */
+
+
+
+/*@================================
+ * eduom_CatRead()
+ *================================*/
+/*
+ * Function: static Four eduom_CatRead(ObjectID*, CatalogCacheEntry*)
+ *
+ * Description :
+ *  Copy the catalog entry of the file from the catalog page.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_CatRead(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    CatalogCacheEntry	*entry)		/* OUT the copy */
+{
+    Four		e;			/* error number */
+    PhysicalFileID	pFid;		/* page ID of the catalog page */
+    SlottedPage		*catPage;	/* pointer to buffer containing the catalog */
+    sm_CatOverlayForData *catEntry;	/* catalog entry in the buffer */
+
+
+	entry->valid = FALSE;
+
+	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+	e = BfM_GetTrain(&pFid, (char **)&catPage, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	GET_PTR_TO_CATENTRY_FOR_DATA(catObjForFile, catPage, catEntry);
+	entry->entry = *catEntry;
+
+	e = BfM_FreeTrain(&pFid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	entry->catObj = *catObjForFile;
+	entry->valid = TRUE;
+
+	return(eNOERROR);
+
+} /* eduom_CatRead() */
+
+
+
+/*@================================
+ * eduom_GetCatalogEntry()
+ *================================*/
+/*
+ * Function: Four eduom_GetCatalogEntry(ObjectID*, sm_CatOverlayForData**)
+ *
+ * Description :
+ *  Return the copy of the catalog entry of the file, reading it from the
+ *  catalog page if it is not in main memory. The copy must not be changed
+ *  by the caller; it stays valid until the entry of another file is gotten.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_GetCatalogEntry(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    sm_CatOverlayForData **catEntry)	/* OUT the copy of the catalog entry */
+{
+    Four		e;			/* error number */
+    CatalogCacheEntry	*entry;		/* copy of the file */
+    Four		i;
+
+
+	entry = eduom_CatLookup(catObjForFile);
+	if (entry == NULL) {
+		entry = &eduom_catCache[0];
+		for (i = 0; i < CATCACHE_MAX_FILES; i++) {
+			if (!eduom_catCache[i].valid) { entry = &eduom_catCache[i]; break; }
+			if (eduom_catCache[i].lastUsed < entry->lastUsed) entry = &eduom_catCache[i];
+		}
+
+		e = eduom_CatRead(catObjForFile, entry);
+		if (e<0) ERR(e);
+
+		entry->nFixedRoom = 0;
+		entry->lastUsed = ++eduom_catClock;
+		eduom_catLast = entry;
+	}
+
+	*catEntry = &entry->entry;
+
+	return(eNOERROR);
+
+} /* eduom_GetCatalogEntry() */
+
+
+
+/*@================================
+ * eduom_RefreshCatalogEntry()
+ *================================*/
+/*
+ * Function: Four eduom_RefreshCatalogEntry(ObjectID*)
+ *
+ * Description :
+ *  Read the copy of the catalog entry of the file again, if there is one;
+ *  called after the catalog entry is changed.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_RefreshCatalogEntry(
+    ObjectID		*catObjForFile)	/* IN catalog object of the file */
+{
+    Four		e;			/* error number */
+    CatalogCacheEntry	*entry;		/* copy of the file */
+
+
+	entry = eduom_CatLookup(catObjForFile);
+	if (entry == NULL) return(eNOERROR);
+
+	e = eduom_CatRead(catObjForFile, entry);
+	if (e<0) ERR(e);
+
+	return(eNOERROR);
+
+} /* eduom_RefreshCatalogEntry() */
+
+
+
+/*@================================
+ * eduom_FileMapAddPage()
+ *================================*/
+/*
+ * Function: Four eduom_FileMapAddPage(ObjectID*, PageID*, PageID*)
+ *
+ * Description :
+ *  Insert a new page after 'prevPid' in the list of pages of the file.
+ *  The copy of the catalog entry is read again if the last page changes.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_FileMapAddPage(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    PageID		*prevPid,	/* IN page which the new page follows */
+    PageID		*newPid)	/* IN new page */
+{
+    Four		e;			/* error number */
+    CatalogCacheEntry	*entry;		/* copy of the file */
+
+
+	e = om_FileMapAddPage(catObjForFile, prevPid, newPid);
+	if (e<0) ERR(e);
+
+	entry = eduom_CatLookup(catObjForFile);
+	if (entry != NULL && entry->entry.lastPage == prevPid->pageNo) {
+		e = eduom_CatRead(catObjForFile, entry);
+		if (e<0) ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* eduom_FileMapAddPage() */
+
+
+
+/*@================================
+ * eduom_FileMapDeletePage()
+ *================================*/
+/*
+ * Function: Four eduom_FileMapDeletePage(ObjectID*, PageID*)
+ *
+ * Description :
+ *  Delete a page from the list of pages of the file.
+ *  The copy of the catalog entry is read again if the last page changes.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_FileMapDeletePage(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    PageID		*pid)		/* IN page to delete */
+{
+    Four		e;			/* error number */
+    CatalogCacheEntry	*entry;		/* copy of the file */
+
+
+	e = om_FileMapDeletePage(catObjForFile, pid);
+	if (e<0) ERR(e);
+
+	entry = eduom_CatLookup(catObjForFile);
+	if (entry != NULL && (entry->entry.lastPage == pid->pageNo || entry->entry.firstPage == pid->pageNo)) {
+		e = eduom_CatRead(catObjForFile, entry);
+		if (e<0) ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* eduom_FileMapDeletePage() */
+
+
+
+/*@================================
+ * eduom_FileMapTruncate()
+ *================================*/
+/*
+ * Function: Four eduom_FileMapTruncate(ObjectID*)
+ *
+ * Description :
+ *  Make the first page the only page of the file and empty the available
+ *  space lists in the catalog entry at once. The other pages are neither
+ *  unlinked nor freed; the caller deallocates them, and puts the first
+ *  page into the available space list again.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_FileMapTruncate(
+    ObjectID		*catObjForFile)	/* IN catalog object of the file */
+{
+    Four		e;			/* error number */
+    PhysicalFileID	pFid;		/* page ID of the catalog page */
+    SlottedPage		*catPage;	/* pointer to buffer containing the catalog */
+    sm_CatOverlayForData *catEntry;	/* catalog entry in the buffer */
+    CatalogCacheEntry	*entry;		/* copy of the file */
+
+
+	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+	e = BfM_GetTrain(&pFid, (char **)&catPage, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	GET_PTR_TO_CATENTRY_FOR_DATA(catObjForFile, catPage, catEntry);
+
+	catEntry->lastPage = catEntry->firstPage;
+	catEntry->availSpaceList10 = NIL;
+	catEntry->availSpaceList20 = NIL;
+	catEntry->availSpaceList30 = NIL;
+	catEntry->availSpaceList40 = NIL;
+	catEntry->availSpaceList50 = NIL;
+
+	e = BfM_SetDirty(&pFid, PAGE_BUF);
+	if (e<0) ERRB1(e, &pFid, PAGE_BUF);
+
+	e = BfM_FreeTrain(&pFid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	/* the fixed-length record pages remembered are gone */
+	entry = eduom_CatLookup(catObjForFile);
+	if (entry != NULL) {
+		e = eduom_CatRead(catObjForFile, entry);
+		if (e<0) ERR(e);
+		entry->nFixedRoom = 0;
+	}
+
+	return(eNOERROR);
+
+} /* eduom_FileMapTruncate() */
+
+
+
+/*@================================
+ * eduom_FixedRoomAdd()
+ *================================*/
+/*
+ * Function: void eduom_FixedRoomAdd(ObjectID*, PageNo, Two)
+ *
+ * Description :
+ *  Remember that the fixed-length record page of the file, of records of
+ *  'length' bytes, has room, if the copy of the catalog entry of the file
+ *  is in main memory. The page kept longest is forgotten when
+ *  CATCACHE_NUM_FIXED pages are kept.
+ */
+void eduom_FixedRoomAdd(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    PageNo		pageNo,		/* IN page having room */
+    Two			length)		/* IN length of the records of the page */
+{
+    CatalogCacheEntry	*entry;		/* copy of the file */
+
+
+	entry = eduom_CatLookup(catObjForFile);
+	if (entry == NULL) return;
+
+	if (entry->nFixedRoom > 0 && entry->fixedRoom[entry->nFixedRoom - 1] == pageNo) return;
+
+	eduom_FixedRoomRemove(catObjForFile, pageNo);
+
+	if (entry->nFixedRoom == CATCACHE_NUM_FIXED) {
+		memmove(&entry->fixedRoom[0], &entry->fixedRoom[1], sizeof(ShortPageID) * (CATCACHE_NUM_FIXED - 1));
+		memmove(&entry->fixedRoomLength[0], &entry->fixedRoomLength[1], sizeof(Two) * (CATCACHE_NUM_FIXED - 1));
+		entry->nFixedRoom--;
+	}
+	entry->fixedRoom[entry->nFixedRoom] = pageNo;
+	entry->fixedRoomLength[entry->nFixedRoom] = length;
+	entry->nFixedRoom++;
+
+} /* eduom_FixedRoomAdd() */
+
+
+
+/*@================================
+ * eduom_FixedRoomGet()
+ *================================*/
+/*
+ * Function: PageNo eduom_FixedRoomGet(ObjectID*, Two)
+ *
+ * Description :
+ *  Return the fixed-length record page of the file, of records of 'length'
+ *  bytes, remembered last. The page is only a hint: the caller checks it
+ *  and calls eduom_FixedRoomRemove() if it has no room.
+ *
+ * Returns:
+ *  page number, or NIL if no page is remembered
+ */
+PageNo eduom_FixedRoomGet(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    Two			length)		/* IN length of the records of the page */
+{
+    CatalogCacheEntry	*entry;		/* copy of the file */
+    Four		i;
+
+
+	entry = eduom_CatLookup(catObjForFile);
+	if (entry == NULL) return(NIL);
+
+	for (i = entry->nFixedRoom - 1; i >= 0; i--)
+		if (entry->fixedRoomLength[i] == length) return(entry->fixedRoom[i]);
+
+	return(NIL);
+
+} /* eduom_FixedRoomGet() */
+
+
+
+/*@================================
+ * eduom_FixedRoomRemove()
+ *================================*/
+/*
+ * Function: void eduom_FixedRoomRemove(ObjectID*, PageNo)
+ *
+ * Description :
+ *  Forget the page of the file, which has no room or is deallocated.
+ */
+void eduom_FixedRoomRemove(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    PageNo		pageNo)		/* IN page to forget */
+{
+    CatalogCacheEntry	*entry;		/* copy of the file */
+    Four		i;
+
+
+	entry = eduom_CatLookup(catObjForFile);
+	if (entry == NULL) return;
+
+	for (i = 0; i < entry->nFixedRoom; i++) {
+		if (entry->fixedRoom[i] == pageNo) {
+			memmove(&entry->fixedRoom[i], &entry->fixedRoom[i + 1], sizeof(ShortPageID) * (entry->nFixedRoom - i - 1));
+			memmove(&entry->fixedRoomLength[i], &entry->fixedRoomLength[i + 1], sizeof(Two) * (entry->nFixedRoom - i - 1));
+			entry->nFixedRoom--;
+			break;
+		}
+	}
+
+} /* eduom_FixedRoomRemove() */
@@ -0,0 +1,277 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : eduom_FixedPage.c
+ *
+ * Description :
+ *  Lay out, keep the bitmaps and the unique numbers of and read the
+ *  fixed-length record pages
+ *  (see FixedPage in EduOM_Internal.h).
+ *
+ * Exports:
+ *  Two eduom_FixedAllocRecord(FixedPage*, Unique)
+ *  void eduom_FixedFreeRecord(FixedPage*, Two)
+ *  void eduom_FixedInitPage(FixedPage*, FileID, PageID, Two)
+ *  Two eduom_FixedNextRecord(FixedPage*, Two)
+ *  Two eduom_FixedPrevRecord(FixedPage*, Two)
+ *  Four eduom_FixedRead(FixedPage*, Two, Four, Four, char*)
+ */
+
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "EduOM_Internal.h"
+
+
+
+/*@================================
+ * eduom_FixedInitPage()
+ *================================*/
+/*
+ * Function: void eduom_FixedInitPage(FixedPage*, FileID, PageID, Two)
+ *
+ * Description :
+ *  Initialize a new fixed-length record page for records of 'length'
+ *  bytes: the bitmap is put at the start of the data area and followed,
+ *  from aligned offsets, by the unique numbers of the records and by room
+ *  for as many records as fit together with their bits and unique
+ *  numbers. The caller checks that 'length' is at most FIXED_MAX_LENGTH.
+ */
+void eduom_FixedInitPage(
+    FixedPage	*apage,		/* OUT pointer to the buffer of the page */
+    FileID	fid,		/* IN file of the page */
+    PageID	pid,		/* IN page */
+    Two		length)		/* IN length of a record */
+{
+    Four	stride;		/* distance between two records */
+    Four	n;		/* # of records */
+    Four	uniques;	/* offset of the unique numbers from the start of the page */
+
+
+	eduom_InitPageHeader((SlottedPage*)apage, fid, pid);
+	SET_PAGE_TYPE(apage, FIXED_PAGE_TYPE);
+	apage->header.free = PAGESIZE - sizeof(SlottedPageHdr);
+
+	stride = ALIGNED_LENGTH((Four)length);
+
+	/* a record takes 'stride' bytes, a unique number and a bit; the bitmap is rounded up */
+	n = (Four)(PAGESIZE - FIXED_FIXED) * 8 / ((stride + (Four)sizeof(Unique)) * 8 + 1);
+	while (ALIGNED_LENGTH(ALIGNED_LENGTH((Four)FIXED_FIXED + (n + 7) / 8) + n * (Four)sizeof(Unique)) + n * stride > PAGESIZE) n--;
+	uniques = ALIGNED_LENGTH((Four)FIXED_FIXED + (n + 7) / 8);
+
+	apage->fixed.length = length;
+	apage->fixed.nRecords = 0;
+	apage->fixed.maxRecords = n;
+	apage->fixed.firstFree = 0;
+	apage->fixed.uniques = uniques - FIXED_FIXED;
+	apage->fixed.records = ALIGNED_LENGTH(uniques + n * (Four)sizeof(Unique)) - FIXED_FIXED;
+
+	memset(apage->data, 0, (n + 7) / 8);
+
+} /* eduom_FixedInitPage() */
+
+
+
+/*@================================
+ * eduom_FixedAllocRecord()
+ *================================*/
+/*
+ * Function: Two eduom_FixedAllocRecord(FixedPage*, Unique)
+ *
+ * Description :
+ *  Mark the first absent record of the page present with the unique number
+ *  'unique' and return it. The caller checks that the page has an absent
+ *  record and takes 'unique' from eduom_GetUnique().
+ *
+ * Returns:
+ *  record number
+ */
+Two eduom_FixedAllocRecord(
+    FixedPage	*apage,		/* INOUT pointer to the buffer of the page */
+    Unique	unique)		/* IN unique number of the record */
+{
+    Two		i;		/* record */
+    UOne	*bitmap;	/* bitmap of the page */
+
+
+	bitmap = (UOne*)apage->data;
+
+	/* skip the bytes of the bitmap whose records are all present */
+	for (i = apage->fixed.firstFree & ~7; bitmap[i >> 3] == 0xff; i += 8);
+	for (; FIXED_IS_SET(apage, i); i++);
+
+	bitmap[i >> 3] |= (1 << (i & 7));
+	FIXED_UNIQUE(apage, i) = unique;
+	apage->fixed.nRecords++;
+	apage->fixed.firstFree = i + 1;
+
+	return(i);
+
+} /* eduom_FixedAllocRecord() */
+
+
+
+/*@================================
+ * eduom_FixedFreeRecord()
+ *================================*/
+/*
+ * Function: void eduom_FixedFreeRecord(FixedPage*, Two)
+ *
+ * Description :
+ *  Mark the present record of the page absent.
+ */
+void eduom_FixedFreeRecord(
+    FixedPage	*apage,		/* INOUT pointer to the buffer of the page */
+    Two		i)		/* IN record */
+{
+    UOne	*bitmap;	/* bitmap of the page */
+
+
+	bitmap = (UOne*)apage->data;
+
+	bitmap[i >> 3] &= ~(1 << (i & 7));
+	apage->fixed.nRecords--;
+	if (i < apage->fixed.firstFree) apage->fixed.firstFree = i;
+
+} /* eduom_FixedFreeRecord() */
+
+
+
+/*@================================
+ * eduom_FixedNextRecord()
+ *================================*/
+/*
+ * Function: Two eduom_FixedNextRecord(FixedPage*, Two)
+ *
+ * Description :
+ *  Return the first present record of the page from the record 'i'.
+ *
+ * Returns:
+ *  record number, or NIL if there is none
+ */
+Two eduom_FixedNextRecord(
+    FixedPage	*apage,		/* IN pointer to the buffer of the page */
+    Two		i)		/* IN record to start from */
+{
+    UOne	*bitmap;	/* bitmap of the page */
+
+
+	bitmap = (UOne*)apage->data;
+
+	if (i < 0) i = 0;
+
+	while (i < apage->fixed.maxRecords) {
+		/* skip the bytes of the bitmap whose records are all absent */
+		if ((i & 7) == 0 && bitmap[i >> 3] == 0) {
+			i += 8;
+			continue;
+		}
+		if (bitmap[i >> 3] & (1 << (i & 7))) return(i);
+		i++;
+	}
+
+	return(NIL);
+
+} /* eduom_FixedNextRecord() */
+
+
+
+/*@================================
+ * eduom_FixedPrevRecord()
+ *================================*/
+/*
+ * Function: Two eduom_FixedPrevRecord(FixedPage*, Two)
+ *
+ * Description :
+ *  Return the last present record of the page up to the record 'i'.
+ *
+ * Returns:
+ *  record number, or NIL if there is none
+ */
+Two eduom_FixedPrevRecord(
+    FixedPage	*apage,		/* IN pointer to the buffer of the page */
+    Two		i)		/* IN record to start from */
+{
+    UOne	*bitmap;	/* bitmap of the page */
+
+
+	bitmap = (UOne*)apage->data;
+
+	if (i >= apage->fixed.maxRecords) i = apage->fixed.maxRecords - 1;
+
+	while (i >= 0) {
+		/* skip the bytes of the bitmap whose records are all absent */
+		if ((i & 7) == 7 && bitmap[i >> 3] == 0) {
+			i -= 8;
+			continue;
+		}
+		if (bitmap[i >> 3] & (1 << (i & 7))) return(i);
+		i--;
+	}
+
+	return(NIL);
+
+} /* eduom_FixedPrevRecord() */
+
+
+
+/*@================================
+ * eduom_FixedRead()
+ *================================*/
+/*
+ * Function: Four eduom_FixedRead(FixedPage*, Two, Four, Four, char*)
+ *
+ * Description :
+ *  Copy the bytes from 'start' of a record of a fixed-length record page
+ *  into 'buf'.
+ *
+ * Returns:
+ *  1) number of bytes read
+ *  2) error code
+ *    eBADOBJECTID_OM
+ *    eBADSTART_OM
+ *    eBADLENGTH_OM
+ */
+Four eduom_FixedRead(
+    FixedPage	*apage,		/* IN pointer to the buffer of the page */
+    Two		recordNo,	/* IN record to read */
+    Four	start,		/* IN starting offset of read */
+    Four	length,		/* IN amount of data to read; REMAINDER for the rest */
+    char	*buf)		/* OUT user buffer */
+{
+
+	if (!FIXED_IS_SET(apage, recordNo)) ERR(eBADOBJECTID_OM);
+
+	if (start < 0 || start > apage->fixed.length) ERR(eBADSTART_OM);
+
+	if (length == REMAINDER) length = apage->fixed.length - start;
+
+	if (length < 0 || start + length > apage->fixed.length) ERR(eBADLENGTH_OM);
+
+	memcpy(buf, FIXED_RECORD(apage, recordNo) + start, length);
+
+	return(length);
+
+} /* eduom_FixedRead() */
@@ -0,0 +1,157 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : eduom_ForwardObject.c
+ *
+ * Description :
+ *  Support the objects which are updated in place. An object growing out
+ *  of its page is moved to another page as a forwarded record (P_FORWARDED)
+ *  and its slot keeps a stub (P_MOVED) whose data is the ObjectID of the
+ *  forwarded record, so that the ObjectID of the object never changes.
+ *  A forwarded record is reached only through its stub; the scans skip it.
+ *
+ * Exports:
+ *  Four eduom_FollowForward(PageID*, SlottedPage**, Object**)
+ *  Boolean eduom_ResizeObject(SlottedPage*, Two, Four)
+ */
+
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+#include "EduOM.h"
+
+
+
+/*@================================
+ * eduom_FollowForward()
+ *================================*/
+/*
+ * Function: Four eduom_FollowForward(PageID*, SlottedPage**, Object**)
+ *
+ * Description :
+ *  If the object is a stub, unfix its page and fix the page of the
+ *  forwarded record instead; otherwise nothing is done. On return the
+ *  parameters refer to the object holding the data, whose page is fixed.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_FollowForward(
+    PageID		*pid,		/* INOUT page of the object */
+    SlottedPage	**apage,	/* INOUT pointer to the buffer of the page */
+    Object		**obj)		/* INOUT pointer to the object */
+{
+    Four		e;			/* error number */
+    ObjectID	fwdOid;		/* the forwarded record */
+
+
+	if (!((*obj)->header.properties & P_MOVED)) return(eNOERROR);
+
+	memcpy(&fwdOid, (*obj)->data, sizeof(ObjectID));
+
+	e = BfM_FreeTrain(pid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	MAKE_PAGEID(*pid, fwdOid.volNo, fwdOid.pageNo);
+	e = BfM_GetTrain(pid, (char **)apage, PAGE_BUF);
+	if (e<0) ERR(e);
+	*obj = (Object *)((*apage)->data + (*apage)->slot[-1*fwdOid.slotNo].offset);
+
+	return(eNOERROR);
+
+} /* eduom_FollowForward() */
+
+
+
+/*@================================
+ * eduom_ResizeObject()
+ *================================*/
+/*
+ * Function: Boolean eduom_ResizeObject(SlottedPage*, Two, Four)
+ *
+ * Description :
+ *  Resize the data area of an object in its page, keeping the data which
+ *  fits. An object shrinks in place. An object grows in place if it is
+ *  followed by the contiguous free area; otherwise it is copied to the
+ *  contiguous free area if it fits there, and moved to the end of the data
+ *  area by compacting the page if not. The page is not changed if it has
+ *  not enough free space.
+ *  The caller sets the length in the object header, and passes the free
+ *  space of the page before the call to eduom_PutInAvailSpaceList()
+ *  afterwards.
+ *
+ * Returns:
+ *  TRUE if the object is resized, FALSE if it does not fit in the page
+ */
+Boolean eduom_ResizeObject(
+    SlottedPage	*apage,		/* INOUT slotted page */
+    Two			slotNo,		/* IN slot of the object */
+    Four		length)		/* IN new length of the data area */
+{
+    Object	*obj;			/* pointer to the object */
+    Four	oldLen;			/* aligned length of the data area */
+    Four	newLen;			/* aligned new length of the data area */
+    Boolean	last;			/* is the object followed by the contiguous free area? */
+
+
+	obj = (Object *)(apage->data + apage->slot[-1*slotNo].offset);
+	oldLen = ALIGNED_LENGTH(OBJ_LENGTH_IN_PAGE(obj));
+	newLen = ALIGNED_LENGTH(DATA_LENGTH_IN_PAGE(length));
+	last = (apage->slot[-1*slotNo].offset + sizeof(ObjectHdr) + oldLen == apage->header.free);
+
+	if (newLen <= oldLen) {
+		if (last)
+			apage->header.free -= oldLen - newLen;
+		else
+			apage->header.unused += oldLen - newLen;
+
+		return(TRUE);
+	}
+
+	if (newLen - oldLen > SP_FREE(apage)) return(FALSE);
+
+	if (last && newLen - oldLen <= SP_CFREE(apage)) {
+		apage->header.free += newLen - oldLen;
+		return(TRUE);
+	}
+
+	if (sizeof(ObjectHdr) + newLen <= SP_CFREE(apage)) {
+		/* move the object to the contiguous free area; its old place becomes unused */
+		memcpy(apage->data + apage->header.free, obj, sizeof(ObjectHdr) + oldLen);
+		apage->slot[-1*slotNo].offset = apage->header.free;
+		apage->header.free += sizeof(ObjectHdr) + newLen;
+		apage->header.unused += sizeof(ObjectHdr) + oldLen;
+		return(TRUE);
+	}
+
+	EduOM_CompactPage(apage, slotNo);
+	apage->header.free += newLen - oldLen;
+
+	return(TRUE);
+
+} /* eduom_ResizeObject() */
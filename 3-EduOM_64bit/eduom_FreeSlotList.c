@@ -0,0 +1,227 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : eduom_FreeSlotList.c
+ *
+ * Description :
+ *  Maintain the free slot list of a slotted page, so that a slot is
+ *  allocated and freed without scanning the slot array.
+ *  The empty slots are linked through their 'unique' field into a doubly
+ *  linked circular list; the page header points to the last slot of the
+ *  list, whose next slot is the first one, so that slots are appended and
+ *  taken in O(1) and are reused in the order they were emptied. The empty
+ *  slots at the end of the slot array are unlinked and removed, so that a
+ *  page has no slot when it has no object (see SP_FREESLOTLIST in
+ *  EduOM_Internal.h).
+ *
+ * Exports:
+ *  void eduom_CheckFreeSlotList(SlottedPage*)
+ *  Two eduom_AllocSlot(SlottedPage*)
+ *  void eduom_FreeSlot(SlottedPage*, Two)
+ */
+
+
+#include "EduOM_common.h"
+#include "EduOM_Internal.h"
+
+
+
+/*@ Internal Function Prototypes */
+static void eduom_AppendFreeSlot(SlottedPage*, Two);
+static void eduom_UnlinkFreeSlot(SlottedPage*, Two);
+
+
+
+/*@================================
+ * eduom_AppendFreeSlot()
+ *================================*/
+/*
+ * Function: static void eduom_AppendFreeSlot(SlottedPage*, Two)
+ *
+ * Description :
+ *  Append the empty slot to the end of the free slot list.
+ */
+static void eduom_AppendFreeSlot(
+    SlottedPage	*apage,		/* INOUT slotted page */
+    Two			slotNo)		/* IN empty slot */
+{
+    Two		tail = apage->header.freeSlot;	/* last slot of the list */
+    Two		head;			/* first slot of the list */
+
+
+	if (tail == NIL)
+		SP_SETFREESLOTLINKS(apage, slotNo, slotNo, slotNo);
+	else {
+		head = SP_NEXTFREESLOT(apage, tail);
+		SP_SETFREESLOTLINKS(apage, slotNo, tail, head);
+		SP_SETFREESLOTLINKS(apage, tail, SP_PREVFREESLOT(apage, tail), slotNo);
+		SP_SETFREESLOTLINKS(apage, head, slotNo, SP_NEXTFREESLOT(apage, head));
+	}
+	apage->header.freeSlot = slotNo;
+
+} /* eduom_AppendFreeSlot() */
+
+
+
+/*@================================
+ * eduom_UnlinkFreeSlot()
+ *================================*/
+/*
+ * Function: static void eduom_UnlinkFreeSlot(SlottedPage*, Two)
+ *
+ * Description :
+ *  Remove the empty slot from the free slot list.
+ */
+static void eduom_UnlinkFreeSlot(
+    SlottedPage	*apage,		/* INOUT slotted page */
+    Two			slotNo)		/* IN empty slot on the list */
+{
+    Two		prev = SP_PREVFREESLOT(apage, slotNo);	/* previous slot of the list */
+    Two		next = SP_NEXTFREESLOT(apage, slotNo);	/* next slot of the list */
+
+
+	if (prev == slotNo) {
+		apage->header.freeSlot = NIL;
+		return;
+	}
+
+	SP_SETFREESLOTLINKS(apage, prev, SP_PREVFREESLOT(apage, prev), next);
+	SP_SETFREESLOTLINKS(apage, next, prev, SP_NEXTFREESLOT(apage, next));
+
+	if (apage->header.freeSlot == slotNo)
+		apage->header.freeSlot = prev;
+
+} /* eduom_UnlinkFreeSlot() */
+
+
+
+/*@================================
+ * eduom_CheckFreeSlotList()
+ *================================*/
+/*
+ * Function: void eduom_CheckFreeSlotList(SlottedPage*)
+ *
+ * Description :
+ *  Build the free slot list of a page initialized outside EduOM. Nothing
+ *  is done if the page already maintains it and the header points to an
+ *  empty slot of the page. A page without slots is always rebuilt, which
+ *  is cheap, so that a page reinitialized outside EduOM is never trusted
+ *  because of a flag left from its previous use.
+ *  The slot array is not shortened here, so that the free space of the
+ *  page seen by the caller does not change.
+ */
+void eduom_CheckFreeSlotList(
+    SlottedPage	*apage)		/* INOUT slotted page */
+{
+    Two		tail = apage->header.freeSlot;	/* last slot of the list */
+    Two		i;				/* index variable */
+
+
+	if ((apage->header.flags & SP_FREESLOTLIST) && apage->header.nSlots > 0 &&
+	    (tail == NIL ||
+	     (tail >= 0 && tail < apage->header.nSlots && apage->slot[-1*tail].offset == EMPTYSLOT)))
+		return;
+
+	apage->header.freeSlot = NIL;
+
+	for (i = 0; i < apage->header.nSlots; i++)
+		if (apage->slot[-1*i].offset == EMPTYSLOT)
+			eduom_AppendFreeSlot(apage, i);
+
+	apage->header.flags |= SP_FREESLOTLIST;
+
+} /* eduom_CheckFreeSlotList() */
+
+
+
+/*@================================
+ * eduom_AllocSlot()
+ *================================*/
+/*
+ * Function: Two eduom_AllocSlot(SlottedPage*)
+ *
+ * Description :
+ *  Take a slot for a new object: the first slot of the free slot list, i.e.
+ *  the slot emptied earliest, or a new slot at the end of the slot array
+ *  if the list is empty.
+ *  The caller sets the offset and the unique number of the slot.
+ *
+ * Returns:
+ *  slot number
+ */
+Two eduom_AllocSlot(
+    SlottedPage	*apage)		/* INOUT slotted page */
+{
+    Two		slotNo;			/* allocated slot */
+
+
+	eduom_CheckFreeSlotList(apage);
+
+	if (apage->header.freeSlot == NIL)
+		return(apage->header.nSlots++);
+
+	slotNo = SP_NEXTFREESLOT(apage, apage->header.freeSlot);
+	eduom_UnlinkFreeSlot(apage, slotNo);
+
+	return(slotNo);
+
+} /* eduom_AllocSlot() */
+
+
+
+/*@================================
+ * eduom_FreeSlot()
+ *================================*/
+/*
+ * Function: void eduom_FreeSlot(SlottedPage*, Two)
+ *
+ * Description :
+ *  Make the slot of a destroyed object empty. If it is the last slot of
+ *  the slot array, it is removed together with the empty slots before it
+ *  instead of being put on the free slot list; the page has no slot once
+ *  its last object is destroyed.
+ */
+void eduom_FreeSlot(
+    SlottedPage	*apage,		/* INOUT slotted page */
+    Two			slotNo)		/* IN slot to free */
+{
+	eduom_CheckFreeSlotList(apage);
+
+	apage->slot[-1*slotNo].offset = EMPTYSLOT;
+
+	if (slotNo+1 < apage->header.nSlots) {
+		eduom_AppendFreeSlot(apage, slotNo);
+		return;
+	}
+
+	apage->header.nSlots--;
+
+	while (apage->header.nSlots > 0 &&
+	       apage->slot[-1*(apage->header.nSlots-1)].offset == EMPTYSLOT) {
+		eduom_UnlinkFreeSlot(apage, apage->header.nSlots-1);
+		apage->header.nSlots--;
+	}
+
+} /* eduom_FreeSlot() */
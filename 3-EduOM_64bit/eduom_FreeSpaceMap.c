@@ -0,0 +1,516 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : eduom_FreeSpaceMap.c
+ *
+ * Description :
+ *  Maintain the free space maps of the data files (see FreeSpaceMap in
+ *  EduOM_Internal.h). The map of a file is built from the pages of the file
+ *  when it is first searched, and is updated whenever the free space of a
+ *  page changes; an update of a file without a map is ignored. When more
+ *  than FSM_MAX_FILES files are used, the least recently used map is dropped
+ *  and is built again when needed.
+ *  The available space lists of the catalog entry are still maintained for
+ *  the other users of the file, but a page is moved between the lists only
+ *  when its free space changes the list it belongs to.
+ *
+ * Exports:
+ *  Four eduom_FsmFindPage(ObjectID*, sm_CatOverlayForData*, Four, PageID*)
+ *  void eduom_FsmUpdatePage(ObjectID*, PageID*, SlottedPage*)
+ *  void eduom_FsmRemovePage(ObjectID*, PageID*)
+ *  void eduom_FsmDropFile(ObjectID*)
+ *  Four eduom_PutInAvailSpaceList(ObjectID*, PageID*, SlottedPage*, Four)
+ *  Four eduom_RemoveFromAvailSpaceList(ObjectID*, PageID*, SlottedPage*, Four)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduOM_common.h"
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+
+
+
+/*@ Global Variables */
+static FreeSpaceMap eduom_fsm[FSM_MAX_FILES];	/* the maps in main memory */
+static Four eduom_fsmClock = 0;			/* time of the map operations */
+static FreeSpaceMap *eduom_fsmLast = NULL;	/* map used last */
+
+
+
+/*@ Internal Function Prototypes */
+static FreeSpaceMap *eduom_FsmLookup(ObjectID*);
+static void eduom_FsmDrop(FreeSpaceMap*);
+static Boolean eduom_FsmSet(FreeSpaceMap*, ShortPageID, UOne);
+static Four eduom_FsmBuild(ObjectID*, sm_CatOverlayForData*, FreeSpaceMap**);
+static Four eduom_RemoveFromList(ObjectID*, PageID*, SlottedPage*, Four);
+
+
+
+/*@================================
+ * eduom_FsmLookup()
+ *================================*/
+/*
+ * Function: static FreeSpaceMap *eduom_FsmLookup(ObjectID*)
+ *
+ * Description :
+ *  Return the map of the file, or NULL if it is not in main memory.
+ */
+static FreeSpaceMap *eduom_FsmLookup(
+    ObjectID	*catObjForFile)	/* IN catalog object of the file */
+{
+    Four	i;
+
+
+	if (eduom_fsmLast == NULL || eduom_fsmLast->tree == NULL ||
+		!EQUAL_OBJECTID(eduom_fsmLast->catObj, *catObjForFile)) {
+		for (i = 0; i < FSM_MAX_FILES; i++)
+			if (eduom_fsm[i].tree != NULL && EQUAL_OBJECTID(eduom_fsm[i].catObj, *catObjForFile)) break;
+		if (i == FSM_MAX_FILES) return(NULL);
+
+		eduom_fsmLast = &eduom_fsm[i];
+	}
+
+	eduom_fsmLast->lastUsed = ++eduom_fsmClock;
+
+	return(eduom_fsmLast);
+
+} /* eduom_FsmLookup() */
+
+
+
+/*@================================
+ * eduom_FsmDrop()
+ *================================*/
+/*
+ * Function: static void eduom_FsmDrop(FreeSpaceMap*)
+ *
+ * Description :
+ *  Free the memory of a map; the map is built again when next searched.
+ */
+static void eduom_FsmDrop(
+    FreeSpaceMap	*fsm)	/* INOUT the map */
+{
+	free(fsm->tree);
+	fsm->tree = NULL;
+
+} /* eduom_FsmDrop() */
+
+
+
+/*@================================
+ * eduom_FsmSet()
+ *================================*/
+/*
+ * Function: static Boolean eduom_FsmSet(FreeSpaceMap*, ShortPageID, UOne)
+ *
+ * Description :
+ *  Set the leaf of a page and the maxima on its path to the root, doubling
+ *  the number of leaves if the page number is too large.
+ *
+ * Returns:
+ *  FALSE if no memory is left for a larger map
+ */
+static Boolean eduom_FsmSet(
+    FreeSpaceMap	*fsm,	/* INOUT the map */
+    ShortPageID		pageNo,	/* IN page */
+    UOne		category)	/* IN free space of the page in units of FSM_UNIT */
+{
+    UOne	*tree;			/* enlarged tree */
+    Four	n;				/* # of leaves of the enlarged tree */
+    Four	i;				/* index of a node */
+
+
+	if (pageNo >= fsm->nLeaves) {
+		for (n = fsm->nLeaves; n <= pageNo; n *= 2);
+
+		tree = (UOne*)calloc(2 * n, sizeof(UOne));
+		if (tree == NULL) return(FALSE);
+
+		memcpy(&tree[n], &fsm->tree[fsm->nLeaves], fsm->nLeaves);
+		for (i = n - 1; i > 0; i--)
+			tree[i] = MAX(tree[2*i], tree[2*i+1]);
+
+		free(fsm->tree);
+		fsm->tree = tree;
+		fsm->nLeaves = n;
+	}
+
+	i = fsm->nLeaves + pageNo;
+	fsm->tree[i] = category;
+	for (i /= 2; i > 0; i /= 2) {
+		category = MAX(fsm->tree[2*i], fsm->tree[2*i+1]);
+		if (fsm->tree[i] == category) break;
+		fsm->tree[i] = category;
+	}
+
+	return(TRUE);
+
+} /* eduom_FsmSet() */
+
+
+
+/*@================================
+ * eduom_FsmBuild()
+ *================================*/
+/*
+ * Function: static Four eduom_FsmBuild(ObjectID*, sm_CatOverlayForData*, FreeSpaceMap**)
+ *
+ * Description :
+ *  Build the map of a file by reading its pages, replacing the least
+ *  recently used map.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_EDUOM
+ *    some errors caused by function calls
+ */
+static Four eduom_FsmBuild(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    sm_CatOverlayForData *catEntry,	/* IN catalog entry of the file */
+    FreeSpaceMap	**fsm)		/* OUT the map */
+{
+    Four		e;			/* error number */
+    FreeSpaceMap	*victim;	/* map replaced */
+    PageID		pid;		/* page of the file */
+    SlottedPage	*apage;		/* pointer to the buffer of the page */
+    ShortPageID	nextPage;	/* next page of the file */
+    Four		i;
+
+
+	victim = &eduom_fsm[0];
+	for (i = 0; i < FSM_MAX_FILES; i++) {
+		if (eduom_fsm[i].tree == NULL) { victim = &eduom_fsm[i]; break; }
+		if (eduom_fsm[i].lastUsed < victim->lastUsed) victim = &eduom_fsm[i];
+	}
+	eduom_FsmDrop(victim);
+
+	victim->tree = (UOne*)calloc(2 * FSM_MIN_LEAVES, sizeof(UOne));
+	if (victim->tree == NULL) ERR(eMEMORYALLOCERR_EDUOM);
+	victim->catObj = *catObjForFile;
+	victim->nLeaves = FSM_MIN_LEAVES;
+	for (i = 0; i < FSM_NUM_RECENT; i++) victim->recent[i] = NIL;
+	victim->nextRecent = 0;
+	victim->lastUsed = ++eduom_fsmClock;
+
+	MAKE_PAGEID(pid, catEntry->fid.volNo, catEntry->firstPage);
+	while (pid.pageNo != NIL) {
+		e = BfM_GetTrain(&pid, (char **)&apage, PAGE_BUF);
+		if (e<0) { eduom_FsmDrop(victim); ERR(e); }
+
+		/* the fixed-length record pages and the PAX pages take no object */
+		nextPage = apage->header.nextPage;
+		if (!eduom_FsmSet(victim, pid.pageNo, IS_SLOTTED_PAGE(apage) ? (UOne)MIN(SP_FREE(apage) / FSM_UNIT, 255) : 0)) {
+			eduom_FsmDrop(victim);
+			ERRB1(eMEMORYALLOCERR_EDUOM, &pid, PAGE_BUF);
+		}
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e<0) { eduom_FsmDrop(victim); ERR(e); }
+
+		pid.pageNo = nextPage;
+	}
+
+	*fsm = victim;
+
+	return(eNOERROR);
+
+} /* eduom_FsmBuild() */
+
+
+
+/*@================================
+ * eduom_FsmFindPage()
+ *================================*/
+/*
+ * Function: Four eduom_FsmFindPage(ObjectID*, sm_CatOverlayForData*, Four, PageID*)
+ *
+ * Description :
+ *  Find a page of the file which had at least 'neededSpace' bytes of free
+ *  space when the map was last updated. The pages whose free space grew
+ *  last are tried first, as the most recently freed pages are likely to be
+ *  in the buffer; otherwise the first page in the order of the page numbers
+ *  is found with the tree. The caller
+ *  checks the page and calls eduom_FsmUpdatePage() if it has not enough
+ *  free space, or eduom_FsmRemovePage() if it is not a slotted page of the
+ *  file.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  pid->pageNo is NIL if no page is found
+ */
+Four eduom_FsmFindPage(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    sm_CatOverlayForData *catEntry,	/* IN catalog entry of the file */
+    Four		neededSpace,	/* IN space needed in the page */
+    PageID		*pid)		/* OUT page found */
+{
+    Four		e;			/* error number */
+    FreeSpaceMap	*fsm;		/* map of the file */
+    Four		category;	/* least category having 'neededSpace' bytes */
+    Four		i;			/* index of a node */
+    Four		k, r;		/* index of 'recent' */
+
+
+	fsm = eduom_FsmLookup(catObjForFile);
+	if (fsm == NULL) {
+		e = eduom_FsmBuild(catObjForFile, catEntry, &fsm);
+		if (e<0) ERR(e);
+	}
+
+	pid->volNo = catEntry->fid.volNo;
+	pid->pageNo = NIL;
+
+	category = (neededSpace + FSM_UNIT - 1) / FSM_UNIT;
+	if (fsm->tree[1] < category) return(eNOERROR);
+
+	/* a recent page without room is forgotten; the tree still has it */
+	for (k = 0; k < FSM_NUM_RECENT; k++) {
+		r = (fsm->nextRecent - 1 - k + FSM_NUM_RECENT) % FSM_NUM_RECENT;
+		if (fsm->recent[r] == NIL) continue;
+
+		if (fsm->tree[fsm->nLeaves + fsm->recent[r]] >= category) {
+			pid->pageNo = fsm->recent[r];
+			return(eNOERROR);
+		}
+		fsm->recent[r] = NIL;
+	}
+
+	for (i = 1; i < fsm->nLeaves; )
+		i = (fsm->tree[2*i] >= category) ? 2*i : 2*i+1;
+
+	pid->pageNo = i - fsm->nLeaves;
+
+	return(eNOERROR);
+
+} /* eduom_FsmFindPage() */
+
+
+
+/*@================================
+ * eduom_FsmUpdatePage()
+ *================================*/
+/*
+ * Function: void eduom_FsmUpdatePage(ObjectID*, PageID*, SlottedPage*)
+ *
+ * Description :
+ *  Record the free space of a page of the file in its map, if the map is in
+ *  main memory. The map is dropped if it cannot be enlarged.
+ */
+void eduom_FsmUpdatePage(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    PageID		*pid,		/* IN page */
+    SlottedPage		*apage)		/* IN pointer to the buffer of the page */
+{
+    FreeSpaceMap	*fsm;		/* map of the file */
+    UOne		category;	/* free space of the page in units of FSM_UNIT */
+
+
+	fsm = eduom_FsmLookup(catObjForFile);
+	if (fsm == NULL) return;
+
+	category = (UOne)MIN(SP_FREE(apage) / FSM_UNIT, 255);
+	if (pid->pageNo < fsm->nLeaves && category > fsm->tree[fsm->nLeaves + pid->pageNo]) {
+		fsm->recent[fsm->nextRecent] = pid->pageNo;
+		fsm->nextRecent = (fsm->nextRecent + 1) % FSM_NUM_RECENT;
+	}
+
+	if (!eduom_FsmSet(fsm, pid->pageNo, category))
+		eduom_FsmDrop(fsm);
+
+} /* eduom_FsmUpdatePage() */
+
+
+
+/*@================================
+ * eduom_FsmRemovePage()
+ *================================*/
+/*
+ * Function: void eduom_FsmRemovePage(ObjectID*, PageID*)
+ *
+ * Description :
+ *  Record that a page is no longer in the file.
+ */
+void eduom_FsmRemovePage(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    PageID		*pid)		/* IN page deleted from the file */
+{
+    FreeSpaceMap	*fsm;		/* map of the file */
+
+
+	fsm = eduom_FsmLookup(catObjForFile);
+	if (fsm == NULL || pid->pageNo >= fsm->nLeaves) return;
+
+	eduom_FsmSet(fsm, pid->pageNo, 0);
+
+} /* eduom_FsmRemovePage() */
+
+
+
+/*@================================
+ * eduom_FsmDropFile()
+ *================================*/
+/*
+ * Function: void eduom_FsmDropFile(ObjectID*)
+ *
+ * Description :
+ *  Drop the map of a file whose pages have been changed all at once, e.g.
+ *  truncated; the map is built again when next searched.
+ */
+void eduom_FsmDropFile(
+    ObjectID		*catObjForFile)	/* IN catalog object of the file */
+{
+    FreeSpaceMap	*fsm;		/* map of the file */
+
+
+	fsm = eduom_FsmLookup(catObjForFile);
+	if (fsm != NULL) eduom_FsmDrop(fsm);
+
+} /* eduom_FsmDropFile() */
+
+
+
+/*@================================
+ * eduom_RemoveFromList()
+ *================================*/
+/*
+ * Function: static Four eduom_RemoveFromList(ObjectID*, PageID*, SlottedPage*, Four)
+ *
+ * Description :
+ *  Remove a page from the available space list it was put into when it had
+ *  'oldFree' bytes of free space; the page may have been changed since.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_RemoveFromList(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    PageID		*pid,		/* IN page */
+    SlottedPage		*apage,		/* INOUT pointer to the buffer of the page */
+    Four		oldFree)	/* IN free space of the page when it was put into the list */
+{
+    Four		e;			/* error number */
+    Four		diff;		/* free space gained since */
+
+
+	/* om_RemoveFromAvailSpaceList() finds the list from the free space of the page */
+	diff = SP_FREE(apage) - oldFree;
+	apage->header.unused -= diff;
+	e = om_RemoveFromAvailSpaceList(catObjForFile, pid, apage);
+	apage->header.unused += diff;
+	if (e<0) ERR(e);
+
+	return(eNOERROR);
+
+} /* eduom_RemoveFromList() */
+
+
+
+/*@================================
+ * eduom_RemoveFromAvailSpaceList()
+ *================================*/
+/*
+ * Function: Four eduom_RemoveFromAvailSpaceList(ObjectID*, PageID*, SlottedPage*, Four)
+ *
+ * Description :
+ *  Remove a page from the available space list it was put into when it had
+ *  'oldFree' bytes of free space, and read the copy of the catalog entry
+ *  again as the head of the list may have changed.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_RemoveFromAvailSpaceList(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    PageID		*pid,		/* IN page */
+    SlottedPage		*apage,		/* INOUT pointer to the buffer of the page */
+    Four		oldFree)	/* IN free space of the page when it was put into the list */
+{
+    Four		e;			/* error number */
+
+
+	e = eduom_RemoveFromList(catObjForFile, pid, apage, oldFree);
+	if (e<0) ERR(e);
+
+	e = eduom_RefreshCatalogEntry(catObjForFile);
+	if (e<0) ERR(e);
+
+	return(eNOERROR);
+
+} /* eduom_RemoveFromAvailSpaceList() */
+
+
+
+/*@================================
+ * eduom_PutInAvailSpaceList()
+ *================================*/
+/*
+ * Function: Four eduom_PutInAvailSpaceList(ObjectID*, PageID*, SlottedPage*, Four)
+ *
+ * Description :
+ *  Record the free space of a changed page: move the page to the available
+ *  space list for its free space if it is not the list it was put into when
+ *  it had 'oldFree' bytes of free space, and update the free space map. The
+ *  catalog entry is changed, and its copy read again, only if the page moves.
+ *  'oldFree' is NIL for a page not put into any list yet.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_PutInAvailSpaceList(
+    ObjectID		*catObjForFile,	/* IN catalog object of the file */
+    PageID		*pid,		/* IN page */
+    SlottedPage		*apage,		/* INOUT pointer to the buffer of the page */
+    Four		oldFree)	/* IN free space of the page when it was put into the list; NIL if never */
+{
+    Four		e;			/* error number */
+
+
+	if (oldFree == NIL || SP_AVAILSPACELIST_NO(oldFree) != SP_AVAILSPACELIST_NO(SP_FREE(apage))) {
+		if (oldFree != NIL) {
+			e = eduom_RemoveFromList(catObjForFile, pid, apage, oldFree);
+			if (e<0) ERR(e);
+		}
+
+		e = om_PutInAvailSpaceList(catObjForFile, pid, apage);
+		if (e<0) ERR(e);
+
+		/* the heads of the lists in the catalog entry may have changed */
+		e = eduom_RefreshCatalogEntry(catObjForFile);
+		if (e<0) ERR(e);
+	}
+
+	eduom_FsmUpdatePage(catObjForFile, pid, apage);
+
+	return(eNOERROR);
+
+} /* eduom_PutInAvailSpaceList() */
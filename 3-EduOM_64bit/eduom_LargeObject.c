@@ -0,0 +1,665 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : eduom_LargeObject.c
+ *
+ * Description :
+ *  Store the data of a large object in a tree of trains hanging from the
+ *  root kept in the data area of the object (see LOT_Root in
+ *  EduOM_Internal.h). The leaves are filled from left to right, so the leaf
+ *  holding a byte is located by its position without keeping any count in
+ *  the internal nodes, and a range of bytes is read or written one leaf at
+ *  a time without copying the whole object.
+ *
+ * Exports:
+ *  Four eduom_LotAppend(ObjectID*, PageID*, Object*, Four, char*)
+ *  Four eduom_LotCreate(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*)
+ *  Four eduom_LotDestroy(Object*, VolNo, Pool*, DeallocListElem*)
+ *  Four eduom_LotRead(Object*, VolNo, Four, Four, char*)
+ *  Four eduom_LotWrite(Object*, VolNo, Four, Four, char*)
+ */
+
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "Util.h"		/* to get Pool */
+#include "RDsM.h"		/* for the raw disk manager call */
+#include "BfM.h"		/* for the buffer manager call */
+#include "EduOM_Internal.h"
+
+
+
+/*
+ * Where the nodes of a large object are allocated
+ */
+typedef struct {
+    VolNo	volNo;			/* volume of the file */
+    Four	firstExt;		/* first extent of the file */
+    Two		eff;			/* extent fill factor of the file */
+    PageID	nearPid;		/* the last allocated node or the page of the object */
+} eduom_LotAllocInfo;
+
+
+/*@ Internal Function Prototypes */
+static Four eduom_LotSpan(Four);
+static Four eduom_LotAllocNode(eduom_LotAllocInfo*, Four, PageID*, LOT_NodeHdr**);
+static Four eduom_LotGetLeaf(LOT_Root*, VolNo, Four, ShortPageID*);
+static Four eduom_LotInsertLeaf(LOT_Root*, eduom_LotAllocInfo*, Four, ShortPageID);
+static Four eduom_LotAccess(Object*, VolNo, Four, Four, char*, Boolean);
+static Four eduom_LotFreeNode(VolNo, ShortPageID, Four, Four, Pool*, DeallocListElem*);
+
+
+
+/*@================================
+ * eduom_LotSpan()
+ *================================*/
+/*
+ * Function: static Four eduom_LotSpan(Four)
+ *
+ * Description :
+ *  Return the number of leaves below a child of a node at the given height;
+ *  only the root and the last node of each level are not full.
+ *
+ * Returns:
+ *  # of leaves
+ */
+static Four eduom_LotSpan(
+    Four	height)			/* IN height of the node; the leaves are at height 0 */
+{
+    Four	span;			/* # of leaves below a child */
+
+
+	for (span = 1; height > 1; height--)
+		span *= LOT_I_NODE_FANOUT;
+
+	return(span);
+
+} /* eduom_LotSpan() */
+
+
+
+/*@================================
+ * eduom_LotAllocNode()
+ *================================*/
+/*
+ * Function: static Four eduom_LotAllocNode(eduom_LotAllocInfo*, Four, PageID*, LOT_NodeHdr**)
+ *
+ * Description :
+ *  Allocate a train for a new node near the node allocated last and fix it
+ *  in the buffer without reading it from the disk.
+ *  The caller fills the node, sets it dirty and frees it.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_LotAllocNode(
+    eduom_LotAllocInfo	*info,	/* INOUT where to allocate the node */
+    Four		type,		/* IN LOT_I_NODE_TYPE or LOT_L_NODE_TYPE */
+    PageID		*pid,		/* OUT train of the new node */
+    LOT_NodeHdr	**node)		/* OUT pointer to the buffer of the node */
+{
+    Four	e;				/* error number */
+
+
+	e = RDsM_AllocTrains(info->volNo, info->firstExt, &info->nearPid, info->eff, 1, LOT_TRAINSIZE, pid);
+	if (e<0) ERR(e);
+
+	e = BfM_GetNewTrain(pid, (char **)node, LOT_LEAF_BUF);
+	if (e<0) ERR(e);
+
+	(*node)->pid = *pid;
+	(*node)->flags = 0;
+	SET_PAGE_TYPE(*node, type);
+
+	info->nearPid = *pid;
+
+	return(eNOERROR);
+
+} /* eduom_LotAllocNode() */
+
+
+
+/*@================================
+ * eduom_LotGetLeaf()
+ *================================*/
+/*
+ * Function: static Four eduom_LotGetLeaf(LOT_Root*, VolNo, Four, ShortPageID*)
+ *
+ * Description :
+ *  Find the leaf of the given position by descending from the root.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_LotGetLeaf(
+    LOT_Root	*root,		/* IN root of the tree */
+    VolNo		volNo,		/* IN volume of the object */
+    Four		leafNo,		/* IN position of the leaf */
+    ShortPageID	*leaf)		/* OUT the leaf */
+{
+    Four	e;				/* error number */
+    Four	height;			/* height of the current node */
+    Four	span;			/* # of leaves below a child of the current node */
+    PageID	pid;			/* current internal node */
+    LOT_INode	*inode;		/* pointer to the buffer of the internal node */
+
+
+	height = root->height;
+	span = eduom_LotSpan(height);
+	*leaf = root->child[leafNo / span];
+
+	for (height--; height > 0; height--) {
+		leafNo %= span;
+		span /= LOT_I_NODE_FANOUT;
+
+		MAKE_PAGEID(pid, volNo, *leaf);
+		e = BfM_GetTrain(&pid, (char **)&inode, LOT_LEAF_BUF);
+		if (e<0) ERR(e);
+		*leaf = inode->child[leafNo / span];
+		e = BfM_FreeTrain(&pid, LOT_LEAF_BUF);
+		if (e<0) ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* eduom_LotGetLeaf() */
+
+
+
+/*@================================
+ * eduom_LotInsertLeaf()
+ *================================*/
+/*
+ * Function: static Four eduom_LotInsertLeaf(LOT_Root*, eduom_LotAllocInfo*, Four, ShortPageID)
+ *
+ * Description :
+ *  Add a leaf after the last leaf of the tree. If the tree is full, the
+ *  children of the root are moved into a new internal node which becomes
+ *  the only child of the root. An internal node is allocated when the
+ *  first leaf below it is added.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_LotInsertLeaf(
+    LOT_Root	*root,		/* INOUT root of the tree */
+    eduom_LotAllocInfo	*info,	/* INOUT where to allocate the internal nodes */
+    Four		leafNo,		/* IN # of leaves in the tree */
+    ShortPageID	leaf)		/* IN the new leaf */
+{
+    Four	e;				/* error number */
+    Four	height;			/* height of the current node */
+    Four	span;			/* # of leaves below a child of the current node */
+    ShortPageID	*child;		/* children of the current node */
+    PageID	pid;			/* current internal node */
+    PageID	newPid;			/* new internal node */
+    LOT_INode	*inode;		/* pointer to the buffer of the current internal node */
+    LOT_INode	*newNode;	/* pointer to the buffer of the new internal node */
+    Boolean	fixed;			/* is the current internal node fixed? */
+
+
+	/*@ grow the tree at the root if it is full */
+	if (root->height == 0)
+		root->height = 1;
+	else if (leafNo == LOT_ROOT_FANOUT * eduom_LotSpan(root->height)) {
+		e = eduom_LotAllocNode(info, LOT_I_NODE_TYPE, &newPid, (LOT_NodeHdr **)&newNode);
+		if (e<0) ERR(e);
+		memcpy(newNode->child, root->child, sizeof(root->child));
+		e = BfM_SetDirty(&newPid, LOT_LEAF_BUF);
+		if (e<0) ERRB1(e, &newPid, LOT_LEAF_BUF);
+		e = BfM_FreeTrain(&newPid, LOT_LEAF_BUF);
+		if (e<0) ERR(e);
+
+		root->child[0] = newPid.pageNo;
+		root->height++;
+	}
+
+	height = root->height;
+	span = eduom_LotSpan(height);
+	child = root->child;
+	fixed = FALSE;
+
+	for ( ; height > 1; height--) {
+		/*@ the first leaf below the child: allocate the child */
+		if (leafNo % span == 0) {
+			e = eduom_LotAllocNode(info, LOT_I_NODE_TYPE, &newPid, (LOT_NodeHdr **)&newNode);
+			if (e<0) ERR(e);
+			e = BfM_SetDirty(&newPid, LOT_LEAF_BUF);
+			if (e<0) ERRB1(e, &newPid, LOT_LEAF_BUF);
+			e = BfM_FreeTrain(&newPid, LOT_LEAF_BUF);
+			if (e<0) ERR(e);
+
+			child[leafNo / span] = newPid.pageNo;
+			if (fixed) {
+				e = BfM_SetDirty(&pid, LOT_LEAF_BUF);
+				if (e<0) ERRB1(e, &pid, LOT_LEAF_BUF);
+			}
+		}
+
+		MAKE_PAGEID(newPid, info->volNo, child[leafNo / span]);
+		if (fixed) {
+			e = BfM_FreeTrain(&pid, LOT_LEAF_BUF);
+			if (e<0) ERR(e);
+		}
+
+		pid = newPid;
+		e = BfM_GetTrain(&pid, (char **)&inode, LOT_LEAF_BUF);
+		if (e<0) ERR(e);
+		fixed = TRUE;
+
+		child = inode->child;
+		leafNo %= span;
+		span /= LOT_I_NODE_FANOUT;
+	}
+
+	child[leafNo] = leaf;
+
+	if (fixed) {
+		e = BfM_SetDirty(&pid, LOT_LEAF_BUF);
+		if (e<0) ERRB1(e, &pid, LOT_LEAF_BUF);
+		e = BfM_FreeTrain(&pid, LOT_LEAF_BUF);
+		if (e<0) ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* eduom_LotInsertLeaf() */
+
+
+
+/*@================================
+ * eduom_LotAccess()
+ *================================*/
+/*
+ * Function: static Four eduom_LotAccess(Object*, VolNo, Four, Four, char*, Boolean)
+ *
+ * Description :
+ *  Copy a range of the data of a large object from or to the user buffer,
+ *  one leaf at a time.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_LotAccess(
+    Object	*obj,			/* IN large object */
+    VolNo	volNo,			/* IN volume of the object */
+    Four	start,			/* IN starting offset of the range */
+    Four	length,			/* IN length of the range */
+    char	*buf,			/* INOUT user buffer */
+    Boolean	write)			/* IN TRUE to write the range */
+{
+    Four	e;				/* error number */
+    Four	leafNo;			/* position of the current leaf */
+    Four	offset;			/* offset of the range in the current leaf */
+    Four	n;				/* # of bytes in the current leaf */
+    ShortPageID	leaf;		/* current leaf */
+    PageID	pid;			/* current leaf */
+    LOT_LNode	*lnode;		/* pointer to the buffer of the current leaf */
+
+
+	leafNo = start / LOT_L_NODE_SIZE;
+	offset = start % LOT_L_NODE_SIZE;
+
+	while (length > 0) {
+		n = MIN(length, LOT_L_NODE_SIZE - offset);
+
+		e = eduom_LotGetLeaf((LOT_Root *)obj->data, volNo, leafNo, &leaf);
+		if (e<0) ERR(e);
+
+		MAKE_PAGEID(pid, volNo, leaf);
+		e = BfM_GetTrain(&pid, (char **)&lnode, LOT_LEAF_BUF);
+		if (e<0) ERR(e);
+
+		if (write) {
+			memcpy(lnode->data + offset, buf, n);
+			e = BfM_SetDirty(&pid, LOT_LEAF_BUF);
+			if (e<0) ERRB1(e, &pid, LOT_LEAF_BUF);
+		}
+		else
+			memcpy(buf, lnode->data + offset, n);
+
+		e = BfM_FreeTrain(&pid, LOT_LEAF_BUF);
+		if (e<0) ERR(e);
+
+		buf += n;
+		length -= n;
+		leafNo++;
+		offset = 0;
+	}
+
+	return(eNOERROR);
+
+} /* eduom_LotAccess() */
+
+
+
+/*@================================
+ * eduom_LotAppend()
+ *================================*/
+/*
+ * Function: Four eduom_LotAppend(ObjectID*, PageID*, Object*, Four, char*)
+ *
+ * Description :
+ *  Append data to the end of a large object. The last leaf is filled up
+ *  first, then new leaves are allocated in the file near the object and
+ *  added to the tree. The root and the length in the object header are
+ *  updated; the caller sets the page of the object dirty.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_LotAppend(
+    ObjectID	*catObjForFile,	/* IN file containing the object */
+    PageID		*nearPid,	/* IN page of the object */
+    Object		*obj,		/* INOUT large object */
+    Four		length,		/* IN amount of data */
+    char		*data)		/* IN data to append */
+{
+    Four	e;				/* error number */
+    LOT_Root	*root;		/* root of the tree */
+    Four	nLeaves;		/* # of leaves in the tree */
+    Four	n;				/* # of bytes put in a leaf */
+    eduom_LotAllocInfo	info;	/* where to allocate the nodes */
+    PageID	firstPid;		/* first page of the file */
+    sm_CatOverlayForData *catEntry; /* overlay structure for catalog object access */
+    PageID	pid;			/* new leaf */
+    LOT_LNode	*lnode;		/* pointer to the buffer of the new leaf */
+
+
+	root = (LOT_Root *)obj->data;
+
+	/*@ fill up the last leaf */
+	n = MIN(length, LOT_NUM_LEAVES(obj->header.length) * LOT_L_NODE_SIZE - obj->header.length);
+	if (n > 0) {
+		e = eduom_LotAccess(obj, nearPid->volNo, obj->header.length, n, data, TRUE);
+		if (e<0) ERR(e);
+
+		obj->header.length += n;
+		data += n;
+		length -= n;
+	}
+
+	if (length == 0) return(eNOERROR);
+
+	e = eduom_GetCatalogEntry(catObjForFile, &catEntry);
+	if (e<0) ERR(e);
+
+	info.volNo = catEntry->fid.volNo;
+	info.eff = catEntry->eff;
+	MAKE_PAGEID(firstPid, catEntry->fid.volNo, catEntry->firstPage);
+
+	e = RDsM_PageIdToExtNo(&firstPid, &info.firstExt);
+	if (e<0) ERR(e);
+
+	if (root->height == 0)
+		info.nearPid = *nearPid;
+	else {
+		e = eduom_LotGetLeaf(root, info.volNo, LOT_NUM_LEAVES(obj->header.length) - 1, &info.nearPid.pageNo);
+		if (e<0) ERR(e);
+		info.nearPid.volNo = info.volNo;
+	}
+
+	/*@ put the rest into new leaves */
+	nLeaves = LOT_NUM_LEAVES(obj->header.length);
+	while (length > 0) {
+		n = MIN(length, LOT_L_NODE_SIZE);
+
+		e = eduom_LotAllocNode(&info, LOT_L_NODE_TYPE, &pid, (LOT_NodeHdr **)&lnode);
+		if (e<0) ERR(e);
+		memcpy(lnode->data, data, n);
+		e = BfM_SetDirty(&pid, LOT_LEAF_BUF);
+		if (e<0) ERRB1(e, &pid, LOT_LEAF_BUF);
+		e = BfM_FreeTrain(&pid, LOT_LEAF_BUF);
+		if (e<0) ERR(e);
+
+		e = eduom_LotInsertLeaf(root, &info, nLeaves, pid.pageNo);
+		if (e<0) ERR(e);
+
+		obj->header.length += n;
+		data += n;
+		length -= n;
+		nLeaves++;
+	}
+
+	return(eNOERROR);
+
+} /* eduom_LotAppend() */
+
+
+
+/*@================================
+ * eduom_LotCreate()
+ *================================*/
+/*
+ * Function: Four eduom_LotCreate(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*)
+ *
+ * Description :
+ *  Create a large object near the specified object: an object holding an
+ *  empty root is created in a slotted page, then the data is appended.
+ *  The properties of 'objHdr' are kept and P_LRGOBJ is set.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_LotCreate(
+    ObjectID	*catObjForFile,	/* IN file in which object is to be placed */
+    ObjectID	*nearObj,	/* IN create the new object near this object */
+    ObjectHdr	*objHdr,	/* IN from which tag & properties are set */
+    Four		length,		/* IN amount of data */
+    char		*data,		/* IN the initial data for the object */
+    ObjectID	*oid)		/* OUT the object's ObjectID */
+{
+    Four	e;				/* error number */
+    LOT_Root	root;		/* empty root */
+    PageID	pid;			/* page containing the new object */
+    SlottedPage	*apage;		/* pointer to the buffer holding the page */
+    Object	*obj;			/* points to the new object */
+
+
+	objHdr->properties |= P_LRGOBJ;
+	memset(&root, 0, sizeof(LOT_Root));
+
+	e = eduom_CreateObject(catObjForFile, nearObj, objHdr, sizeof(LOT_Root), (char *)&root, oid);
+	if (e<0) ERR(e);
+
+	MAKE_PAGEID(pid, oid->volNo, oid->pageNo);
+	e = BfM_GetTrain(&pid, (char **)&apage, PAGE_BUF);
+	if (e<0) ERR(e);
+	obj = (Object *)(apage->data + apage->slot[-1*oid->slotNo].offset);
+
+	e = eduom_LotAppend(catObjForFile, &pid, obj, length, data);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
+
+	e = BfM_SetDirty(&pid, PAGE_BUF);
+	if (e<0) ERRB1(e, &pid, PAGE_BUF);
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
+	if (e<0) ERR(e);
+
+	return(eNOERROR);
+
+} /* eduom_LotCreate() */
+
+
+
+/*@================================
+ * eduom_LotRead()
+ *================================*/
+/*
+ * Function: Four eduom_LotRead(Object*, VolNo, Four, Four, char*)
+ *
+ * Description :
+ *  Read a range of the data of a large object into the user buffer.
+ *  The range must be within the object.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_LotRead(
+    Object	*obj,			/* IN large object */
+    VolNo	volNo,			/* IN volume of the object */
+    Four	start,			/* IN starting offset of read */
+    Four	length,			/* IN amount of data to read */
+    char	*buf)			/* OUT user buffer */
+{
+	return(eduom_LotAccess(obj, volNo, start, length, buf, FALSE));
+
+} /* eduom_LotRead() */
+
+
+
+/*@================================
+ * eduom_LotWrite()
+ *================================*/
+/*
+ * Function: Four eduom_LotWrite(Object*, VolNo, Four, Four, char*)
+ *
+ * Description :
+ *  Overwrite a range of the data of a large object; only the leaves
+ *  holding the range are written. The range must be within the object.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_LotWrite(
+    Object	*obj,			/* IN large object */
+    VolNo	volNo,			/* IN volume of the object */
+    Four	start,			/* IN starting offset of write */
+    Four	length,			/* IN amount of data to write */
+    char	*data)			/* IN data to write */
+{
+	return(eduom_LotAccess(obj, volNo, start, length, data, TRUE));
+
+} /* eduom_LotWrite() */
+
+
+
+/*@================================
+ * eduom_LotFreeNode()
+ *================================*/
+/*
+ * Function: static Four eduom_LotFreeNode(VolNo, ShortPageID, Four, Four, Pool*, DeallocListElem*)
+ *
+ * Description :
+ *  Put a node and all the nodes below it into the dealloc list.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+static Four eduom_LotFreeNode(
+    VolNo		volNo,		/* IN volume of the object */
+    ShortPageID	node,		/* IN the node */
+    Four		height,		/* IN height of the node; the leaves are at height 0 */
+    Four		nLeaves,	/* IN # of leaves below the node */
+    Pool		*dlPool,	/* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)	/* INOUT head of dealloc list */
+{
+    Four	e;				/* error number */
+    Four	i;				/* index variable */
+    Four	span;			/* # of leaves below a child of the node */
+    PageID	pid;			/* the node */
+    LOT_INode	*inode;		/* pointer to the buffer of the internal node */
+    DeallocListElem *dlElem;	/* pointer to element of dealloc list */
+
+
+	MAKE_PAGEID(pid, volNo, node);
+
+	if (height > 0) {
+		span = eduom_LotSpan(height);
+
+		e = BfM_GetTrain(&pid, (char **)&inode, LOT_LEAF_BUF);
+		if (e<0) ERR(e);
+
+		for (i = 0; i * span < nLeaves; i++) {
+			e = eduom_LotFreeNode(volNo, inode->child[i], height - 1, MIN(span, nLeaves - i * span), dlPool, dlHead);
+			if (e<0) ERRB1(e, &pid, LOT_LEAF_BUF);
+		}
+
+		e = BfM_FreeTrain(&pid, LOT_LEAF_BUF);
+		if (e<0) ERR(e);
+	}
+
+	e = Util_getElementFromPool(dlPool, &dlElem);
+	if (e<0) ERR(e);
+	dlElem->type = DL_TRAIN;
+	dlElem->elem.pid = pid;
+	dlElem->next = dlHead->next;
+	dlHead->next = dlElem;
+
+	return(eNOERROR);
+
+} /* eduom_LotFreeNode() */
+
+
+
+/*@================================
+ * eduom_LotDestroy()
+ *================================*/
+/*
+ * Function: Four eduom_LotDestroy(Object*, VolNo, Pool*, DeallocListElem*)
+ *
+ * Description :
+ *  Put all the nodes of a large object into the dealloc list; the trains
+ *  are freed when the dealloc list is processed.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four eduom_LotDestroy(
+    Object	*obj,			/* IN large object */
+    VolNo	volNo,			/* IN volume of the object */
+    Pool	*dlPool,		/* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)	/* INOUT head of dealloc list */
+{
+    Four	e;				/* error number */
+    Four	i;				/* index variable */
+    Four	span;			/* # of leaves below a child of the root */
+    Four	nLeaves;		/* # of leaves in the tree */
+    LOT_Root	*root;		/* root of the tree */
+
+
+	root = (LOT_Root *)obj->data;
+	nLeaves = LOT_NUM_LEAVES(obj->header.length);
+
+	if (root->height == 0) return(eNOERROR);
+
+	span = eduom_LotSpan(root->height);
+	for (i = 0; i * span < nLeaves; i++) {
+		e = eduom_LotFreeNode(volNo, root->child[i], root->height - 1, MIN(span, nLeaves - i * span), dlPool, dlHead);
+		if (e<0) ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* eduom_LotDestroy() */
@@ -0,0 +1,139 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module : eduom_PaxPage.c
+ *
+ * Description :
+ *  Lay out and read the PAX pages (see PaxPage in EduOM_Internal.h).
+ *
+ * Exports:
+ *  void eduom_PaxInitPage(PaxPage*, FileID, PageID, Two, Two*)
+ *  Four eduom_PaxRead(PaxPage*, Two, Four, Four, char*)
+ */
+
+
+#include <string.h>
+#include "EduOM_common.h"
+#include "EduOM_Internal.h"
+
+
+
+/*@================================
+ * eduom_PaxInitPage()
+ *================================*/
+/*
+ * Function: void eduom_PaxInitPage(PaxPage*, FileID, PageID, Two, Two*)
+ *
+ * Description :
+ *  Initialize a new PAX page for records of the given columns: the data
+ *  area is divided into one minipage per column, each starting at an
+ *  aligned offset, with room for as many records as fit.
+ *  The caller checks that PAX_MAX_RECORDS() is at least 1.
+ */
+void eduom_PaxInitPage(
+    PaxPage	*apage,		/* OUT pointer to the buffer of the page */
+    FileID	fid,		/* IN file of the page */
+    PageID	pid,		/* IN page */
+    Two		nColumns,	/* IN # of columns of a record */
+    Two		*widths)	/* IN length of a value of each column */
+{
+    Four	recordLength;	/* sum of the widths */
+    Four	offset;		/* offset of the next minipage */
+    Two		c;		/* column */
+
+
+	eduom_InitPageHeader((SlottedPage*)apage, fid, pid);
+	SET_PAGE_TYPE(apage, PAX_PAGE_TYPE);
+	apage->header.free = PAGESIZE - sizeof(SlottedPageHdr);
+
+	for (recordLength = 0, c = 0; c < nColumns; c++) recordLength += widths[c];
+
+	apage->pax.nColumns = nColumns;
+	apage->pax.nRecords = 0;
+	apage->pax.maxRecords = PAX_MAX_RECORDS(nColumns, recordLength);
+
+	for (offset = ALIGNED_LENGTH((Four)PAX_FIXED) - PAX_FIXED, c = 0; c < nColumns; c++) {
+		apage->pax.width[c] = widths[c];
+		apage->pax.minipage[c] = offset;
+		offset += ALIGNED_LENGTH(widths[c] * apage->pax.maxRecords);
+	}
+
+} /* eduom_PaxInitPage() */
+
+
+
+/*@================================
+ * eduom_PaxRead()
+ *================================*/
+/*
+ * Function: Four eduom_PaxRead(PaxPage*, Two, Four, Four, char*)
+ *
+ * Description :
+ *  Copy the bytes from 'start' of a record of a PAX page into 'buf'; the
+ *  bytes of a record are the values of its columns in order.
+ *
+ * Returns:
+ *  1) number of bytes read
+ *  2) error code
+ *    eBADOBJECTID_OM
+ *    eBADSTART_OM
+ *    eBADLENGTH_OM
+ */
+Four eduom_PaxRead(
+    PaxPage	*apage,		/* IN pointer to the buffer of the page */
+    Two		recordNo,	/* IN record to read */
+    Four	start,		/* IN starting offset of read */
+    Four	length,		/* IN amount of data to read; REMAINDER for the rest */
+    char	*buf)		/* OUT user buffer */
+{
+    Four	recordLength;	/* sum of the widths */
+    Four	colStart;	/* offset of the column in the record */
+    Four	from, to;	/* range of the column read */
+    Two		c;		/* column */
+
+
+	if (recordNo < 0 || recordNo >= apage->pax.nRecords) ERR(eBADOBJECTID_OM);
+
+	for (recordLength = 0, c = 0; c < apage->pax.nColumns; c++) recordLength += apage->pax.width[c];
+
+	if (start < 0 || start > recordLength) ERR(eBADSTART_OM);
+
+	if (length == REMAINDER) length = recordLength - start;
+
+	if (length < 0 || start + length > recordLength) ERR(eBADLENGTH_OM);
+
+	for (colStart = 0, c = 0; c < apage->pax.nColumns; colStart += apage->pax.width[c], c++) {
+		from = MAX(start, colStart);
+		to = MIN(start + length, colStart + apage->pax.width[c]);
+		if (from >= to) continue;
+
+		memcpy(buf + from - start,
+		       apage->data + apage->pax.minipage[c] + recordNo * apage->pax.width[c] + from - colStart,
+		       to - from);
+	}
+
+	return(length);
+
+} /* eduom_PaxRead() */
@@ -0,0 +1,1004 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_Bench.c
+ *
+ * Description :
+ *  YCSB-style workload driver for the object manager and the B+ tree index.
+ *  A data file of 'records' objects is loaded and indexed by an integer key;
+ *  then 'operations' operations, drawn from the read/update/insert/scan mix
+ *  of the workload, are run by 'threads' client threads against keys chosen
+ *  with a uniform or a (scrambled) Zipfian distribution.
+ *
+ *  The result is printed in the form "name key=value key=value ...":
+ *  one "ycsb_load" line, one "ycsb_run" line with the throughput and one
+ *  "ycsb_latency" line per operation type with the latency percentiles.
+ *
+ *  Usage: EduBtM_Bench [key=value ...]
+ *    impl=edu|base         EduBtM_*() or the original BtM_*() index (edu)
+ *    om=edu|base           EduOM_*() of ../3-EduOM_64bit or the original
+ *                          OM_*() storing the records (edu)
+ *    workload=a|b|c|e      YCSB core workload presets (a)
+ *                            a: 50% read, 50% update
+ *                            b: 95% read, 5% update
+ *                            c: 100% read
+ *                            e: 95% scan, 5% insert
+ *    read=, update=, insert=, scan=
+ *                          percentages overriding the preset
+ *    distribution=zipfian|uniform
+ *                          distribution of the accessed keys (zipfian)
+ *    records=N             # of records loaded (10000)
+ *    operations=N          # of operations run (100000)
+ *    record_bytes=N        size of a record (100)
+ *    threads=N             # of client threads (1)
+ *    scan_length=N         maximum # of records read by a scan (100)
+ *    seed=N                seed of the random number generators (1)
+ *
+ *  The storage system is not reentrant, so the operations of the client
+ *  threads are serialized; the latencies are those seen by the clients,
+ *  including the wait for the other threads. The buffer pool size is fixed
+ *  by the storage system; 'records' and 'record_bytes' set the size of the
+ *  data relative to the pool.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <pthread.h>
+#include <time.h>
+#include "EduBtM_common.h"
+#include "EduBtM.h"
+#include "EduBtM_Internal.h"
+#include "EduBtM_TestModule.h"
+
+
+
+/*@
+ * Constant Definitions
+ */
+#define BENCH_MAX_THREADS           64
+#define BENCH_DEFAULT_RECORDS       10000
+#define BENCH_DEFAULT_OPERATIONS    100000
+#define BENCH_DEFAULT_RECORDSIZE    100
+#define BENCH_DEFAULT_SCANLENGTH    100
+#define BENCH_ZIPFIAN_CONSTANT      0.99        /* YCSB's default skew */
+#define BENCH_RECORD_OVERHEAD       32          /* object header and slot */
+#define BENCH_INDEX_PAGES           1000        /* volume pages for the index */
+#define BENCH_VOLUME_NAME           "bench.vol"
+#define BENCH_VOLUME_ID             1000
+#define BENCH_EXTENT_SIZE           16
+
+#ifndef REMAINDER
+#define REMAINDER                   -1          /* to the end of the object */
+#endif
+
+/* operation types */
+#define BENCH_OP_READ               0
+#define BENCH_OP_UPDATE             1
+#define BENCH_OP_INSERT             2
+#define BENCH_OP_SCAN               3
+#define BENCH_NUM_OPS               4
+
+/* key distributions */
+#define BENCH_DIST_UNIFORM          0
+#define BENCH_DIST_ZIPFIAN          1
+
+
+/*@
+ * Type Definitions
+ */
+/* the index functions under test */
+typedef struct {
+    char        *name;
+    Four        (*insertObject)(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
+    Four        (*fetch)(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+    Four        (*fetchNext)(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
+} BenchIndexImpl;
+
+/* the object functions that store the records */
+typedef struct {
+    char        *name;
+    Four        (*createObject)(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*);
+    Four        (*readObject)(ObjectID*, Four, Four, char*);
+    Four        (*writeObject)(ObjectID*, Four, Four, void*);
+} BenchObjectImpl;
+
+/* Zipfian generator of Gray et al., "Quickly Generating Billion-Record Synthetic Databases" */
+typedef struct {
+    Four        nItems;         /* items are 0 .. nItems-1 */
+    double      theta;          /* skew */
+    double      alpha;          /* 1 / (1 - theta) */
+    double      zetan;          /* zeta(nItems, theta) */
+    double      eta;
+} ZipfianGen;
+
+/* parameters of a run */
+typedef struct {
+    BenchIndexImpl *impl;       /* index functions under test */
+    BenchObjectImpl *om;        /* object functions storing the records */
+    char        *workload;      /* name of the workload */
+    Four        percent[BENCH_NUM_OPS]; /* operation mix */
+    Four        distribution;   /* BENCH_DIST_XXX */
+    Four        nRecords;       /* # of records loaded */
+    Four        nOperations;    /* # of operations run */
+    Four        recordSize;     /* size of a record */
+    Four        nThreads;       /* # of client threads */
+    Four        scanLength;     /* maximum # of records of a scan */
+    UFour       seed;           /* seed of the random number generators */
+} BenchConfig;
+
+/* the database under test; shared by the client threads */
+typedef struct {
+    BenchConfig *config;
+    Four        handle;         /* system handle */
+    Four        volId;          /* volume identifier */
+    XactID      xactId;         /* transaction of the benchmark */
+    FileID      fid;            /* data file */
+    ObjectID    catalogEntry;   /* catalog entry of the data file */
+    PageID      rootPid;        /* root of the index */
+    KeyDesc     kdesc;          /* key descriptor of the index */
+    Four        nextKey;        /* key of the next inserted record */
+    ZipfianGen  zipf;           /* key generator for BENCH_DIST_ZIPFIAN */
+    pthread_mutex_t lock;       /* serializes the operations */
+} BenchDB;
+
+/* a client thread */
+typedef struct {
+    BenchDB     *db;
+    Four        nOps;           /* # of operations to run */
+    UEight      random;         /* state of the random number generator */
+    char        *record;        /* record buffer */
+    One         *opType;        /* type of each operation run */
+    double      *latency;       /* latency of each operation run in usec */
+    Four        e;              /* error of the thread */
+} ClientArg;
+
+
+/*@ Function Prototypes */
+Four SM_CreateFile(Four, FileID*, Boolean, void*);
+Four sm_GetCatalogEntryFromDataFileId(Four, FileID*, ObjectID*);
+Four OM_CreateObject(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*);
+Four OM_ReadObject(ObjectID*, Four, Four, char*);
+Four OM_WriteObject(ObjectID*, Four, Four, void*);
+Four EduOM_CreateObject(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*);
+Four EduOM_ReadObject(ObjectID*, Four, Four, char*);
+Four EduOM_WriteObject(ObjectID*, Four, Four, void*);
+Four BtM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
+Four BtM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+Four BtM_FetchNext(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
+
+/*@ Internal Function Prototypes */
+static double bench_Now(void);
+static double bench_Random(UEight *);
+static UEight bench_Hash(UEight);
+static void bench_InitZipfian(ZipfianGen *, Four, double);
+static Four bench_NextZipfian(ZipfianGen *, UEight *);
+static Four bench_ChooseKey(BenchDB *, UEight *);
+static void bench_MakeKey(KeyValue *, Four);
+static Four bench_InsertRecord(BenchDB *, Four, char *);
+static Four bench_RunOperation(BenchDB *, Four, UEight *, char *);
+static void *bench_ClientThread(void *);
+static Four bench_Open(BenchDB *, BenchConfig *);
+static void bench_Close(BenchDB *);
+static Four bench_Load(BenchDB *);
+static Four bench_Run(BenchDB *);
+static int bench_CompareLatency(const void *, const void *);
+static void bench_PrintLatency(Four, double *, Four);
+static Four bench_ParseArgs(BenchConfig *, int, char **);
+
+
+static BenchIndexImpl benchImpls[] = {
+    { "edu",  EduBtM_InsertObject, EduBtM_Fetch, EduBtM_FetchNext },
+    { "base", BtM_InsertObject,    BtM_Fetch,    BtM_FetchNext    },
+};
+
+static BenchObjectImpl benchOms[] = {
+    { "edu",  EduOM_CreateObject, EduOM_ReadObject, EduOM_WriteObject },
+    { "base", OM_CreateObject,    OM_ReadObject,    OM_WriteObject    },
+};
+
+static char *benchOpNames[BENCH_NUM_OPS] = { "read", "update", "insert", "scan" };
+
+
+
+/*@================================
+ * bench_Now()
+ *================================*/
+/*
+ * Function: static double bench_Now(void)
+ *
+ * Description:
+ *  Return the current time in seconds.
+ */
+static double bench_Now(void)
+{
+    struct timespec     ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return(ts.tv_sec + ts.tv_nsec / 1e9);
+
+}  /* bench_Now() */
+
+
+
+/*@================================
+ * bench_Random()
+ *================================*/
+/*
+ * Function: static double bench_Random(UEight *)
+ *
+ * Description:
+ *  Return the next number in [0, 1) of a xorshift64* generator.
+ */
+static double bench_Random(
+    UEight              *state)                 /* INOUT state of the generator */
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return(((*state * 2685821657736338717UL) >> 11) / 9007199254740992.0);
+
+}  /* bench_Random() */
+
+
+
+/*@================================
+ * bench_Hash()
+ *================================*/
+/*
+ * Function: static UEight bench_Hash(UEight)
+ *
+ * Description:
+ *  Return the 64 bit FNV-1a hash of a value; used to scatter the popular
+ *  items of the Zipfian distribution over the key space.
+ */
+static UEight bench_Hash(
+    UEight              value)                  /* IN value to hash */
+{
+    UEight              hash = 0xCBF29CE484222325UL;
+    Four                i;
+
+
+    for (i = 0; i < 8; i++) {
+        hash ^= value & 0xFF;
+        hash *= 0x100000001B3UL;
+        value >>= 8;
+    }
+
+    return(hash);
+
+}  /* bench_Hash() */
+
+
+
+/*@================================
+ * bench_InitZipfian()
+ *================================*/
+/*
+ * Function: static void bench_InitZipfian(ZipfianGen *, Four, double)
+ *
+ * Description:
+ *  Initialize a generator of Zipfian distributed items 0 .. nItems-1.
+ */
+static void bench_InitZipfian(
+    ZipfianGen          *zipf,                  /* OUT the generator */
+    Four                nItems,                 /* IN # of items */
+    double              theta)                  /* IN skew */
+{
+    Four                i;
+    double              zeta2;
+
+
+    zipf->nItems = nItems;
+    zipf->theta = theta;
+    zipf->alpha = 1.0 / (1.0 - theta);
+
+    for (i = 1, zipf->zetan = 0.0; i <= nItems; i++)
+        zipf->zetan += 1.0 / pow((double)i, theta);
+    zeta2 = 1.0 + 1.0 / pow(2.0, theta);
+
+    zipf->eta = (1.0 - pow(2.0 / nItems, 1.0 - theta)) / (1.0 - zeta2 / zipf->zetan);
+
+}  /* bench_InitZipfian() */
+
+
+
+/*@================================
+ * bench_NextZipfian()
+ *================================*/
+/*
+ * Function: static Four bench_NextZipfian(ZipfianGen *, UEight *)
+ *
+ * Description:
+ *  Return the next item of a Zipfian generator; item 0 is the most popular.
+ */
+static Four bench_NextZipfian(
+    ZipfianGen          *zipf,                  /* IN the generator */
+    UEight              *state)                 /* INOUT state of the random number generator */
+{
+    double              u, uz;
+    Four                item;
+
+
+    u = bench_Random(state);
+    uz = u * zipf->zetan;
+
+    if (uz < 1.0) return(0);
+    if (uz < 1.0 + pow(0.5, zipf->theta)) return(1);
+
+    item = (Four)(zipf->nItems * pow(zipf->eta * u - zipf->eta + 1.0, zipf->alpha));
+
+    return((item < zipf->nItems) ? item : zipf->nItems - 1);
+
+}  /* bench_NextZipfian() */
+
+
+
+/*@================================
+ * bench_ChooseKey()
+ *================================*/
+/*
+ * Function: static Four bench_ChooseKey(BenchDB *, UEight *)
+ *
+ * Description:
+ *  Choose the key of an existing record to access.
+ *  The caller must hold the lock of the database.
+ */
+static Four bench_ChooseKey(
+    BenchDB             *db,                    /* IN the database */
+    UEight              *state)                 /* INOUT state of the random number generator */
+{
+    if (db->config->distribution == BENCH_DIST_ZIPFIAN)
+        return((Four)(bench_Hash(bench_NextZipfian(&db->zipf, state)) % db->nextKey));
+    else
+        return((Four)(bench_Random(state) * db->nextKey));
+
+}  /* bench_ChooseKey() */
+
+
+
+/*@================================
+ * bench_MakeKey()
+ *================================*/
+/*
+ * Function: static void bench_MakeKey(KeyValue *, Four)
+ *
+ * Description:
+ *  Construct the index key value of a record.
+ */
+static void bench_MakeKey(
+    KeyValue            *kval,                  /* OUT key value */
+    Four                key)                    /* IN key of the record */
+{
+    Four_Invariable     k = key;
+
+
+    kval->len = sizeof(Four_Invariable);
+    memcpy(&(kval->val[0]), &k, sizeof(Four_Invariable));
+
+}  /* bench_MakeKey() */
+
+
+
+/*@================================
+ * bench_InsertRecord()
+ *================================*/
+/*
+ * Function: static Four bench_InsertRecord(BenchDB *, Four, char *)
+ *
+ * Description:
+ *  Create the object of a record and insert its key into the index.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_InsertRecord(
+    BenchDB             *db,                    /* IN the database */
+    Four                key,                    /* IN key of the record */
+    char                *record)                /* IN record buffer */
+{
+    Four                e;                      /* for errors */
+    ObjectHdr           objHdr;                 /* header of the new object */
+    ObjectID            oid;                    /* the new object */
+    KeyValue            kval;
+
+
+    objHdr.properties = 0;
+    objHdr.tag = 0;
+    objHdr.length = 0;
+
+    /* the key heads the record */
+    memcpy(record, &key, sizeof(Four));
+
+    e = db->config->om->createObject(&db->catalogEntry, NULL, &objHdr, db->config->recordSize, record, &oid);
+    if (e < eNOERROR) ERR(e);
+
+    bench_MakeKey(&kval, key);
+    e = db->config->impl->insertObject(&db->catalogEntry, &db->rootPid, &db->kdesc, &kval, &oid, NULL, NULL);
+    if (e < eNOERROR) ERR(e);
+
+    return(eNOERROR);
+
+}  /* bench_InsertRecord() */
+
+
+
+/*@================================
+ * bench_RunOperation()
+ *================================*/
+/*
+ * Function: static Four bench_RunOperation(BenchDB *, Four, UEight *, char *)
+ *
+ * Description:
+ *  Run an operation of the given type.
+ *  The caller must hold the lock of the database.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_RunOperation(
+    BenchDB             *db,                    /* IN the database */
+    Four                opType,                 /* IN BENCH_OP_XXX */
+    UEight              *state,                 /* INOUT state of the random number generator */
+    char                *record)                /* INOUT record buffer */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    Four                key;
+    Four                i, length;
+    KeyValue            kval, stopKval;
+    BtreeCursor         cursor, next;
+
+
+    if (opType == BENCH_OP_INSERT) {
+        e = bench_InsertRecord(db, db->nextKey, record);
+        if (e < eNOERROR) ERR(e);
+        db->nextKey++;
+
+        return(eNOERROR);
+    }
+
+    key = bench_ChooseKey(db, state);
+    bench_MakeKey(&kval, key);
+
+    if (opType == BENCH_OP_SCAN) {
+        /* scan the records with keys in [key, key + length) */
+        length = 1 + (Four)(bench_Random(state) * config->scanLength);
+        bench_MakeKey(&stopKval, key + length);
+
+        e = config->impl->fetch(&db->rootPid, &db->kdesc, &kval, SM_GE, &stopKval, SM_LT, &cursor);
+        if (e < eNOERROR) ERR(e);
+
+        for (i = 0; i < length && cursor.flag == CURSOR_ON; i++) {
+            e = config->om->readObject(&cursor.oid, 0, REMAINDER, record);
+            if (e < eNOERROR) ERR(e);
+
+            e = config->impl->fetchNext(&db->rootPid, &db->kdesc, &stopKval, SM_LT, &cursor, &next);
+            if (e < eNOERROR) ERR(e);
+            cursor = next;
+        }
+
+        return(eNOERROR);
+    }
+
+    e = config->impl->fetch(&db->rootPid, &db->kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+    if (e < eNOERROR) ERR(e);
+    if (cursor.flag != CURSOR_ON) ERR(eNOTFOUND_BTM);
+
+    if (opType == BENCH_OP_READ) {
+        e = config->om->readObject(&cursor.oid, 0, REMAINDER, record);
+        if (e < eNOERROR) ERR(e);
+    }
+    else {
+        /* overwrite the record except its key */
+        for (i = sizeof(Four); i < config->recordSize; i++)
+            record[i] = 'a' + (Four)(bench_Random(state) * 26);
+
+        e = config->om->writeObject(&cursor.oid, sizeof(Four), config->recordSize - sizeof(Four), record + sizeof(Four));
+        if (e < eNOERROR) ERR(e);
+    }
+
+    return(eNOERROR);
+
+}  /* bench_RunOperation() */
+
+
+
+/*@================================
+ * bench_ClientThread()
+ *================================*/
+/*
+ * Function: static void *bench_ClientThread(void *)
+ *
+ * Description:
+ *  Run operations drawn from the workload mix one after another,
+ *  recording the latency of each.
+ */
+static void *bench_ClientThread(
+    void                *argument)              /* IN ClientArg */
+{
+    ClientArg           *arg = (ClientArg*)argument;
+    BenchDB             *db = arg->db;
+    Four                i, opType;
+    Four                dice;
+    double              start;
+
+
+    arg->e = eNOERROR;
+    for (i = 0; i < arg->nOps; i++) {
+
+        dice = (Four)(bench_Random(&arg->random) * 100);
+        for (opType = 0; opType < BENCH_NUM_OPS - 1; opType++) {
+            if (dice < db->config->percent[opType]) break;
+            dice -= db->config->percent[opType];
+        }
+
+        start = bench_Now();
+
+        pthread_mutex_lock(&db->lock);
+        arg->e = bench_RunOperation(db, opType, &arg->random, arg->record);
+        pthread_mutex_unlock(&db->lock);
+
+        arg->latency[i] = (bench_Now() - start) * 1e6;
+        arg->opType[i] = opType;
+
+        if (arg->e < eNOERROR) break;
+    }
+
+    return(NULL);
+
+}  /* bench_ClientThread() */
+
+
+
+/*@================================
+ * bench_Open()
+ *================================*/
+/*
+ * Function: static Four bench_Open(BenchDB *, BenchConfig *)
+ *
+ * Description:
+ *  Initialize the storage system, format and mount a volume large enough
+ *  for the run, begin a transaction and create the data file and its index.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Open(
+    BenchDB             *db,                    /* OUT the database */
+    BenchConfig         *config)                /* IN parameters of the run */
+{
+    Four                e;                      /* for errors */
+    char                *devNames[1];           /* device name */
+    Four                numPagesInDevices[1];   /* # of pages in the device */
+    double              maxRecords;             /* # of records after the run */
+    Four                recordsPerPage;
+
+
+    db->config = config;
+    db->nextKey = 0;
+    pthread_mutex_init(&db->lock, NULL);
+
+    maxRecords = config->nRecords + (double)config->nOperations * config->percent[BENCH_OP_INSERT] / 100 + 1;
+    recordsPerPage = PAGESIZE / (config->recordSize + BENCH_RECORD_OVERHEAD);
+    if (recordsPerPage < 1) ERR(eBADPARAMETER_BTM);
+
+    numPagesInDevices[0] = (Four)(maxRecords / recordsPerPage) * 2 + BENCH_INDEX_PAGES;
+    numPagesInDevices[0] -= numPagesInDevices[0] % BENCH_EXTENT_SIZE;
+    devNames[0] = BENCH_VOLUME_NAME;
+    db->volId = BENCH_VOLUME_ID;
+
+    e = LRDS_Init();
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_AllocHandle(&db->handle);
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_FormatDataVolume(1, devNames, "bench", db->volId, BENCH_EXTENT_SIZE, numPagesInDevices, BENCH_EXTENT_SIZE);
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_Mount(1, devNames, &db->volId);
+    if (e < eNOERROR) ERR(e);
+
+    e = LRDS_BeginTransaction(&db->xactId, X_RR_RR);
+    if (e < eNOERROR) ERR(e);
+
+    e = SM_CreateFile(db->volId, &db->fid, FALSE, NULL);
+    if (e < eNOERROR) ERR(e);
+
+    e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &db->fid, &db->catalogEntry);
+    if (e < eNOERROR) ERR(e);
+
+    e = EduBtM_CreateIndex(&db->catalogEntry, &db->rootPid);
+    if (e < eNOERROR) ERR(e);
+
+    db->kdesc.flag = KEYFLAG_UNIQUE;
+    db->kdesc.nparts = 1;
+    db->kdesc.kpart[0].type = SM_INT;
+    db->kdesc.kpart[0].offset = 0;
+    db->kdesc.kpart[0].length = sizeof(Four);
+
+    return(eNOERROR);
+
+}  /* bench_Open() */
+
+
+
+/*@================================
+ * bench_Close()
+ *================================*/
+/*
+ * Function: static void bench_Close(BenchDB *)
+ *
+ * Description:
+ *  Commit the transaction, dismount the volume and finalize the system.
+ */
+static void bench_Close(
+    BenchDB             *db)                    /* IN the database */
+{
+    LRDS_CommitTransaction(&db->xactId);
+    LRDS_Dismount(db->volId);
+    LRDS_FreeHandle(db->handle);
+    LRDS_Final();
+
+    pthread_mutex_destroy(&db->lock);
+    unlink(BENCH_VOLUME_NAME);
+
+}  /* bench_Close() */
+
+
+
+/*@================================
+ * bench_Load()
+ *================================*/
+/*
+ * Function: static Four bench_Load(BenchDB *)
+ *
+ * Description:
+ *  Load the initial records in key order and print the load throughput.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Load(
+    BenchDB             *db)                    /* INOUT the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    char                *record;                /* record buffer */
+    double              start, elapsed;
+
+
+    record = (char*)malloc(config->recordSize);
+    if (record == NULL) ERR(eMEMORYALLOCERR_EDUBTM);
+    memset(record, 'x', config->recordSize);
+
+    start = bench_Now();
+
+    for (db->nextKey = 0; db->nextKey < config->nRecords; db->nextKey++) {
+        e = bench_InsertRecord(db, db->nextKey, record);
+        if (e < eNOERROR) {
+            free(record);
+            ERR(e);
+        }
+    }
+
+    elapsed = bench_Now() - start;
+    free(record);
+
+    printf("ycsb_load impl=%s om=%s records=%ld record_bytes=%ld seconds=%.3f ops_per_sec=%.0f\n",
+           config->impl->name, config->om->name, (long)config->nRecords, (long)config->recordSize,
+           elapsed, config->nRecords / elapsed);
+    fflush(stdout);
+
+    return(eNOERROR);
+
+}  /* bench_Load() */
+
+
+
+/*@================================
+ * bench_Run()
+ *================================*/
+/*
+ * Function: static Four bench_Run(BenchDB *)
+ *
+ * Description:
+ *  Run the operations of the workload with the client threads and print
+ *  the throughput and the latency percentiles of each operation type.
+ *
+ * Returns:
+ *  error code
+ */
+static Four bench_Run(
+    BenchDB             *db)                    /* INOUT the database */
+{
+    Four                e;                      /* for errors */
+    BenchConfig         *config = db->config;
+    pthread_t           thread[BENCH_MAX_THREADS];
+    ClientArg           arg[BENCH_MAX_THREADS];
+    double              *latency;               /* latencies of an operation type */
+    Four                count[BENCH_NUM_OPS];
+    Four                i, j, opType;
+    double              start, elapsed;
+
+
+    latency = (double*)malloc(sizeof(double) * config->nOperations);
+    if (latency == NULL) ERR(eMEMORYALLOCERR_EDUBTM);
+
+    for (i = 0; i < config->nThreads; i++) {
+        arg[i].db = db;
+        arg[i].nOps = config->nOperations / config->nThreads + (i < config->nOperations % config->nThreads);
+        arg[i].random = bench_Hash(config->seed * BENCH_MAX_THREADS + i) | 1;
+        arg[i].record = (char*)malloc(config->recordSize);
+        arg[i].opType = (One*)malloc(sizeof(One) * (arg[i].nOps + 1));
+        arg[i].latency = (double*)malloc(sizeof(double) * (arg[i].nOps + 1));
+        if (arg[i].record == NULL || arg[i].opType == NULL || arg[i].latency == NULL) ERR(eMEMORYALLOCERR_EDUBTM);
+        memset(arg[i].record, 'x', config->recordSize);
+    }
+
+    start = bench_Now();
+
+    for (i = 0; i < config->nThreads; i++)
+        pthread_create(&thread[i], NULL, bench_ClientThread, &arg[i]);
+    for (i = 0; i < config->nThreads; i++)
+        pthread_join(thread[i], NULL);
+
+    elapsed = bench_Now() - start;
+
+    for (i = 0, e = eNOERROR; i < config->nThreads; i++)
+        if (arg[i].e < eNOERROR) e = arg[i].e;
+
+    if (e >= eNOERROR) {
+        printf("ycsb_run impl=%s om=%s workload=%s distribution=%s records=%ld record_bytes=%ld threads=%ld operations=%ld read_percent=%ld update_percent=%ld insert_percent=%ld scan_percent=%ld seconds=%.3f ops_per_sec=%.0f\n",
+               config->impl->name, config->om->name, config->workload,
+               (config->distribution == BENCH_DIST_ZIPFIAN) ? "zipfian" : "uniform",
+               (long)config->nRecords, (long)config->recordSize, (long)config->nThreads,
+               (long)config->nOperations, (long)config->percent[BENCH_OP_READ],
+               (long)config->percent[BENCH_OP_UPDATE], (long)config->percent[BENCH_OP_INSERT],
+               (long)config->percent[BENCH_OP_SCAN], elapsed, config->nOperations / elapsed);
+
+        for (opType = 0; opType < BENCH_NUM_OPS; opType++) {
+            for (i = 0, count[opType] = 0; i < config->nThreads; i++)
+                for (j = 0; j < arg[i].nOps; j++)
+                    if (arg[i].opType[j] == opType)
+                        latency[count[opType]++] = arg[i].latency[j];
+
+            if (count[opType] > 0) bench_PrintLatency(opType, latency, count[opType]);
+        }
+        fflush(stdout);
+    }
+
+    for (i = 0; i < config->nThreads; i++) {
+        free(arg[i].record);
+        free(arg[i].opType);
+        free(arg[i].latency);
+    }
+    free(latency);
+
+    if (e < eNOERROR) ERR(e);
+
+    return(eNOERROR);
+
+}  /* bench_Run() */
+
+
+
+/*@================================
+ * bench_CompareLatency()
+ *================================*/
+static int bench_CompareLatency(
+    const void          *a,
+    const void          *b)
+{
+    double              x = *(double*)a;
+    double              y = *(double*)b;
+
+
+    return((x < y) ? -1 : (x > y) ? 1 : 0);
+
+}  /* bench_CompareLatency() */
+
+
+
+/*@================================
+ * bench_PrintLatency()
+ *================================*/
+/*
+ * Function: static void bench_PrintLatency(Four, double *, Four)
+ *
+ * Description:
+ *  Print the average and the percentiles of the latencies of an operation type.
+ */
+static void bench_PrintLatency(
+    Four                opType,                 /* IN BENCH_OP_XXX */
+    double              *latency,               /* INOUT latencies in usec; sorted on return */
+    Four                n)                      /* IN # of latencies */
+{
+    double              sum;
+    Four                i;
+
+
+    qsort(latency, n, sizeof(double), bench_CompareLatency);
+
+    for (i = 0, sum = 0.0; i < n; i++) sum += latency[i];
+
+#define PERCENTILE(p) latency[(Four)((n - 1) * (p))]
+    printf("ycsb_latency op=%s count=%ld avg_us=%.2f p50_us=%.2f p95_us=%.2f p99_us=%.2f p999_us=%.2f max_us=%.2f\n",
+           benchOpNames[opType], (long)n, sum / n, PERCENTILE(0.50), PERCENTILE(0.95),
+           PERCENTILE(0.99), PERCENTILE(0.999), latency[n - 1]);
+#undef PERCENTILE
+
+}  /* bench_PrintLatency() */
+
+
+
+/*@================================
+ * bench_ParseArgs()
+ *================================*/
+/*
+ * Function: static Four bench_ParseArgs(BenchConfig *, int, char **)
+ *
+ * Description:
+ *  Set the parameters of the run from the "key=value" arguments.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ */
+static Four bench_ParseArgs(
+    BenchConfig         *config,                /* OUT parameters of the run */
+    int                 argc,                   /* IN # of arguments */
+    char                **argv)                 /* IN arguments */
+{
+    Four                i, op;
+    Four                override[BENCH_NUM_OPS];
+    char                *value;
+    Boolean             overridden = FALSE;
+
+
+    config->impl = &benchImpls[0];
+    config->om = &benchOms[0];
+    config->workload = "a";
+    config->distribution = BENCH_DIST_ZIPFIAN;
+    config->nRecords = BENCH_DEFAULT_RECORDS;
+    config->nOperations = BENCH_DEFAULT_OPERATIONS;
+    config->recordSize = BENCH_DEFAULT_RECORDSIZE;
+    config->nThreads = 1;
+    config->scanLength = BENCH_DEFAULT_SCANLENGTH;
+    config->seed = 1;
+    for (op = 0; op < BENCH_NUM_OPS; op++) override[op] = -1;
+
+    for (i = 1; i < argc; i++) {
+        value = strchr(argv[i], '=');
+        if (value == NULL) ERR(eBADPARAMETER_BTM);
+        *value++ = '\0';
+
+        if (strcmp(argv[i], "impl") == 0) {
+            if (strcmp(value, "edu") == 0) config->impl = &benchImpls[0];
+            else if (strcmp(value, "base") == 0) config->impl = &benchImpls[1];
+            else ERR(eBADPARAMETER_BTM);
+        }
+        else if (strcmp(argv[i], "om") == 0) {
+            if (strcmp(value, "edu") == 0) config->om = &benchOms[0];
+            else if (strcmp(value, "base") == 0) config->om = &benchOms[1];
+            else ERR(eBADPARAMETER_BTM);
+        }
+        else if (strcmp(argv[i], "workload") == 0) config->workload = value;
+        else if (strcmp(argv[i], "distribution") == 0) {
+            if (strcmp(value, "zipfian") == 0) config->distribution = BENCH_DIST_ZIPFIAN;
+            else if (strcmp(value, "uniform") == 0) config->distribution = BENCH_DIST_UNIFORM;
+            else ERR(eBADPARAMETER_BTM);
+        }
+        else if (strcmp(argv[i], "records") == 0) config->nRecords = atol(value);
+        else if (strcmp(argv[i], "operations") == 0) config->nOperations = atol(value);
+        else if (strcmp(argv[i], "record_bytes") == 0) config->recordSize = atol(value);
+        else if (strcmp(argv[i], "threads") == 0) config->nThreads = atol(value);
+        else if (strcmp(argv[i], "scan_length") == 0) config->scanLength = atol(value);
+        else if (strcmp(argv[i], "seed") == 0) config->seed = atol(value);
+        else {
+            for (op = 0; op < BENCH_NUM_OPS; op++)
+                if (strcmp(argv[i], benchOpNames[op]) == 0) break;
+            if (op == BENCH_NUM_OPS) ERR(eBADPARAMETER_BTM);
+            override[op] = atol(value);
+            overridden = TRUE;
+        }
+    }
+
+    /* operation mix of the preset */
+    for (op = 0; op < BENCH_NUM_OPS; op++) config->percent[op] = 0;
+    if (strcmp(config->workload, "a") == 0) {
+        config->percent[BENCH_OP_READ] = 50;
+        config->percent[BENCH_OP_UPDATE] = 50;
+    }
+    else if (strcmp(config->workload, "b") == 0) {
+        config->percent[BENCH_OP_READ] = 95;
+        config->percent[BENCH_OP_UPDATE] = 5;
+    }
+    else if (strcmp(config->workload, "c") == 0) {
+        config->percent[BENCH_OP_READ] = 100;
+    }
+    else if (strcmp(config->workload, "e") == 0) {
+        config->percent[BENCH_OP_SCAN] = 95;
+        config->percent[BENCH_OP_INSERT] = 5;
+    }
+    else if (!overridden) ERR(eBADPARAMETER_BTM);
+
+    /* an explicit mix replaces the preset */
+    if (overridden) {
+        for (op = 0; op < BENCH_NUM_OPS; op++)
+            config->percent[op] = (override[op] < 0) ? 0 : override[op];
+        if (strcmp(config->workload, "a") == 0) config->workload = "custom";
+    }
+
+    for (op = 0, i = 0; op < BENCH_NUM_OPS; op++) i += config->percent[op];
+    if (i != 100) ERR(eBADPARAMETER_BTM);
+
+    if (config->nRecords < 2 || config->nOperations < 1 ||
+        config->recordSize < sizeof(Four) || config->recordSize > PAGESIZE / 2 ||
+        config->nThreads < 1 || config->nThreads > BENCH_MAX_THREADS || config->scanLength < 1)
+        ERR(eBADPARAMETER_BTM);
+
+    return(eNOERROR);
+
+}  /* bench_ParseArgs() */
+
+
+
+/*@================================
+ * main()
+ *================================*/
+int main(int argc, char *argv[])
+{
+    Four                e;                      /* for errors */
+    BenchConfig         config;
+    BenchDB             db;
+
+
+    e = bench_ParseArgs(&config, argc, argv);
+    if (e < eNOERROR) {
+        fprintf(stderr, "Usage: %s [impl=edu|base] [om=edu|base] [workload=a|b|c|e] [read=%%] [update=%%] [insert=%%] [scan=%%]\n", argv[0]);
+        fprintf(stderr, "       [distribution=zipfian|uniform] [records=N] [operations=N] [record_bytes=N]\n");
+        fprintf(stderr, "       [threads=N] [scan_length=N] [seed=N]\n");
+        exit(1);
+    }
+
+    if (config.distribution == BENCH_DIST_ZIPFIAN)
+        bench_InitZipfian(&db.zipf, config.nRecords, BENCH_ZIPFIAN_CONSTANT);
+
+    e = bench_Open(&db, &config);
+    if (e >= eNOERROR) e = bench_Load(&db);
+    if (e >= eNOERROR) e = bench_Run(&db);
+
+    bench_Close(&db);
+
+    return((e < eNOERROR) ? 1 : 0);
+
+}  /* main() */
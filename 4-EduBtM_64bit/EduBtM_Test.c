@@ -37,10 +37,14 @@
 #include "EduBtM_basictypes.h"
 #include "EduBtM.h"
 #include "EduBtM_TestModule.h"
+#include "OM_Internal.h"
 Four dumpBtreePage(PageID*, KeyDesc);
 void dumpInternal(BtreeInternal*, PageID*, Two);
 void dumpLeaf(BtreeLeaf*, PageID*, Two);
 void dumpOverflow(BtreeOverflow*, PageID*);
+Four splitTest(Four);
+void makeSplitKey(Four, KeyValue*);
+Four checkBtreePage(PageID*, Boolean, Four*, Four*);
 
 /*@================================
  * EduBtM_Test()
@@ -815,9 +819,297 @@ Four EduBtM_Test(Four volId, Four handle){
 	/* Destroy File */
 	e = SM_DestroyFile(&fid, NULL);
 	if (e < eNOERROR) ERR(e);
+/* End test for variable key value. */
+
+	printf("Press enter key to continue...");
+	getchar();
+	printf("\n\n");
+
+	e = splitTest(volId);
+	if (e < eNOERROR) ERR(e);
 
 }
-/* End test for variable key value. */
+
+
+/*@================================
+ * splitTest()
+ *================================*/
+/*
+ * Function: Four splitTest(Four)
+ *
+ * Description:
+ *  Test the splits of the B+ tree pages. Variable string keys of odd and
+ *  even lengths are inserted in a scrambled order, so that the new entry of
+ *  a split goes into the middle of a page and the internal pages split, and
+ *  the index is checked by scans and by a walk over all of its pages.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four splitTest(
+		Four		volId)			/* IN volume identifier */
+{
+	Four e;												/* for errors */
+	Four i;												/* loop index */
+	Four n;												/* # of keys found */
+	Four keyNo;											/* number of a key */
+	Four nLeaves;										/* # of leaves reached from the root */
+	Four nChained;										/* # of leaves on the leaf page list */
+	Four nErrors;										/* # of errors found */
+	FileID      fid;                                    /* file identifier */
+	ObjectID    catalogEntry;                           /* catalog object */
+	ObjectID	oid;									/* object id */
+	PageID		rootPid;								/* root page identifier */
+	PageID		leafPid;								/* leaf page identifier */
+	PageID		catPid;									/* page containing the catalog object */
+	PhysicalFileID pFid;								/* physical file identifier for EduBtM_DropIndex() */
+	KeyValue	kval;									/* value of key */
+	KeyDesc		kdesc;									/* key descriptor */
+	BtreeCursor	cursor;									/* cursor for EduBtM_FetchNext() */
+	BtreeLeaf	*leaf;									/* leaf page on the leaf page list */
+	SlottedPage	*catPage;								/* page containing the catalog object */
+    sm_CatOverlayForBtree *catEntry;	 				/* Btree part of the catalog entry */
+
+    printf("############################## Start EduBtM test for page splits ##############################\n");
+
+	/* Create File */
+	e = SM_CreateFile(volId, &fid, FALSE, NULL);
+	if (e < eNOERROR) ERR(e);
+	/* Get catalog entry */
+	e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fid, &catalogEntry);
+	if (e < eNOERROR) ERR(e);
+
+	kdesc.flag = KEYFLAG_UNIQUE;
+	kdesc.nparts = 1;
+	kdesc.kpart[0].type = SM_VARSTRING;
+	kdesc.kpart[0].offset = 0;
+	kdesc.kpart[0].length = MAXPLAYERNAME;
+
+	oid.pageNo = 777;
+	oid.volNo = volId;
+
+	e = EduBtM_CreateIndex(&catalogEntry, &rootPid);
+	if (e < eNOERROR) ERR(e);
+
+	printf("****************************** TEST#1, Leaf page splits. ******************************\n");
+	printf("*Test 1_1 : %d keys are inserted in a scrambled order and scanned\n", NUMOFSPLITLEAFKEYS);
+
+	for (i = 0; i < NUMOFSPLITLEAFKEYS; i++) {
+		keyNo = (i * SPLITKEYSTEP) % NUMOFSPLITLEAFKEYS;
+		makeSplitKey(keyNo, &kval);
+		oid.slotNo = keyNo;
+		oid.unique = keyNo;
+		e = EduBtM_InsertObject(&catalogEntry, &rootPid, &kdesc, &kval, &oid, NULL, NULL);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	n = 0;
+	e = EduBtM_Fetch(&rootPid, &kdesc, &kval, SM_BOF, &kval, SM_EOF, &cursor);
+	if (e < eNOERROR) ERR(e);
+	while (cursor.flag != CURSOR_EOS && cursor.oid.unique == n) {
+		n++;
+		e = EduBtM_FetchNext(&rootPid, &kdesc, &kval, SM_EOF, &cursor, &cursor);
+		if (e < eNOERROR) ERR(e);
+	}
+	if (cursor.flag == CURSOR_EOS && n == NUMOFSPLITLEAFKEYS)
+		printf("The %d keys are scanned in order.\n", n);
+	else
+		printf("Error: the scan is out of order after %d keys.\n", n);
+	printf("****************************** TEST#1, Leaf page splits. ******************************\n");
+
+	printf("****************************** TEST#2, Internal page splits. ******************************\n");
+	printf("*Test 2_1 : %d more keys are inserted and each key is fetched\n", NUMOFSPLITKEYS - NUMOFSPLITLEAFKEYS);
+
+	for (i = 0; i < NUMOFSPLITKEYS - NUMOFSPLITLEAFKEYS; i++) {
+		keyNo = NUMOFSPLITLEAFKEYS + (i * SPLITKEYSTEP) % (NUMOFSPLITKEYS - NUMOFSPLITLEAFKEYS);
+		makeSplitKey(keyNo, &kval);
+		oid.slotNo = keyNo;
+		oid.unique = keyNo;
+		e = EduBtM_InsertObject(&catalogEntry, &rootPid, &kdesc, &kval, &oid, NULL, NULL);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	for (n = 0; n < NUMOFSPLITKEYS; n++) {
+		makeSplitKey(n, &kval);
+		e = EduBtM_Fetch(&rootPid, &kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+		if (e < eNOERROR) ERR(e);
+		if (cursor.flag == CURSOR_EOS || cursor.oid.unique != n) break;
+	}
+	if (n == NUMOFSPLITKEYS)
+		printf("The %d keys are fetched.\n", n);
+	else
+		printf("Error: the key %d is not fetched.\n", n);
+	printf("****************************** TEST#2, Internal page splits. ******************************\n");
+
+	printf("****************************** TEST#3, B+ tree pages. ******************************\n");
+	printf("*Test 3_1 : All the pages of the index are checked\n");
+
+	nLeaves = nErrors = 0;
+	e = checkBtreePage(&rootPid, TRUE, &nLeaves, &nErrors);
+	if (e < eNOERROR) ERR(e);
+
+	e = EduBtM_Fetch(&rootPid, &kdesc, &kval, SM_BOF, &kval, SM_EOF, &cursor);
+	if (e < eNOERROR) ERR(e);
+	leafPid = cursor.leaf;
+	for (nChained = 0; leafPid.pageNo != NIL; nChained++) {
+		e = BfM_GetTrain(&leafPid, (char **)&leaf, PAGE_BUF);
+		if (e < eNOERROR) ERR(e);
+		leafPid.pageNo = leaf->hdr.nextPage;
+		e = BfM_FreeTrain(&cursor.leaf, PAGE_BUF);
+		if (e < eNOERROR) ERR(e);
+		cursor.leaf = leafPid;
+	}
+
+	if (nErrors == 0 && nLeaves == nChained)
+		printf("The pages are valid; %d leaves are reached from the root.\n", nLeaves);
+	else
+		printf("Error: %d bad pages; %d leaves are reached from the root and %d are on the leaf list.\n",
+			   nErrors, nLeaves, nChained);
+	printf("****************************** TEST#3, B+ tree pages. ******************************\n");
+
+	/* set pFid to the first page of the file */
+	MAKE_PAGEID(catPid, catalogEntry.volNo, catalogEntry.pageNo);
+	e = BfM_GetTrain(&catPid, (char **)&catPage, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+	GET_PTR_TO_CATENTRY_FOR_BTREE((&catalogEntry), catPage, catEntry);
+	MAKE_PHYSICALFILEID(pFid, catalogEntry.volNo, catEntry->firstPage);
+	e = BfM_FreeTrain(&catPid, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	e = EduBtM_DropIndex(&pFid, &rootPid, &dlPool, &dlHead);
+	if (e < eNOERROR) ERR(e);
+
+	/* Destroy File */
+	e = SM_DestroyFile(&fid, NULL);
+	if (e < eNOERROR) ERR(e);
+
+    printf("############################## End EduBtM test for page splits ##############################\n\n\n");
+
+	return(eNOERROR);
+
+}  /* splitTest() */
+
+
+/*@================================
+ * makeSplitKey()
+ *================================*/
+/*
+ * Function: void makeSplitKey(Four, KeyValue*)
+ *
+ * Description:
+ *  Make the variable string key of the given number. The keys are ordered
+ *  by their numbers and have odd and even lengths.
+ *
+ * Returns:
+ *  None
+ */
+void makeSplitKey(
+		Four		keyNo,			/* IN number of the key */
+		KeyValue	*kval)			/* OUT key value */
+{
+	char		name[MAXPLAYERNAME];	/* string of the key */
+	Two			len;					/* length of the string with the null character */
+
+	sprintf(name, "%06d", keyNo);
+	memset(&name[6], 'a' + keyNo % 26, 20 + (keyNo * 7) % 30);
+	name[26 + (keyNo * 7) % 30] = '\0';
+	len = strlen(name) + 1;
+
+	memcpy(&(kval->val[0]), &len, sizeof(Two));
+	memcpy(&(kval->val[sizeof(Two)]), name, len);
+	kval->len = sizeof(Two) + len;
+
+}  /* makeSplitKey() */
+
+
+/*@================================
+ * checkBtreePage()
+ *================================*/
+/*
+ * Function: Four checkBtreePage(PageID*, Boolean, Four*, Four*)
+ *
+ * Description:
+ *  Check the page and the pages below it. A page must be either an
+ *  internal page or a leaf, and only the root has the ROOT flag. The
+ *  entries and the unused bytes of a page must add up to the start of its
+ *  free space, and every entry of an internal page must point to a child
+ *  other than 'p0'. The leaves reached are counted.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four checkBtreePage(
+		PageID		*pid,			/* IN page to check */
+		Boolean		isRoot,			/* IN TRUE if the page is the root */
+		Four		*nLeaves,		/* INOUT # of leaves reached */
+		Four		*nErrors)		/* INOUT # of errors found */
+{
+	Four e;							/* error number */
+	Two i;							/* index variable */
+	BtreePage *apage;				/* page to check */
+	btm_InternalEntry *entry;		/* an internal entry */
+	btm_LeafEntry *lEntry;			/* a leaf entry */
+	Four used;						/* # of bytes used by the entries */
+	PageID child;					/* child page */
+	One type;						/* type of the page */
+
+	e = BfM_GetTrain(pid, (char **)&apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	type = apage->any.hdr.type;
+	if (((type & INTERNAL) != 0) == ((type & LEAF) != 0) || ((type & ROOT) != 0) != isRoot) {
+		printf("The page (PID: ( %d, %d )) has the type %d.\n", pid->volNo, pid->pageNo, type);
+		(*nErrors)++;
+	}
+	else if (type & INTERNAL) {
+		/* the entries and the unused bytes should add up to the start of the free space */
+		for (i = 0, used = 0; i < apage->bi.hdr.nSlots; i++) {
+			entry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-i]]);
+			used += sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(entry->klen);
+		}
+		if (used + apage->bi.hdr.unused != apage->bi.hdr.free) {
+			printf("The page (PID: ( %d, %d )) uses %d bytes but its free space starts at %d.\n",
+					pid->volNo, pid->pageNo, used + apage->bi.hdr.unused, apage->bi.hdr.free);
+			(*nErrors)++;
+		}
+
+		child.volNo = pid->volNo;
+		for (i = -1; i < apage->bi.hdr.nSlots; i++) {
+			if (i < 0)
+				child.pageNo = apage->bi.hdr.p0;
+			else {
+				entry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-i]]);
+				if (entry->spid == apage->bi.hdr.p0) {
+					printf("The entry %d of the page (PID: ( %d, %d )) is bad.\n", i, pid->volNo, pid->pageNo);
+					(*nErrors)++;
+					continue;
+				}
+				child.pageNo = entry->spid;
+			}
+			e = checkBtreePage(&child, FALSE, nLeaves, nErrors);
+			if (e < 0) ERRB1(e, pid, PAGE_BUF);
+		}
+	}
+	else {
+		for (i = 0, used = 0; i < apage->bl.hdr.nSlots; i++) {
+			lEntry = (btm_LeafEntry*)&(apage->bl.data[apage->bl.slot[-i]]);
+			used += 2*sizeof(Two) + ALIGNED_LENGTH(lEntry->klen) + sizeof(ObjectID);
+		}
+		if (used + apage->bl.hdr.unused != apage->bl.hdr.free) {
+			printf("The page (PID: ( %d, %d )) uses %d bytes but its free space starts at %d.\n",
+					pid->volNo, pid->pageNo, used + apage->bl.hdr.unused, apage->bl.hdr.free);
+			(*nErrors)++;
+		}
+		(*nLeaves)++;
+	}
+
+	e = BfM_FreeTrain(pid, PAGE_BUF);
+	if (e < 0) ERR(e);
+	return(eNOERROR);
+
+}  /* checkBtreePage() */
 
 
 /*@================================
@@ -64,7 +64,7 @@
 typedef struct {
 	PageID pid;                 /* page id of this page, should be located on the beginning */
 	Four flags;                 /* flag to store page information */
-	Four reserved;              /* reserved space to store page information */
+	Four reserved;              /* owned by the buffer manager: page checksum */
 	One    type;        /* Internal, Leaf, or Overflow */
 } BtreeAnyHdr;
 
@@ -83,7 +83,7 @@ typedef struct { /* Any Page */
 typedef struct {
 	PageID pid;                 /* page id of this page, should be located on the beginning */
 	Four flags;                 /* flag to store page information */
-	Four reserved;              /* reserved space to store page information */
+	Four reserved;              /* owned by the buffer manager: page checksum */
 	One     type;       /* Internal, Leaf, or Overflow */
 	ShortPageID p0;     /* the first pointer */
 	Two     nSlots;     /* # of entries in this page */
@@ -125,7 +125,7 @@ typedef struct {   /* Internal (Nonleaf) Page */
 typedef struct {
 	PageID pid;                 /* page id of this page, should be located on the beginning */
 	Four flags;                 /* flag to store page information */
-	Four reserved;              /* reserved space to store page information */
+	Four reserved;              /* owned by the buffer manager: page checksum */
 	One     type;            /* Internal, Leaf, or Overflow */
 	Two     nSlots;          /* # of entries in this page */
 	Two     free;            /* starting point of the free space */
@@ -168,7 +168,7 @@ typedef struct {   /* Leaf Page */
 typedef struct {
 	PageID pid;                 /* YKL24MAR97: page id of this page, should be located on the beginning */
 	Four flags;                 /* flag to store page information */
-	Four reserved;              /* reserved space to store page information */
+	Four reserved;              /* owned by the buffer manager: page checksum */
 	One     type;             /* Internal, Leaf, or Overflow */
 	ShortPageID nextPage;         /* Next Page */
 	ShortPageID prevPage;         /* Previous Page */
@@ -39,6 +39,9 @@
 #define NUMOFINSERTEDOBJECT	200
 #define NUMOFPLAYER 1000
 #define MAXPLAYERNAME 60
+#define NUMOFSPLITLEAFKEYS 1000
+#define NUMOFSPLITKEYS 4000
+#define SPLITKEYSTEP 7919
 
 
 DeallocListElem dlHead;
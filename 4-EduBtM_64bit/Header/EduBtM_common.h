@@ -213,7 +213,7 @@ typedef struct Lsn_T_tag {
 typedef struct PageHdr_T_tag {
 	PageID pid;                 /* page id of this page */
 	Four flags;
-	Four reserved;
+	Four reserved;              /* owned by the buffer manager: page checksum */
 	PageID fidOrIid;            /* file id or index id containing this page */
 	Lsn_T lsn;                  /* page lsn */
 	Four logRecLen;             /* log record length */
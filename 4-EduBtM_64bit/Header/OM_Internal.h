@@ -44,7 +44,7 @@ typedef struct {
 typedef struct {
     PageID pid;                 /* page id of this page, should be located on the beginnig */
     Four flags;                 /* flag to store page information */
-    Four reserved;              /* reserved space to store page information */
+    Four reserved;              /* owned by the buffer manager: page checksum */
     Two nSlots;			/* slots in use on the page */
     Two free;			/* offset of contiguous free area on page */
     Two unused;			/* number of unused bytes which are not part of the contiguous freespace */
@@ -284,7 +284,8 @@ Four edubtm_InsertLeaf(
 		leaf.oid = *oid;
 		leaf.nObjects = 1;
 		memcpy(&leaf.klen, kval, sizeof(KeyValue));		
-		edubtm_SplitLeaf(catObjForFile, pid, page, idx, &leaf, item);
+		e = edubtm_SplitLeaf(catObjForFile, pid, page, idx, &leaf, item);
+		if (e < 0) ERR(e);
 	}
 
 
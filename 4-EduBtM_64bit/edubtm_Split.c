@@ -113,14 +113,14 @@ Four edubtm_SplitInternal(
 		// if half of the fpage is not full, save entry in fpage. 
 		if (sum < BI_HALF)
 		{
-			if ((i+1) < high)
+			if (i <= high)
 			{
 				// copy i-th entry for j-th entry of fpage
 				fEntry = tpage.data + tpage.slot[-1*i];
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + fEntry->klen;
+				entryLen = sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(fEntry->klen);
 				memcpy(fpage->data + fEntryOffset, tpage.data + tpage.slot[-1*i], entryLen);
 			}
-			else if ((i+1) == high)
+			else if (i == high+1)
 			{
 				// copy item for j-th entry of fpage
 				entryLen = sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(item->klen);
@@ -130,7 +130,7 @@ Four edubtm_SplitInternal(
 			{
 				// copy (i-1)-th entry for j-th entry of fpage
 				fEntry = tpage.data + tpage.slot[-1*(i-1)];
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + fEntry->klen;
+				entryLen = sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(fEntry->klen);
 				memcpy(fpage->data + fEntryOffset, tpage.data + tpage.slot[-1*(i-1)], entryLen);
 			}
 			fpage->slot[-1*j] = fEntryOffset;
@@ -141,24 +141,24 @@ Four edubtm_SplitInternal(
 		// if half of the fpage is full, save entry in npage.
 		else
 		{
-			if ((i+1) < high)
+			if (i <= high)
 			{
 				// copy i-th entry for k-th entry of npage.
 				nEntry = tpage.data + tpage.slot[-1*i];
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + nEntry->klen;
+				entryLen = sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(nEntry->klen);
 				memcpy(npage->data + nEntryOffset, tpage.data + tpage.slot[-1*i], entryLen);
 			}
-			else if ((i+1) == high)
+			else if (i == high+1)
 			{
 				// copy item for k-th entry of npage.
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + item->klen;
+				entryLen = sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(item->klen);
 				memcpy(npage->data + nEntryOffset, item, entryLen);
 			}
 			else
 			{
 				// copy (i-1)-th entry for k-th entry of npage.
 				nEntry = tpage.data + tpage.slot[-1*(i-1)];
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + nEntry->klen;
+				entryLen = sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(nEntry->klen);
 				memcpy(npage->data + nEntryOffset, tpage.data + tpage.slot[-1*(i-1)], entryLen);
 			}
 			npage->slot[-1*k] = nEntryOffset;
@@ -168,13 +168,21 @@ Four edubtm_SplitInternal(
 		}
 		sum += entryLen + sizeof(Two);
 	}
+	fpage->hdr.nSlots = j;
+	fpage->hdr.unused = 0;
+
+	// the first entry of npage goes up as the separator; its child becomes p0 of npage.
 	nEntry = npage->data + npage->slot[0];
 	npage->hdr.p0 = nEntry->spid;
 
-	fpage->hdr.nSlots = j;
-	npage->hdr.nSlots = k;
-
 	memcpy(ritem, nEntry, sizeof(InternalItem));
+	ritem->spid = newPid.pageNo;
+
+	// remove the first entry from npage.
+	for (i = 1; i < k; i++)
+		npage->slot[-1*(i-1)] = npage->slot[-1*i];
+	npage->hdr.nSlots = k - 1;
+	npage->hdr.unused += sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(nEntry->klen);
 
 	e = BfM_FreeTrain(&newPid, PAGE_BUF);
 	if (e < 0) ERR(e);
@@ -261,14 +269,14 @@ Four edubtm_SplitLeaf(
 		// if half of the fpage is not full, save entry in fpage. 
 		if (sum < BL_HALF)
 		{
-			if ((i+1) < high)
+			if (i <= high)
 			{
 				// copy i-th entry for j-th entry of fpage
 				fEntry = tpage.data + tpage.slot[-1*i];
 				entryLen = 2*sizeof(Two) + ALIGNED_LENGTH(fEntry->klen) + sizeof(ObjectID);
 				memcpy(fpage->data + fEntryOffset, tpage.data + tpage.slot[-1*i], entryLen);
 			}
-			else if ((i+1) == high)
+			else if (i == high+1)
 			{
 				// copy item for j-th entry of fpage
 				fEntry = &item->nObjects;
@@ -292,14 +300,14 @@ Four edubtm_SplitLeaf(
 		// if half of the fpage is full, save entry in npage.
 		else
 		{
-			if ((i+1) < high)
+			if (i <= high)
 			{
 				// copy i-th entry for k-th entry of npage.
 				nEntry = tpage.data + tpage.slot[-1*i];
 				entryLen = 2*sizeof(Two) + ALIGNED_LENGTH(nEntry->klen) + sizeof(ObjectID);
 				memcpy(npage->data + nEntryOffset, tpage.data + tpage.slot[-1*i], entryLen);
 			}
-			else if ((i+1) == high)
+			else if (i == high+1)
 			{
 				// copy item for k-th entry of npage.
 				fEntry = &item->nObjects;
@@ -323,6 +331,7 @@ Four edubtm_SplitLeaf(
 		sum += entryLen + sizeof(Two);
 	}
 	fpage->hdr.nSlots = j;
+	fpage->hdr.unused = 0;
 	npage->hdr.nSlots = k;
 
 	// Insert the allocated page into doubly liked list of leaf pages.